@@ -0,0 +1,82 @@
+#include <FVMCode/async_output.h>
+#include <FVMCode/output.h>
+
+#include "benchmark_helpers.h"
+
+// Compares writing a field of n cells every timestep with Outputter, which
+// makes the time loop wait for formatting and writing, with AsyncOutputter,
+// which does both on a background thread. Each timestep does a fixed amount
+// of computation standing in for assembly and solve.
+//
+// With AsyncOutputter the output is hidden if the time loop takes about as
+// long as the computation alone and the blocked time is small. This needs a
+// core for the background thread: on a single core, formatting competes with
+// the computation and only the waiting for the disk can be hidden.
+//
+// Usage: async_output [n (default 1000000)] [timesteps (default 10)]
+
+using namespace FVMCode;
+
+// Some memory bound work on field, standing in for a timestep
+void compute_timestep (Eigen::VectorXd &field, const unsigned int n_sweeps)
+{
+    const unsigned int n = field.size ();
+    for (unsigned int s = 0; s < n_sweeps; s++)
+        for (unsigned int i = 1; i + 1 < n; i++)
+            field (i) = 0.25 * field (i - 1) + 0.5 * field (i)
+                        + 0.25 * field (i + 1);
+    Benchmark::do_not_optimise (field);
+}
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 1000000;
+    const unsigned int n_timesteps = argc > 2 ? std::stoi (argv[2]) : 10;
+    const unsigned int n_sweeps    = 50;
+
+    std::filesystem::create_directories ("async_output_case");
+    std::filesystem::current_path ("async_output_case");
+
+    Eigen::VectorXd field = Eigen::VectorXd::LinSpaced (n, 0., 1.);
+    const BoundaryConditions boundary_conditions;
+
+    const double compute_time = Benchmark::time_best_of (1, [&] {
+        for (unsigned int t = 0; t < n_timesteps; t++)
+            compute_timestep (field, n_sweeps);
+    });
+    const double synchronous_time = Benchmark::time_best_of (1, [&] {
+        for (unsigned int t = 0; t < n_timesteps; t++)
+        {
+            compute_timestep (field, n_sweeps);
+            Outputter outputter (t, t, 1., 1.);
+            outputter.write_time ();
+            outputter.write_scalar_field (field, "T", boundary_conditions);
+        }
+    });
+    double       blocked_time = 0;
+    const double asynchronous_time = Benchmark::time_best_of (1, [&] {
+        AsyncOutputter outputter;
+        for (unsigned int t = 0; t < n_timesteps; t++)
+        {
+            compute_timestep (field, n_sweeps);
+            outputter.write_scalar_field (t, t, 1., 1., field, "T",
+                                          boundary_conditions);
+        }
+        outputter.flush ();
+        blocked_time = outputter.blocked_time ();
+    });
+
+    std::cout << n << " cells, " << n_timesteps << " timesteps, "
+              << std::thread::hardware_concurrency () << " hardware threads"
+              << std::endl;
+    for (const auto &[name, time] :
+         { std::make_pair ("Computation only", compute_time),
+           std::make_pair ("Outputter", synchronous_time),
+           std::make_pair ("AsyncOutputter", asynchronous_time),
+           std::make_pair ("AsyncOutputter, blocked", blocked_time) })
+        std::cout << std::left << std::setw (40) << name << std::right
+                  << std::setw (12) << std::scientific << std::setprecision (3)
+                  << time / n_timesteps << " s/timestep" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,269 @@
+#ifndef BENCHMARK_HELPERS_H
+#define BENCHMARK_HELPERS_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+
+/**
+ * Runs @param f @param repetitions times and returns the fastest wall time
+ * in seconds. Taking the minimum rather than the mean filters out noise from
+ * the rest of the system.
+ */
+template <typename Function>
+double time_best_of (const unsigned int repetitions, Function &&f)
+{
+    double best = std::numeric_limits<double>::max ();
+    for (unsigned int r = 0; r < repetitions; r++)
+    {
+        const auto start = std::chrono::steady_clock::now ();
+        f ();
+        const auto end = std::chrono::steady_clock::now ();
+        best = std::min (best,
+                         std::chrono::duration<double> (end - start).count ());
+    }
+    return best;
+}
+
+/**
+ * Prints one line of benchmark output in the form
+ * "name: total time, time per item".
+ */
+inline void report (const std::string &name, const double seconds,
+                    const unsigned long n_items, const std::string &item_name)
+{
+    std::cout << std::left << std::setw (40) << name << std::right
+              << std::setw (12) << std::scientific << std::setprecision (3)
+              << seconds << " s" << std::setw (12) << std::fixed
+              << std::setprecision (2) << seconds / n_items * 1e9 << " ns/"
+              << item_name << std::endl;
+}
+
+// Prevents the compiler from optimising away a computed value
+template <typename T> inline void do_not_optimise (const T &value)
+{
+    asm volatile ("" : : "g"(&value) : "memory");
+}
+
+/**
+ * Writes the OpenFOAM polyMesh files (points, faces, owner, neighbour and
+ * boundary) of a unit cube split into nx x ny x nz hexahedral cells into
+ * @param directory, which is created if necessary. Cells, points and faces
+ * are numbered as blockMesh would: cell (i, j, k) has index
+ * i + nx * (j + ny * k), internal faces are sorted by owner and then by
+ * neighbour, and boundary faces are split into one wall patch per side.
+ *
+ * If @param shuffle is true, points and cells are instead given random
+ * labels, as a mesh generator with poor ordering might produce. Internal
+ * faces are still sorted by owner and then neighbour, with the owner the
+ * lower label.
+ *
+ * The box spans @param lengths rather than a unit cube if given.
+ */
+inline void
+write_box_mesh (const std::string &directory, const unsigned int nx,
+                const unsigned int ny, const unsigned int nz,
+                const bool                   shuffle = false,
+                const std::array<double, 3> &lengths = { 1., 1., 1. })
+{
+    namespace fs = std::filesystem;
+    fs::create_directories (directory);
+
+    const unsigned int        n_points = (nx + 1) * (ny + 1) * (nz + 1);
+    std::vector<unsigned int> point_label (n_points);
+    std::vector<unsigned int> cell_label (nx * ny * nz);
+    std::iota (point_label.begin (), point_label.end (), 0);
+    std::iota (cell_label.begin (), cell_label.end (), 0);
+    if (shuffle)
+    {
+        std::mt19937 rng (1234);
+        std::shuffle (point_label.begin (), point_label.end (), rng);
+        std::shuffle (cell_label.begin (), cell_label.end (), rng);
+    }
+
+    auto point_index = [&] (unsigned int i, unsigned int j, unsigned int k) {
+        return point_label[i + (nx + 1) * (j + (ny + 1) * k)];
+    };
+    auto cell_index = [&] (unsigned int i, unsigned int j, unsigned int k) {
+        return cell_label[i + nx * (j + ny * k)];
+    };
+
+    auto header = [] (std::ofstream &out, const std::string &class_name,
+                      const std::string &object) {
+        out << "FoamFile\n{\n    version     2.0;\n    format      ascii;\n"
+            << "    class       " << class_name << ";\n"
+            << "    location    \"constant/polyMesh\";\n"
+            << "    object      " << object << ";\n}\n\n";
+    };
+
+    {
+        std::vector<std::array<double, 3> > coordinates (n_points);
+        for (unsigned int k = 0; k <= nz; k++)
+            for (unsigned int j = 0; j <= ny; j++)
+                for (unsigned int i = 0; i <= nx; i++)
+                    coordinates[point_index (i, j, k)]
+                        = { lengths[0] * i / nx, lengths[1] * j / ny,
+                            lengths[2] * k / nz };
+
+        std::ofstream points (fs::path (directory) / "points");
+        header (points, "vectorField", "points");
+        points << n_points << "\n(\n";
+        for (const auto &x : coordinates)
+            points << "(" << x[0] << " " << x[1] << " " << x[2] << ")\n";
+        points << ")\n";
+    }
+
+    using Face = std::array<unsigned int, 4>;
+    std::vector<Face>         faces;
+    std::vector<unsigned int> owner, neighbour;
+
+    // The face normal to direction d on the low side of cell (i, j, k), with
+    // the vertices ordered such that the normal points in the +d direction
+    auto low_face = [&] (unsigned int d, unsigned int i, unsigned int j,
+                         unsigned int k) -> Face {
+        if (d == 0)
+            return { point_index (i, j, k), point_index (i, j + 1, k),
+                     point_index (i, j + 1, k + 1), point_index (i, j, k + 1) };
+        if (d == 1)
+            return { point_index (i, j, k), point_index (i, j, k + 1),
+                     point_index (i + 1, j, k + 1), point_index (i + 1, j, k) };
+        return { point_index (i, j, k), point_index (i + 1, j, k),
+                 point_index (i + 1, j + 1, k), point_index (i, j + 1, k) };
+    };
+    auto high_face = [&] (unsigned int d, unsigned int i, unsigned int j,
+                          unsigned int k) -> Face {
+        return low_face (d, i + (d == 0), j + (d == 1), k + (d == 2));
+    };
+    auto reversed = [] (const Face &face) -> Face {
+        return { face[0], face[3], face[2], face[1] };
+    };
+
+    // Internal faces, in order of owner and then neighbour
+    for (unsigned int k = 0; k < nz; k++)
+        for (unsigned int j = 0; j < ny; j++)
+            for (unsigned int i = 0; i < nx; i++)
+            {
+                const std::array<bool, 3> has_neighbour
+                    = { i + 1 < nx, j + 1 < ny, k + 1 < nz };
+                const std::array<unsigned int, 3> neighbours
+                    = { cell_index (i + 1, j, k), cell_index (i, j + 1, k),
+                        cell_index (i, j, k + 1) };
+                for (unsigned int d = 0; d < 3; d++)
+                    if (has_neighbour[d])
+                    {
+                        faces.push_back (high_face (d, i, j, k));
+                        owner.push_back (cell_index (i, j, k));
+                        neighbour.push_back (neighbours[d]);
+                    }
+            }
+
+    if (shuffle)
+    {
+        // Restore the owner < neighbour convention and upper triangular
+        // order after relabelling
+        std::vector<unsigned int> order (faces.size ());
+        std::iota (order.begin (), order.end (), 0);
+        for (unsigned int f = 0; f < faces.size (); f++)
+            if (owner[f] > neighbour[f])
+            {
+                std::swap (owner[f], neighbour[f]);
+                faces[f] = reversed (faces[f]);
+            }
+        std::sort (order.begin (), order.end (),
+                   [&] (const unsigned int a, const unsigned int b) {
+                       return std::make_pair (owner[a], neighbour[a])
+                              < std::make_pair (owner[b], neighbour[b]);
+                   });
+        std::vector<Face>         sorted_faces;
+        std::vector<unsigned int> sorted_owner, sorted_neighbour;
+        for (const unsigned int f : order)
+        {
+            sorted_faces.push_back (faces[f]);
+            sorted_owner.push_back (owner[f]);
+            sorted_neighbour.push_back (neighbour[f]);
+        }
+        faces     = std::move (sorted_faces);
+        owner     = std::move (sorted_owner);
+        neighbour = std::move (sorted_neighbour);
+    }
+
+    // Boundary faces, one patch per side of the cube
+    const std::array<std::string, 6> patch_names
+        = { "xMin", "xMax", "yMin", "yMax", "zMin", "zMax" };
+    std::array<unsigned int, 7> patch_starts;
+    const std::array<unsigned int, 3> n = { nx, ny, nz };
+    for (unsigned int patch = 0; patch < 6; patch++)
+    {
+        patch_starts[patch]      = faces.size ();
+        const unsigned int d     = patch / 2;
+        const bool         upper = patch % 2;
+        for (unsigned int k = 0; k < nz; k++)
+            for (unsigned int j = 0; j < ny; j++)
+                for (unsigned int i = 0; i < nx; i++)
+                {
+                    const std::array<unsigned int, 3> ijk = { i, j, k };
+                    if (ijk[d] != (upper ? n[d] - 1 : 0))
+                        continue;
+                    // Flip the low faces so that they point outwards
+                    faces.push_back (upper ? high_face (d, i, j, k)
+                                           : reversed (low_face (d, i, j, k)));
+                    owner.push_back (cell_index (i, j, k));
+                }
+    }
+    patch_starts[6] = faces.size ();
+
+    {
+        std::ofstream out (fs::path (directory) / "faces");
+        header (out, "faceList", "faces");
+        out << faces.size () << "\n(\n";
+        for (const Face &face : faces)
+            out << "4(" << face[0] << " " << face[1] << " " << face[2] << " "
+                << face[3] << ")\n";
+        out << ")\n";
+    }
+    {
+        std::ofstream out (fs::path (directory) / "owner");
+        header (out, "labelList", "owner");
+        out << owner.size () << "\n(\n";
+        for (const unsigned int cell : owner)
+            out << cell << "\n";
+        out << ")\n";
+    }
+    {
+        std::ofstream out (fs::path (directory) / "neighbour");
+        header (out, "labelList", "neighbour");
+        out << neighbour.size () << "\n(\n";
+        for (const unsigned int cell : neighbour)
+            out << cell << "\n";
+        out << ")\n";
+    }
+    {
+        std::ofstream out (fs::path (directory) / "boundary");
+        header (out, "polyBoundaryMesh", "boundary");
+        out << "6\n(\n";
+        for (unsigned int patch = 0; patch < 6; patch++)
+            out << "    " << patch_names[patch] << "\n    {\n"
+                << "        type            wall;\n"
+                << "        nFaces          "
+                << patch_starts[patch + 1] - patch_starts[patch] << ";\n"
+                << "        startFace       " << patch_starts[patch]
+                << ";\n    }\n";
+        out << ")\n";
+    }
+}
+
+} // namespace Benchmark
+
+#endif
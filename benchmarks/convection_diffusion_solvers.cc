@@ -0,0 +1,126 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/operators.h>
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_bicgstab.h>
+#include <FVMCode/solvers/solver_gmres.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <Eigen/Dense>
+#include <Eigen/SparseLU>
+
+#include "benchmark_helpers.h"
+
+// Wall time of solving the first timestep of the convection_diffusion case
+// on its mesh, 100 x 21 x 1 cells over 3 x 0.5 x 0.1, refined by a factor r
+// in x and y: with colPivHouseholderQr on the dense matrix, as the dense
+// script does, with a sparse LU factorisation, and with BiCGStab and
+// GMRES(30) with the Jacobi and DILU preconditioners down to a relative
+// residual of 1e-8. The time of the iterative solvers includes setting up
+// the preconditioner. The dense solve is skipped above max_dense cells.
+//
+// Usage: convection_diffusion_solvers [max_dense (default 2100)]
+
+using namespace FVMCode;
+
+int main (int argc, char **argv)
+{
+    const unsigned int max_dense = argc > 1 ? std::stoi (argv[1]) : 2100;
+
+    std::cout << std::setw (8) << "cells" << std::setw (11) << "QR s"
+              << std::setw (11) << "LU s";
+    for (const std::string solver : { "BiCGStab", "GMRES" })
+        for (const std::string preconditioner : { "Jacobi", "DILU" })
+            std::cout << std::setw (17) << solver + "+" + preconditioner
+                      << std::setw (5) << "its";
+    std::cout << std::endl;
+
+    for (const unsigned int r : { 1, 2, 4, 8, 16 })
+    {
+        // The patches of the box are named xMin, xMax, ... zMax. The z
+        // patches stand in for the empty frontAndBack patch: they have a
+        // zero gradient, and no flux passes through them.
+        const std::string directory
+            = "convection_diffusion_solvers_case/polyMesh";
+        Benchmark::write_box_mesh (directory, 100 * r, 21 * r, 1, false,
+                                   { 3., 0.5, 0.1 });
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        const unsigned int n_cells = mesh.n_cells ();
+
+        BoundaryConditions bcs;
+        for (const BoundaryPatch &patch : mesh.get_patches ())
+            bcs.emplace_back (patch, BoundaryFieldEntry (patch.name == "xMin"
+                                                             ? "fixedValue"
+                                                             : "zeroGradient",
+                                                         0.));
+        const SparsityPattern sp (mesh);
+        SparseMatrix          matrix (sp);
+        VectorXd              rhs = VectorXd::Zero (n_cells);
+        Operators::ddt (matrix, rhs, mesh, VectorXd::Zero (n_cells), 0.05);
+        Operators::source (
+            rhs, mesh,
+            mesh.get_cell_containing_point (Point<3> (0.5, 0., 0.)), 1.);
+        Operators::laplacian (matrix, rhs, mesh, bcs, 0.01);
+        Operators::div (matrix, rhs, mesh, bcs, Point<3> (1., 0., 0.),
+                        Operators::ConvectionScheme::upwind);
+
+        std::cout << std::setw (8) << n_cells << std::scientific
+                  << std::setprecision (2);
+
+        Eigen::SparseMatrix<double> eigen_matrix;
+        matrix.copy_to (eigen_matrix);
+        if (n_cells <= max_dense)
+        {
+            VectorXd     dense_solution;
+            const double dense_time = Benchmark::time_best_of (1, [&] {
+                const Eigen::MatrixXd dense_matrix (eigen_matrix);
+                dense_solution
+                    = dense_matrix.colPivHouseholderQr ().solve (rhs);
+            });
+            std::cout << std::setw (11) << dense_time;
+        }
+        else
+            std::cout << std::setw (11) << "-";
+        VectorXd     exact;
+        const double lu_time = Benchmark::time_best_of (1, [&] {
+            Eigen::SparseLU<Eigen::SparseMatrix<double> > lu (eigen_matrix);
+            exact = lu.solve (rhs);
+        });
+        std::cout << std::setw (11) << lu_time;
+
+        SolverControl control;
+        control.tolerance          = 0.;
+        control.relative_tolerance = 1e-8;
+        control.max_iterations     = 10000;
+        auto time_solver = [&] (const auto &solver,
+                                auto      &&make_preconditioner) {
+            VectorXd     x;
+            SolverResult result;
+            const double seconds = Benchmark::time_best_of (3, [&] {
+                x = VectorXd::Zero (n_cells);
+                const auto preconditioner = make_preconditioner ();
+                result = solver.solve (matrix, x, rhs, preconditioner);
+            });
+            AssertThrow (result.converged
+                             && (x - exact).lpNorm<Eigen::Infinity> ()
+                                    < 1e-6 * exact.lpNorm<Eigen::Infinity> (),
+                         std::runtime_error ("Solver failed"));
+            std::cout << std::setw (17) << seconds << std::setw (5)
+                      << result.iterations;
+        };
+        auto jacobi = [&] { return PreconditionerJacobi (matrix); };
+        auto dilu   = [&] { return PreconditionerDILU (matrix); };
+        time_solver (SolverBiCGStab (control), jacobi);
+        time_solver (SolverBiCGStab (control), dilu);
+        time_solver (SolverGMRES (control), jacobi);
+        time_solver (SolverGMRES (control), dilu);
+        std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+#include <FVMCode/face_colouring.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/parallel.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include "benchmark_helpers.h"
+
+// Compares serial face loops against face loops run colour by colour on a
+// thread pool, for the SparseMatrix matrix vector product and for the
+// assembly of a diffusion operator, on an n x n x n box mesh.
+//
+// Usage: face_colouring [n (default 60)]
+
+using namespace FVMCode;
+
+// Diffusion operator in arrow format, assembled as in
+// construct_diffusion_term of the convection_diffusion script
+struct ArrowMatrix
+{
+    std::vector<double> diagonal;
+    std::vector<double> upper;
+    std::vector<double> lower;
+};
+
+inline void add_diffusion_face (UnstructuredMesh &mesh, ArrowMatrix &matrix,
+                                const unsigned int f)
+{
+    const auto        &face      = mesh.get_face (f);
+    const unsigned int owner     = face->neighbour_indices ()[0];
+    const unsigned int neighbour = face->neighbour_indices ()[1];
+    const double       a_N       = face->area () * face->delta ();
+    matrix.diagonal[owner] += a_N;
+    matrix.diagonal[neighbour] += a_N;
+    matrix.upper[f] = -a_N;
+    matrix.lower[f] = -a_N;
+}
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 60;
+
+    const std::string directory = "box_mesh/constant/polyMesh";
+    Benchmark::write_box_mesh (directory, n, n, n);
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (mesh, directory + "/points",
+                                   directory + "/faces", directory + "/owner",
+                                   directory + "/neighbour",
+                                   directory + "/boundary");
+    const unsigned int n_internal_faces = mesh.get_patches ()[0].start_face;
+    std::cout << "Box mesh: " << mesh.n_cells () << " cells, "
+              << n_internal_faces << " internal faces, "
+              << Parallel::default_n_threads () << " hardware threads"
+              << std::endl;
+
+    std::unique_ptr<FaceColouring> colouring;
+    Benchmark::report ("Colouring", Benchmark::time_best_of (3, [&] {
+                           colouring = std::make_unique<FaceColouring> (mesh);
+                       }),
+                       n_internal_faces, "face");
+    std::cout << colouring->n_colours () << " colours" << std::endl;
+
+    SparsityPattern sp (mesh);
+    SparseMatrix    matrix (sp);
+    for (unsigned int f = 0; f < n_internal_faces; f++)
+    {
+        const auto &cells           = mesh.get_face (f)->neighbour_indices ();
+        matrix (cells[0], cells[1]) = -1.;
+        matrix (cells[1], cells[0]) = -1.;
+    }
+    for (unsigned int i = 0; i < mesh.n_cells (); i++) matrix (i, i) = 6.;
+
+    const VectorXd src = VectorXd::Ones (mesh.n_cells ());
+    VectorXd       dst (mesh.n_cells ());
+
+    const unsigned int n_reps = 20;
+    Benchmark::report ("vmult, serial", Benchmark::time_best_of (n_reps, [&] {
+                           matrix.vmult (src, dst);
+                           Benchmark::do_not_optimise (dst);
+                       }),
+                       n_internal_faces, "face");
+
+    ArrowMatrix assembled { std::vector<double> (mesh.n_cells ()),
+                            std::vector<double> (n_internal_faces),
+                            std::vector<double> (n_internal_faces) };
+    Benchmark::report (
+        "diffusion assembly, serial", Benchmark::time_best_of (n_reps, [&] {
+            std::fill (assembled.diagonal.begin (), assembled.diagonal.end (),
+                       0.);
+            for (unsigned int f = 0; f < n_internal_faces; f++)
+                add_diffusion_face (mesh, assembled, f);
+            Benchmark::do_not_optimise (assembled);
+        }),
+        n_internal_faces, "face");
+
+    for (const unsigned int n_threads : { 1, 2, 4, 8 })
+    {
+        Parallel::ThreadPool pool (n_threads);
+        const std::string    threads = std::to_string (n_threads) + " threads";
+        Benchmark::report ("vmult, coloured, " + threads,
+                           Benchmark::time_best_of (n_reps, [&] {
+                               matrix.vmult (src, dst, *colouring, pool);
+                               Benchmark::do_not_optimise (dst);
+                           }),
+                           n_internal_faces, "face");
+        Benchmark::report (
+            "diffusion assembly, coloured, " + threads,
+            Benchmark::time_best_of (n_reps, [&] {
+                pool.parallel_for (
+                    0, mesh.n_cells (),
+                    [&] (const unsigned int begin, const unsigned int end) {
+                        std::fill (assembled.diagonal.begin () + begin,
+                                   assembled.diagonal.begin () + end, 0.);
+                    });
+                colouring->for_each_face (pool, [&] (const unsigned int f) {
+                    add_diffusion_face (mesh, assembled, f);
+                });
+                Benchmark::do_not_optimise (assembled);
+            }),
+            n_internal_faces, "face");
+    }
+
+    return EXIT_SUCCESS;
+}
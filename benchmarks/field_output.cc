@@ -0,0 +1,62 @@
+#include <FVMCode/output.h>
+
+#include "benchmark_helpers.h"
+
+// Reports the throughput in MB/s of writing a volScalarField of n cells with
+// Outputter in each format, and with the Eigen operator<< formatting that
+// Outputter used before. The files end up in the page cache, so this
+// measures formatting and copying rather than the disk.
+//
+// Usage: field_output [n (default 1000000)]
+
+using namespace FVMCode;
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 1000000;
+
+    std::filesystem::create_directories ("field_output_case");
+    std::filesystem::current_path ("field_output_case");
+
+    std::mt19937                           generator (0);
+    std::uniform_real_distribution<double> distribution (0., 1.);
+    Eigen::VectorXd                        field (n);
+    for (unsigned int c = 0; c < n; c++) field (c) = distribution (generator);
+    const BoundaryConditions boundary_conditions;
+
+    auto report_throughput = [] (const std::string &name, const double time,
+                                 const std::string &file) {
+        const double bytes = std::filesystem::file_size (file);
+        std::cout << std::left << std::setw (30) << name << std::right
+                  << std::setw (12) << std::scientific << std::setprecision (3)
+                  << time << " s" << std::setw (10) << std::fixed
+                  << std::setprecision (1) << bytes / 1e6 << " MB"
+                  << std::setw (10) << bytes / time / 1e6 << " MB/s"
+                  << std::endl;
+    };
+
+    std::cout << n << " cells" << std::endl;
+    {
+        const double time = Benchmark::time_best_of (3, [&] {
+            std::ofstream outfile ("T_eigen");
+            outfile << "internalField\tnonuniform List<scalar>" << std::endl;
+            outfile << field.size () << std::endl;
+            outfile << "(" << std::endl;
+            outfile << field << std::endl;
+            outfile << ");" << std::endl;
+        });
+        report_throughput ("Eigen operator<<", time, "T_eigen");
+    }
+    for (const auto &[name, format] :
+         { std::make_pair ("Outputter, ascii", Outputter::Format::ascii),
+           std::make_pair ("Outputter, binary", Outputter::Format::binary) })
+    {
+        Outputter    outputter (0, 0., 1., 1., 2, format);
+        const double time = Benchmark::time_best_of (3, [&] {
+            outputter.write_scalar_field (field, "T", boundary_conditions);
+        });
+        report_throughput (name, time, "0.00/T");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/operators.h>
+#include <FVMCode/solvers/gamg.h>
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_cg.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include "benchmark_helpers.h"
+
+// Iterations and wall time of solving a pressure-like Poisson problem, a
+// Laplacian with a fixed value on one side and a random source, on n x n x n
+// box meshes of increasing size down to a relative residual of 1e-8: with
+// CG and the DIC preconditioner, with GAMG on its own, and with CG
+// preconditioned by a GAMG V-cycle. Also times building the GAMG hierarchy,
+// and updating it for new coefficients as in a later timestep.
+//
+// Usage: gamg [gauss_seidel|dic (default gauss_seidel)] [sweeps (default 1)]
+
+using namespace FVMCode;
+
+int main (int argc, char **argv)
+{
+    GAMGOptions options;
+    if (argc > 1 && std::string (argv[1]) == "dic")
+        options.smoother = GAMGOptions::Smoother::dic;
+    if (argc > 2)
+        options.n_pre_sweeps = options.n_post_sweeps = std::stoi (argv[2]);
+
+    std::cout << std::setw (8) << "cells" << std::setw (7) << "levels"
+              << std::setw (11) << "setup s" << std::setw (11) << "update s"
+              << std::setw (11) << "CG+DIC s" << std::setw (5) << "its"
+              << std::setw (11) << "GAMG s" << std::setw (5) << "its"
+              << std::setw (11) << "CG+GAMG s" << std::setw (5) << "its"
+              << std::endl;
+    for (const unsigned int n : { 16, 24, 32, 48, 64, 80 })
+    {
+        const std::string directory = "gamg_case/polyMesh";
+        Benchmark::write_box_mesh (directory, n, n, n);
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        const unsigned int n_cells = mesh.n_cells ();
+
+        BoundaryConditions bcs;
+        for (const BoundaryPatch &patch : mesh.get_patches ())
+            bcs.emplace_back (patch, BoundaryFieldEntry (bcs.empty ()
+                                                             ? "fixedValue"
+                                                             : "zeroGradient",
+                                                         0.));
+        const SparsityPattern sp (mesh);
+        SparseMatrix          matrix (sp);
+        VectorXd              rhs = VectorXd::Zero (n_cells);
+        Operators::laplacian (matrix, rhs, mesh, bcs, 1.);
+        const VectorXd source = VectorXd::Random (n_cells);
+        for (unsigned int c = 0; c < n_cells; c++)
+            rhs (c) += source (c) * mesh.get_cell (c)->volume ();
+
+        std::unique_ptr<GAMG> gamg;
+        const double setup_time = Benchmark::time_best_of (3, [&] {
+            gamg = std::make_unique<GAMG> (matrix, options);
+        });
+        const double update_time
+            = Benchmark::time_best_of (3, [&] { gamg->update (matrix); });
+
+        SolverControl control;
+        control.tolerance          = 0.;
+        control.relative_tolerance = 1e-8;
+        control.max_iterations     = 10000;
+        auto time_solve = [&] (auto &&solve) {
+            VectorXd     x;
+            SolverResult result;
+            const double seconds = Benchmark::time_best_of (3, [&] {
+                x      = VectorXd::Zero (n_cells);
+                result = solve (x);
+            });
+            AssertThrow (result.converged,
+                         std::runtime_error ("Solver did not converge"));
+            std::cout << std::setw (11) << seconds << std::setw (5)
+                      << result.iterations;
+        };
+
+        std::cout << std::setw (8) << n_cells << std::setw (7)
+                  << gamg->n_levels () << std::scientific
+                  << std::setprecision (2) << std::setw (11) << setup_time
+                  << std::setw (11) << update_time;
+        time_solve ([&] (VectorXd &x) {
+            return SolverCG (control).solve (matrix, x, rhs,
+                                             PreconditionerDIC (matrix));
+        });
+        time_solve ([&] (VectorXd &x) {
+            return SolverGAMG (control).solve (matrix, x, rhs, *gamg);
+        });
+        time_solve ([&] (VectorXd &x) {
+            return SolverCG (control).solve (matrix, x, rhs, *gamg);
+        });
+        std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
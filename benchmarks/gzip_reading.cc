@@ -0,0 +1,90 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/input_file.h>
+#include <FVMCode/mapped_file.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <zlib.h>
+
+#include "benchmark_helpers.h"
+
+// Compares loading an n x n x n box mesh from plain polyMesh files with
+// loading it from gzip compressed ones, as written by OpenFOAM with
+// "writeCompression on".
+//
+// The files are in the page cache when they are timed, so the measured times
+// are CPU time only. The effect of a slow disk is modelled by adding the
+// time to read the files at a given bandwidth, on the assumption that the
+// read is not overlapped with parsing.
+//
+// Usage: gzip_reading [n (default 60)]
+
+using namespace FVMCode;
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 60;
+
+    const std::string plain = "box_mesh/constant/polyMesh";
+    const std::string gzip  = "box_mesh_gzip/constant/polyMesh";
+    Benchmark::write_box_mesh (plain, n, n, n);
+    std::filesystem::create_directories (gzip);
+
+    const std::vector<std::string> files
+        = { "points", "faces", "owner", "neighbour", "boundary" };
+    std::uintmax_t plain_bytes = 0, gzip_bytes = 0;
+    for (const std::string &file : files)
+    {
+        plain_bytes += std::filesystem::file_size (plain + "/" + file);
+        const Input::MappedFile contents (plain + "/" + file);
+        gzFile out = gzopen ((gzip + "/" + file + ".gz").c_str (), "wb");
+        gzwrite (out, contents.data (), contents.size ());
+        gzclose (out);
+        gzip_bytes += std::filesystem::file_size (gzip + "/" + file + ".gz");
+    }
+    std::cout << "Box mesh: " << n * n * n << " cells, " << std::fixed
+              << std::setprecision (1) << plain_bytes / 1e6 << " MB plain, "
+              << gzip_bytes / 1e6 << " MB compressed" << std::endl;
+
+    auto load = [] (const std::string &directory, const bool concurrent) {
+        ParserOptions options;
+        options.concurrent = concurrent;
+        return Benchmark::time_best_of (3, [&] {
+            UnstructuredMesh       mesh;
+            UnstructuredMeshParser parser (
+                mesh, directory + "/points", directory + "/faces",
+                directory + "/owner", directory + "/neighbour",
+                directory + "/boundary", options);
+        });
+    };
+    const double plain_time = load (plain, false);
+    const double gzip_time  = load (gzip, false);
+    const double decompression_time = Benchmark::time_best_of (3, [&] {
+        for (const std::string &file : files)
+        {
+            const Input::InputFile contents (gzip + "/" + file, false);
+            Benchmark::do_not_optimise (contents.view ());
+        }
+    });
+
+    Benchmark::report ("Load, plain", plain_time, n * n * n, "cell");
+    Benchmark::report ("Load, gzip", gzip_time, n * n * n, "cell");
+    Benchmark::report ("Load, gzip, concurrent", load (gzip, true), n * n * n,
+                       "cell");
+    Benchmark::report ("Decompression alone", decompression_time, n * n * n,
+                       "cell");
+
+    std::cout << "\nModelled load time on a disk of the given bandwidth:"
+              << std::endl;
+    for (const double bandwidth : { 50e6, 200e6, 1000e6, 3000e6 })
+        std::cout << std::setw (6) << std::setprecision (0)
+                  << bandwidth / 1e6 << " MB/s: plain " << std::setprecision (3)
+                  << plain_time + plain_bytes / bandwidth << " s, gzip "
+                  << gzip_time + gzip_bytes / bandwidth << " s" << std::endl;
+    std::cout << "gzip is faster below "
+              << std::setprecision (0)
+              << (plain_bytes - gzip_bytes)
+                     / std::max (gzip_time - plain_time, 1e-9) / 1e6
+              << " MB/s" << std::endl;
+
+    return EXIT_SUCCESS;
+}
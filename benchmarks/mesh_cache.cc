@@ -0,0 +1,58 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include "benchmark_helpers.h"
+
+// Compares reading an n x n x n box mesh in OpenFOAM format with reading it
+// from a binary mesh cache, which skips parsing, building the cells from the
+// owner and neighbour lists and computing the geometry.
+//
+// Usage: mesh_cache [n (default 60)]
+
+using namespace FVMCode;
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 60;
+
+    const std::string directory = "box_mesh/constant/polyMesh";
+    Benchmark::write_box_mesh (directory, n, n, n);
+    const std::string cache_file = "box_mesh/mesh.cache";
+    std::filesystem::remove (cache_file);
+
+    auto read_mesh = [&] (const std::string &cache_file) {
+        ParserOptions options;
+        options.cache_file = cache_file;
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary", options);
+        return parser.loaded_from_cache ();
+    };
+
+    const double parse_time
+        = Benchmark::time_best_of (3, [&] { read_mesh (""); });
+    const double write_time = Benchmark::time_best_of (1, [&] {
+        AssertThrow (!read_mesh (cache_file),
+                     std::runtime_error ("Unexpected mesh cache"));
+    });
+    const double cache_time = Benchmark::time_best_of (3, [&] {
+        AssertThrow (read_mesh (cache_file),
+                     std::runtime_error ("Mesh cache not used"));
+    });
+
+    std::cout << "Box mesh: " << n * n * n << " cells, cache "
+              << std::fixed << std::setprecision (1)
+              << std::filesystem::file_size (cache_file) / 1e6 << " MB"
+              << std::endl;
+    std::cout << std::scientific << std::setprecision (3)
+              << "Parse polyMesh files:          " << parse_time << " s\n"
+              << "Parse and write cache:         " << write_time << " s\n"
+              << "Read cache:                    " << cache_time << " s\n"
+              << std::fixed << std::setprecision (1)
+              << "Speedup:                       " << parse_time / cache_time
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,103 @@
+#include <FVMCode/compact_mesh.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <vector>
+
+#include "benchmark_helpers.h"
+
+// Compares the memory footprint and face loop throughput of the object based
+// UnstructuredMesh (std::vector<Face<3> >, std::vector<Cell<3> >) with the
+// flat CompactMesh layout on the convection_diffusion mesh.
+
+using namespace FVMCode;
+
+// Bytes held by the UnstructuredMesh containers and the heap blocks owned by
+// each Face and Cell (excluding allocator bookkeeping)
+std::size_t object_layout_bytes (UnstructuredMesh &mesh)
+{
+    std::size_t bytes = sizeof (UnstructuredMesh);
+    bytes += mesh.n_points () * sizeof (Point<3>);
+    for (const Face<3> &face : mesh.faces ())
+        bytes += sizeof (Face<3>)
+                 + face.vertices ().capacity ()
+                       * sizeof (UnstructuredMesh::PointIterator)
+                 + face.neighbour_indices ().capacity ()
+                       * sizeof (unsigned int);
+    for (const Cell<3> &cell : mesh.cells ())
+        bytes += sizeof (Cell<3>)
+                 + cell.faces ().capacity ()
+                       * sizeof (UnstructuredMesh::FaceIterator)
+                 + cell.neighbour_indices ().capacity ()
+                       * sizeof (unsigned int);
+    return bytes;
+}
+
+int main ()
+{
+    UnstructuredMesh mesh;
+    CompactMesh      compact_mesh;
+    {
+        UnstructuredMeshParser parser (mesh);
+        parser.build_compact_mesh (compact_mesh);
+    }
+    const unsigned int repetitions = 200;
+    const unsigned int n_internal  = compact_mesh.n_internal_faces ();
+
+    std::cout << "Mesh: " << mesh.n_cells () << " cells, " << mesh.n_faces ()
+              << " faces" << std::endl;
+    std::cout << "Bytes per cell, std::vector<Face<3> > layout: "
+              << (double)object_layout_bytes (mesh) / mesh.n_cells ()
+              << std::endl;
+    std::cout << "Bytes per cell, CompactMesh layout:          "
+              << (double)compact_mesh.memory_consumption () / mesh.n_cells ()
+              << std::endl;
+
+    // Face loop: diffusion and upwind convection coefficients of every
+    // internal face, accumulated into the diagonal
+    const Point<3>      velocity (1., 0.3, 0.);
+    std::vector<double> diagonal (mesh.n_cells ());
+    std::vector<double> off_diagonal (n_internal);
+
+    const double object_time = Benchmark::time_best_of (repetitions, [&] () {
+        std::fill (diagonal.begin (), diagonal.end (), 0.);
+        for (unsigned int f = 0; f < n_internal; f++)
+        {
+            const auto  &face      = mesh.get_face (f);
+            const double a_N       = face->area () * face->delta ();
+            const double face_flux = velocity.dot (face->area_vector ());
+            diagonal[face->neighbour_indices ()[0]]
+                += a_N + std::max (face_flux, 0.);
+            diagonal[face->neighbour_indices ()[1]]
+                += a_N + std::max (-face_flux, 0.);
+            off_diagonal[f] = -a_N + std::min (face_flux, 0.);
+        }
+        Benchmark::do_not_optimise (diagonal);
+    });
+    Benchmark::report ("Face loop, std::vector<Face<3> >", object_time,
+                       n_internal, "face");
+
+    const double compact_time = Benchmark::time_best_of (repetitions, [&] () {
+        std::fill (diagonal.begin (), diagonal.end (), 0.);
+        const auto &owner     = compact_mesh.owner ();
+        const auto &neighbour = compact_mesh.neighbour ();
+        const auto &area      = compact_mesh.face_areas ();
+        const auto &delta     = compact_mesh.face_deltas ();
+        const auto &area_vec  = compact_mesh.face_area_vectors ();
+        for (unsigned int f = 0; f < n_internal; f++)
+        {
+            const double a_N       = area[f] * delta[f];
+            const double face_flux = velocity (0) * area_vec[0][f]
+                                     + velocity (1) * area_vec[1][f]
+                                     + velocity (2) * area_vec[2][f];
+            diagonal[owner[f]] += a_N + std::max (face_flux, 0.);
+            diagonal[neighbour[f]] += a_N + std::max (-face_flux, 0.);
+            off_diagonal[f] = -a_N + std::min (face_flux, 0.);
+        }
+        Benchmark::do_not_optimise (diagonal);
+    });
+    Benchmark::report ("Face loop, CompactMesh", compact_time, n_internal,
+                       "face");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/mapped_file.h>
+#include <FVMCode/polymesh_reader.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include "benchmark_helpers.h"
+
+// Reports the throughput in MB/s of reading an n x n x n box mesh in
+// OpenFOAM format with each UnstructuredMeshParser backend, and of the
+// memory mapped readers of the individual polyMesh files on their own, i.e.
+// without building the mesh. The concurrent parser should take about as
+// long as linking plus reading faces, the largest file.
+//
+// Usage: mesh_parsing [n (default 60)]
+
+using namespace FVMCode;
+
+// Writes data as binary polyMesh files with 32 bit labels, as OpenFOAM's
+// foamFormatConvert would
+void write_binary_mesh (const Input::PolyMeshData &data,
+                        const std::string         &directory)
+{
+    auto header = [] (std::ofstream &out, const std::string &class_name,
+                      const std::string &object) {
+        out << "FoamFile\n{\n    version     2.0;\n    format      binary;\n"
+            << "    arch        \"LSB;label=32;scalar=64\";\n"
+            << "    class       " << class_name << ";\n"
+            << "    location    \"constant/polyMesh\";\n"
+            << "    object      " << object << ";\n}\n\n";
+    };
+    auto write_labels = [] (std::ofstream                   &out,
+                            const std::vector<unsigned int> &labels) {
+        out << labels.size () << "\n(";
+        out.write (reinterpret_cast<const char *> (labels.data ()),
+                   labels.size () * sizeof (unsigned int));
+        out << ")\n";
+    };
+
+    std::ofstream points (directory + "/points", std::ios::binary);
+    header (points, "vectorField", "points");
+    points << data.points.size () << "\n(";
+    for (const Point<3> &point : data.points)
+        for (unsigned int d = 0; d < 3; d++)
+        {
+            const double coordinate = point (d);
+            points.write (reinterpret_cast<const char *> (&coordinate),
+                          sizeof coordinate);
+        }
+    points << ")\n";
+
+    std::ofstream faces (directory + "/faces", std::ios::binary);
+    header (faces, "faceCompactList", "faces");
+    write_labels (faces, data.face_offsets);
+    write_labels (faces, data.face_vertices);
+
+    std::ofstream owner (directory + "/owner", std::ios::binary);
+    header (owner, "labelList", "owner");
+    write_labels (owner, data.owner);
+
+    std::ofstream neighbour (directory + "/neighbour", std::ios::binary);
+    header (neighbour, "labelList", "neighbour");
+    write_labels (neighbour, data.neighbour);
+}
+
+void report_throughput (const std::string &name, const double seconds,
+                        const std::uintmax_t n_bytes)
+{
+    std::cout << std::left << std::setw (40) << name << std::right
+              << std::setw (12) << std::scientific << std::setprecision (3)
+              << seconds << " s" << std::setw (12) << std::fixed
+              << std::setprecision (1) << n_bytes / seconds / 1e6 << " MB/s"
+              << std::endl;
+}
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 60;
+
+    const std::string directory = "box_mesh/constant/polyMesh";
+    Benchmark::write_box_mesh (directory, n, n, n);
+
+    const std::vector<std::string> files
+        = { "points", "faces", "owner", "neighbour", "boundary" };
+    std::uintmax_t total_bytes = 0;
+    for (const std::string &file : files)
+        total_bytes += std::filesystem::file_size (directory + "/" + file);
+    std::cout << "Box mesh: " << n * n * n << " cells, " << std::fixed
+              << std::setprecision (1) << total_bytes / 1e6 << " MB"
+              << std::endl;
+
+    ParserOptions stream, memory_mapped, concurrent, chunked;
+    stream.backend        = ParserOptions::Backend::stream;
+    memory_mapped.backend = ParserOptions::Backend::memory_mapped;
+    concurrent.backend    = ParserOptions::Backend::memory_mapped;
+    concurrent.concurrent = true;
+    chunked.backend       = ParserOptions::Backend::memory_mapped;
+    chunked.chunked       = true;
+    for (const auto &[name, options] :
+         { std::make_pair ("stream", stream),
+           std::make_pair ("memory mapped", memory_mapped),
+           std::make_pair ("memory mapped, concurrent", concurrent),
+           std::make_pair ("memory mapped, chunked", chunked) })
+    {
+        const double time = Benchmark::time_best_of (3, [&] {
+            UnstructuredMesh       mesh;
+            UnstructuredMeshParser parser (
+                mesh, directory + "/points", directory + "/faces",
+                directory + "/owner", directory + "/neighbour",
+                directory + "/boundary", options);
+        });
+        report_throughput (std::string ("Full mesh, ") + name, time,
+                           total_bytes);
+    }
+
+    // Reading alone
+    Input::PolyMeshData data;
+    for (const std::string &file : files)
+    {
+        const std::string path  = directory + "/" + file;
+        const double      bytes = std::filesystem::file_size (path);
+        const double      time  = Benchmark::time_best_of (5, [&] {
+            const Input::MappedFile mapped (path);
+            if (file == "points")
+                Input::read_points (mapped.view (), path, data.points);
+            else if (file == "faces")
+                Input::read_faces (mapped.view (), path, data.face_offsets,
+                                   data.face_vertices);
+            else if (file == "owner")
+                Input::read_labels (mapped.view (), path, data.owner);
+            else if (file == "neighbour")
+                Input::read_labels (mapped.view (), path, data.neighbour);
+            else
+                Input::read_boundaries (mapped.view (), path,
+                                        data.boundaries);
+        });
+        report_throughput ("Read " + file + ", memory mapped", time, bytes);
+    }
+
+    // The same mesh in binary format
+    const std::string binary_directory = "box_mesh_binary/constant/polyMesh";
+    std::filesystem::create_directories (binary_directory);
+    write_binary_mesh (data, binary_directory);
+    std::filesystem::copy_file (
+        directory + "/boundary", binary_directory + "/boundary",
+        std::filesystem::copy_options::overwrite_existing);
+    std::uintmax_t binary_bytes = 0;
+    for (const std::string &file : files)
+        binary_bytes
+            += std::filesystem::file_size (binary_directory + "/" + file);
+    {
+        const double time = Benchmark::time_best_of (3, [&] {
+            UnstructuredMesh       mesh;
+            UnstructuredMeshParser parser (
+                mesh, binary_directory + "/points",
+                binary_directory + "/faces", binary_directory + "/owner",
+                binary_directory + "/neighbour",
+                binary_directory + "/boundary");
+        });
+        report_throughput ("Full mesh, binary", time, binary_bytes);
+    }
+    for (const std::string file : { "points", "faces", "owner" })
+    {
+        const std::string path  = binary_directory + "/" + file;
+        const double      bytes = std::filesystem::file_size (path);
+        const double      time  = Benchmark::time_best_of (5, [&] {
+            const Input::MappedFile mapped (path);
+            if (file == "points")
+                Input::read_points (mapped.view (), path, data.points);
+            else if (file == "faces")
+                Input::read_faces (mapped.view (), path, data.face_offsets,
+                                   data.face_vertices);
+            else
+                Input::read_labels (mapped.view (), path, data.owner);
+        });
+        report_throughput ("Read " + file + ", binary", time, bytes);
+    }
+
+    // Reading in chunks, which should scale with the number of threads
+    for (const std::string file : { "points", "faces", "owner" })
+    {
+        const std::string path  = directory + "/" + file;
+        const double      bytes = std::filesystem::file_size (path);
+        for (const unsigned int n_threads : { 1, 2, 4, 8 })
+        {
+            Parallel::ThreadPool pool (n_threads);
+            const double         time = Benchmark::time_best_of (5, [&] {
+                const Input::MappedFile mapped (path);
+                // Chunks of at least 64 kB, so the files of small meshes are
+                // split too
+                if (file == "points")
+                    Input::read_points (mapped.view (), path, data.points,
+                                        pool, 1 << 16);
+                else if (file == "faces")
+                    Input::read_faces (mapped.view (), path, data.face_offsets,
+                                       data.face_vertices, pool, 1 << 16);
+                else
+                    Input::read_labels (mapped.view (), path, data.owner, pool,
+                                        1 << 16);
+            });
+            report_throughput ("Read " + file + ", chunked, "
+                                   + std::to_string (n_threads) + " threads",
+                               time, bytes);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,58 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/partitioning.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <memory>
+
+#include "benchmark_helpers.h"
+
+// Reports partitioning time, edge cut and load imbalance of
+// MeshPartitioning for a range of partition counts on the
+// convection_diffusion mesh and on an n x n x n box mesh.
+//
+// Usage: partitioning [n (default 50)]
+
+using namespace FVMCode;
+
+void run (const std::string &name, UnstructuredMesh &mesh)
+{
+    std::cout << name << ": " << mesh.n_cells () << " cells, "
+              << mesh.get_patches ()[0].start_face << " internal faces"
+              << std::endl;
+    for (const unsigned int n_partitions : { 2, 3, 4, 8, 16, 64 })
+    {
+        std::unique_ptr<MeshPartitioning> mp;
+        const double time = Benchmark::time_best_of (3, [&] {
+            mp = std::make_unique<MeshPartitioning> (mesh, n_partitions);
+        });
+        std::cout << "  " << std::setw (3) << n_partitions
+                  << " partitions: edge cut " << std::setw (7)
+                  << mp->edge_cut () << ", load imbalance " << std::fixed
+                  << std::setprecision (3) << mp->load_imbalance () << ", "
+                  << std::scientific << time << " s" << std::endl;
+    }
+}
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 50;
+
+    {
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (mesh);
+        run ("convection_diffusion mesh", mesh);
+    }
+
+    {
+        const std::string directory = "box_mesh/constant/polyMesh";
+        Benchmark::write_box_mesh (directory, n, n, n);
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        run ("box mesh", mesh);
+    }
+
+    return EXIT_SUCCESS;
+}
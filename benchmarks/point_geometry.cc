@@ -0,0 +1,81 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/mesh_components.h>
+#include <FVMCode/point.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <vector>
+
+#include "benchmark_helpers.h"
+
+// Times the Face and Cell geometry constructors and the face loop of the
+// upwind convection assembly on the convection_diffusion mesh. All three are
+// dominated by the creation of temporary Points.
+
+int main ()
+{
+    using namespace FVMCode;
+
+    UnstructuredMesh mesh;
+    {
+        UnstructuredMeshParser parser (mesh);
+    }
+    const unsigned int repetitions = 20;
+    const unsigned int n_internal  = mesh.get_patches ()[0].start_face;
+
+    std::cout << "Mesh: " << mesh.n_cells () << " cells, " << mesh.n_faces ()
+              << " faces" << std::endl;
+    std::cout << "sizeof(Point<3>) = " << sizeof (Point<3>)
+              << ", alignof(Point<3>) = " << alignof (Point<3>) << std::endl;
+
+    std::vector<Face<3> > faces;
+    faces.reserve (mesh.n_faces ());
+    const double face_time = Benchmark::time_best_of (repetitions, [&] () {
+        faces.clear ();
+        for (const Face<3> &face : mesh.faces ())
+            faces.emplace_back (face.vertices ());
+    });
+    Benchmark::report ("Face constructor", face_time, mesh.n_faces (),
+                       "face");
+
+    std::vector<Cell<3> > cells;
+    cells.reserve (mesh.n_cells ());
+    const double cell_time = Benchmark::time_best_of (repetitions, [&] () {
+        cells.clear ();
+        for (const Cell<3> &cell : mesh.cells ())
+            cells.emplace_back (cell.faces ());
+    });
+    Benchmark::report ("Cell constructor", cell_time, mesh.n_cells (),
+                       "cell");
+
+    // Same face loop as construct_convection_term_upwind, but assembling into
+    // diagonal and off-diagonal arrays so the dense matrix does not dominate
+    const Point<3>      velocity (1., 0., 0.);
+    std::vector<double> diagonal (mesh.n_cells ());
+    std::vector<double> upper (n_internal), lower (n_internal);
+    const double        assembly_time
+        = Benchmark::time_best_of (repetitions * 10, [&] () {
+              std::fill (diagonal.begin (), diagonal.end (), 0.);
+              for (unsigned int f = 0; f < n_internal; f++)
+              {
+                  const auto  &face      = mesh.get_face (f);
+                  const double face_flux = velocity.dot (face->area_vector ());
+                  if (face_flux > 0.)
+                  {
+                      diagonal[face->neighbour_indices ()[0]] += face_flux;
+                      lower[f] = -face_flux;
+                      upper[f] = 0.;
+                  }
+                  else
+                  {
+                      diagonal[face->neighbour_indices ()[1]] += -face_flux;
+                      upper[f] = face_flux;
+                      lower[f] = 0.;
+                  }
+              }
+              Benchmark::do_not_optimise (diagonal);
+          });
+    Benchmark::report ("Upwind convection assembly", assembly_time,
+                       n_internal, "face");
+
+    return EXIT_SUCCESS;
+}
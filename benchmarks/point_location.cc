@@ -0,0 +1,119 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <random>
+#include <vector>
+
+#include "benchmark_helpers.h"
+
+// Compares the linear scan in UnstructuredMesh::get_cell_containing_point
+// with the bounding volume hierarchy built by build_search_tree(), for
+// single and batched queries, and with the neighbour walk for a coherent
+// stream of points along a line through the cell centres. Runs on the
+// convection_diffusion mesh and on a synthetic n x n x n box mesh.
+//
+// Usage: point_location [n (default 100, i.e. 1M cells)] [n_threads]
+
+using namespace FVMCode;
+
+std::vector<Point<3> > random_cell_centers (UnstructuredMesh  &mesh,
+                                            const unsigned int n_points)
+{
+    std::mt19937                                rng (42);
+    std::uniform_int_distribution<unsigned int> cell (0, mesh.n_cells () - 1);
+    std::vector<Point<3> >                      points (n_points);
+    for (auto &point : points)
+        point = mesh.get_cell (cell (rng))->center ();
+    return points;
+}
+
+void run (const std::string &name, UnstructuredMesh &mesh,
+          const unsigned int n_threads)
+{
+    std::cout << name << ": " << mesh.n_cells () << " cells" << std::endl;
+
+    // The linear scan is far too slow to run many queries on a big mesh
+    const unsigned int n_linear_queries
+        = std::max (10u, std::min (2000u, 20000000u / mesh.n_cells ()));
+    const unsigned int n_tree_queries = 100000;
+
+    std::vector<Point<3> > points
+        = random_cell_centers (mesh, n_linear_queries);
+    std::vector<unsigned int> linear_cells (points.size ());
+    const double              linear_time = Benchmark::time_best_of (1, [&] {
+        for (unsigned int i = 0; i < points.size (); i++)
+            linear_cells[i] = mesh.get_cell_containing_point (points[i]);
+    });
+    Benchmark::report ("  linear scan", linear_time, points.size (),
+                       "query");
+
+    const double build_time
+        = Benchmark::time_best_of (1, [&] { mesh.build_search_tree (); });
+    Benchmark::report ("  search tree construction", build_time,
+                       mesh.n_cells (), "cell");
+
+    for (unsigned int i = 0; i < points.size (); i++)
+        if (mesh.get_cell_containing_point (points[i]) != linear_cells[i])
+            std::cout << "  MISMATCH for point " << points[i] << std::endl;
+
+    points = random_cell_centers (mesh, n_tree_queries);
+    std::vector<unsigned int> tree_cells (points.size ());
+    const double              tree_time = Benchmark::time_best_of (3, [&] {
+        for (unsigned int i = 0; i < points.size (); i++)
+            tree_cells[i] = mesh.get_cell_containing_point (points[i]);
+    });
+    Benchmark::report ("  search tree", tree_time, points.size (), "query");
+
+    const double batch_time = Benchmark::time_best_of (3, [&] {
+        tree_cells = mesh.get_cells_containing_points (points, n_threads);
+    });
+    Benchmark::report ("  search tree, batch (" + std::to_string (n_threads)
+                           + " threads)",
+                       batch_time, points.size (), "query");
+
+    // Coherent stream: small steps along the line between two cell centres
+    const std::vector<Point<3> > ends = random_cell_centers (mesh, 2);
+    for (unsigned int i = 0; i < points.size (); i++)
+        points[i] = ends[0]
+                    + (ends[1] - ends[0]) * ((i + 0.5) / points.size ());
+    const double stream_tree_time = Benchmark::time_best_of (3, [&] {
+        for (unsigned int i = 0; i < points.size (); i++)
+            tree_cells[i] = mesh.get_cell_containing_point (points[i]);
+    });
+    Benchmark::report ("  line stream, search tree", stream_tree_time,
+                       points.size (), "query");
+    const double walk_time = Benchmark::time_best_of (3, [&] {
+        unsigned int hint = tree_cells[0];
+        for (unsigned int i = 0; i < points.size (); i++)
+            hint = tree_cells[i] = mesh.get_cell_containing_point (points[i],
+                                                                   hint);
+    });
+    Benchmark::report ("  line stream, neighbour walk", walk_time,
+                       points.size (), "query");
+}
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 100;
+    const unsigned int n_threads
+        = argc > 2 ? std::stoi (argv[2]) : Parallel::default_n_threads ();
+
+    {
+        UnstructuredMesh mesh;
+        UnstructuredMeshParser parser (mesh);
+        run ("convection_diffusion mesh", mesh, n_threads);
+    }
+
+    {
+        const std::string directory = "box_mesh/constant/polyMesh";
+        Benchmark::write_box_mesh (directory, n, n, n);
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        run ("box mesh", mesh, n_threads);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/renumbering.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <vector>
+
+#include "benchmark_helpers.h"
+
+// Compares geometry recomputation (the Face and Cell constructors) and
+// face-loop assembly for the original cell ordering, reverse Cuthill-McKee
+// and the Hilbert and Morton space filling curve orderings. Runs on the
+// convection_diffusion mesh and on an n x n x n box mesh with randomly
+// shuffled point and cell labels.
+//
+// Usage: renumbering [n (default 50)]
+
+using namespace FVMCode;
+
+void time_ordering (const std::string &name, UnstructuredMesh &mesh)
+{
+    const unsigned int repetitions = 5;
+    const unsigned int n_internal  = mesh.get_patches ()[0].start_face;
+    std::cout << "  " << name << ": band " << mesh.matrix_band ()
+              << std::endl;
+
+    std::vector<Face<3> > faces;
+    std::vector<Cell<3> > cells;
+    faces.reserve (mesh.n_faces ());
+    cells.reserve (mesh.n_cells ());
+    const double geometry_time = Benchmark::time_best_of (repetitions, [&] {
+        faces.clear ();
+        cells.clear ();
+        for (const Face<3> &face : mesh.faces ())
+            faces.emplace_back (face.vertices ());
+        for (const Cell<3> &cell : mesh.cells ())
+            cells.emplace_back (cell.faces ());
+    });
+    Benchmark::report ("    geometry", geometry_time, mesh.n_cells (),
+                       "cell");
+
+    // Diffusion plus upwind convection coefficients
+    const Point<3>      velocity (1., 0.5, 0.25);
+    std::vector<double> diagonal (mesh.n_cells ());
+    std::vector<double> upper (n_internal), lower (n_internal);
+    const double assembly_time = Benchmark::time_best_of (repetitions, [&] {
+        std::fill (diagonal.begin (), diagonal.end (), 0.);
+        for (unsigned int f = 0; f < n_internal; f++)
+        {
+            const auto        &face      = mesh.get_face (f);
+            const unsigned int owner     = face->neighbour_indices ()[0];
+            const unsigned int neighbour = face->neighbour_indices ()[1];
+            const double       a_N       = face->area () * face->delta ();
+            const double face_flux = velocity.dot (face->area_vector ());
+            diagonal[owner] += a_N + std::max (face_flux, 0.);
+            diagonal[neighbour] += a_N + std::max (-face_flux, 0.);
+            upper[f] = -a_N + std::min (face_flux, 0.);
+            lower[f] = -a_N - std::max (face_flux, 0.);
+        }
+        Benchmark::do_not_optimise (diagonal);
+    });
+    Benchmark::report ("    face loop assembly", assembly_time, n_internal,
+                       "face");
+}
+
+void run (const std::string &name, const std::string &directory)
+{
+    std::cout << name << std::endl;
+    for (unsigned int ordering = 0; ordering < 4; ordering++)
+    {
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        if (ordering == 0)
+            time_ordering ("original", mesh);
+        else if (ordering == 1)
+        {
+            mesh.renumber_cells_rcm ();
+            time_ordering ("reverse Cuthill-McKee", mesh);
+        }
+        else if (ordering == 2)
+        {
+            mesh.renumber_space_filling_curve (
+                Renumbering::SpaceFillingCurve::hilbert);
+            time_ordering ("Hilbert", mesh);
+        }
+        else
+        {
+            mesh.renumber_space_filling_curve (
+                Renumbering::SpaceFillingCurve::morton);
+            time_ordering ("Morton", mesh);
+        }
+    }
+}
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 50;
+
+    run ("convection_diffusion mesh", "constant/polyMesh");
+
+    const std::string directory = "shuffled_box_mesh/constant/polyMesh";
+    Benchmark::write_box_mesh (directory, n, n, n, true);
+    run ("shuffled box mesh, " + std::to_string (n * n * n) + " cells",
+         directory);
+
+    return EXIT_SUCCESS;
+}
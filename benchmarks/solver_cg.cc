@@ -0,0 +1,107 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/operators.h>
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_cg.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <Eigen/SparseLU>
+
+#include "benchmark_helpers.h"
+
+// Wall time of solving one timestep of the heat equation from a random
+// field on n x n x n box meshes of increasing size with a sparse LU
+// factorisation, and with the conjugate gradient method without
+// preconditioning and with the Jacobi and DIC preconditioners, from a zero
+// initial guess down to a relative residual of 1e-8. The time of the
+// preconditioned solvers includes setting up the preconditioner. The LU
+// solve is skipped above max_lu cells.
+//
+// Usage: solver_cg [max_lu (default 40000)]
+
+using namespace FVMCode;
+
+int main (int argc, char **argv)
+{
+    const unsigned int max_lu = argc > 1 ? std::stoi (argv[1]) : 40000;
+
+    std::cout << std::setw (8) << "cells" << std::setw (12) << "LU s"
+              << std::setw (12) << "CG s" << std::setw (6) << "its"
+              << std::setw (12) << "Jacobi s" << std::setw (6) << "its"
+              << std::setw (12) << "DIC s" << std::setw (6) << "its"
+              << std::endl;
+    for (const unsigned int n : { 16, 24, 32, 48, 64 })
+    {
+        const std::string directory = "solver_cg_case/polyMesh";
+        Benchmark::write_box_mesh (directory, n, n, n);
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        const unsigned int n_cells = mesh.n_cells ();
+
+        // A fixed value on the first side, and zero gradient on the others.
+        // The random field keeps the solution from being one dimensional,
+        // which would favour CG without preconditioning.
+        BoundaryConditions bcs;
+        for (const BoundaryPatch &patch : mesh.get_patches ())
+            bcs.emplace_back (patch, BoundaryFieldEntry (bcs.empty ()
+                                                             ? "fixedValue"
+                                                             : "zeroGradient",
+                                                         1.));
+        const SparsityPattern sp (mesh);
+        SparseMatrix          matrix (sp);
+        VectorXd              rhs = VectorXd::Zero (n_cells);
+        Operators::ddt (matrix, rhs, mesh, VectorXd::Random (n_cells), 0.05);
+        Operators::laplacian (matrix, rhs, mesh, bcs, 1.);
+
+        SolverControl control;
+        control.tolerance          = 0.;
+        control.relative_tolerance = 1e-8;
+        control.max_iterations     = 10000;
+        const SolverCG solver (control);
+        VectorXd       x;
+        SolverResult   result;
+        auto           time_cg = [&] (auto &&make_preconditioner) {
+            const double seconds = Benchmark::time_best_of (3, [&] {
+                x = VectorXd::Zero (n_cells);
+                const auto preconditioner = make_preconditioner ();
+                result = solver.solve (matrix, x, rhs, preconditioner);
+            });
+            AssertThrow (result.converged,
+                         std::runtime_error ("CG did not converge"));
+            std::cout << std::setw (12) << seconds << std::setw (6)
+                      << result.iterations;
+        };
+
+        std::cout << std::setw (8) << n_cells << std::scientific
+                  << std::setprecision (3);
+        VectorXd lu_solution;
+        if (n_cells <= max_lu)
+        {
+            Eigen::SparseMatrix<double> eigen_matrix;
+            const double lu_time = Benchmark::time_best_of (1, [&] {
+                matrix.copy_to (eigen_matrix);
+                Eigen::SparseLU<Eigen::SparseMatrix<double> > lu (
+                    eigen_matrix);
+                lu_solution = lu.solve (rhs);
+            });
+            std::cout << std::setw (12) << lu_time;
+        }
+        else
+            std::cout << std::setw (12) << "-";
+        time_cg ([] { return PreconditionerIdentity (); });
+        time_cg ([&] { return PreconditionerJacobi (matrix); });
+        time_cg ([&] { return PreconditionerDIC (matrix); });
+        std::cout << std::endl;
+        AssertThrow (
+            lu_solution.size () == 0
+                || (x - lu_solution).lpNorm<Eigen::Infinity> ()
+                       < 1e-6 * lu_solution.lpNorm<Eigen::Infinity> (),
+            std::runtime_error ("Solutions differ"));
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <map>
+
+#include "benchmark_helpers.h"
+
+// Compares ways of assembling a Laplacian into a SparseMatrix on an
+// n x n x n box mesh: through a std::map from (i, j) to the arrow index, as
+// SparsityPattern used to look entries up, through operator(), which
+// searches the row, and by face with add_face() and add_diag(). Also times
+// building the sparsity pattern with and without the std::map debug index.
+//
+// Usage: sparse_assembly [n (default 100)]
+
+using namespace FVMCode;
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 100;
+
+    const std::string directory = "box_mesh/constant/polyMesh";
+    Benchmark::write_box_mesh (directory, n, n, n);
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (mesh, directory + "/points",
+                                   directory + "/faces", directory + "/owner",
+                                   directory + "/neighbour",
+                                   directory + "/boundary");
+    const unsigned int n_internal_faces = mesh.get_patches ()[0].start_face;
+    std::cout << "Box mesh: " << mesh.n_cells () << " cells, "
+              << n_internal_faces << " internal faces" << std::endl;
+
+    std::vector<unsigned int> owner (n_internal_faces),
+        neighbour (n_internal_faces);
+    std::vector<double> coefficient (n_internal_faces);
+    for (unsigned int f = 0; f < n_internal_faces; f++)
+    {
+        const auto &face = mesh.get_face (f);
+        owner[f]         = face->neighbour_indices ()[0];
+        neighbour[f]     = face->neighbour_indices ()[1];
+        coefficient[f]   = face->area () * face->delta ();
+    }
+
+    Benchmark::report ("Pattern", Benchmark::time_best_of (3, [&] {
+                           SparsityPattern sp (mesh);
+                           Benchmark::do_not_optimise (sp);
+                       }),
+                       n_internal_faces, "face");
+    Benchmark::report ("Pattern with debug index",
+                       Benchmark::time_best_of (3, [&] {
+                           SparsityPattern sp (mesh, true);
+                           Benchmark::do_not_optimise (sp);
+                       }),
+                       n_internal_faces, "face");
+
+    const SparsityPattern sp (mesh);
+
+    // The lookup SparsityPattern used before, into plain arrays
+    std::map<std::pair<unsigned int, unsigned int>, unsigned int> lookup;
+    for (unsigned int f = 0; f < n_internal_faces; f++)
+        lookup[std::minmax (owner[f], neighbour[f])] = f;
+    std::vector<double> diagonal (mesh.n_cells ()), upper (n_internal_faces),
+        lower (n_internal_faces);
+    auto entry = [&] (const unsigned int i, const unsigned int j) -> double & {
+        if (i == j)
+            return diagonal[i];
+        if (i < j)
+            return upper[lookup.at (std::make_pair (i, j))];
+        return lower[lookup.at (std::make_pair (j, i))];
+    };
+    Benchmark::report ("Assembly through std::map",
+                       Benchmark::time_best_of (3, [&] {
+                           for (unsigned int f = 0; f < n_internal_faces; f++)
+                           {
+                               const unsigned int i = owner[f];
+                               const unsigned int j = neighbour[f];
+                               entry (i, i) += coefficient[f];
+                               entry (j, j) += coefficient[f];
+                               entry (i, j) -= coefficient[f];
+                               entry (j, i) -= coefficient[f];
+                           }
+                       }),
+                       n_internal_faces, "face");
+    Benchmark::do_not_optimise (upper);
+
+    SparseMatrix matrix (sp);
+    Benchmark::report ("Assembly through operator()",
+                       Benchmark::time_best_of (3, [&] {
+                           for (unsigned int f = 0; f < n_internal_faces; f++)
+                           {
+                               const unsigned int i = owner[f];
+                               const unsigned int j = neighbour[f];
+                               matrix (i, i) += coefficient[f];
+                               matrix (j, j) += coefficient[f];
+                               matrix (i, j) -= coefficient[f];
+                               matrix (j, i) -= coefficient[f];
+                           }
+                       }),
+                       n_internal_faces, "face");
+    Benchmark::report ("Assembly with add_face()",
+                       Benchmark::time_best_of (3, [&] {
+                           for (unsigned int f = 0; f < n_internal_faces; f++)
+                           {
+                               matrix.add_diag (owner[f], coefficient[f]);
+                               matrix.add_diag (neighbour[f], coefficient[f]);
+                               matrix.add_face (f, -coefficient[f],
+                                                -coefficient[f]);
+                           }
+                       }),
+                       n_internal_faces, "face");
+    Benchmark::do_not_optimise (matrix);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/operators.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <Eigen/Dense>
+#include <Eigen/SparseLU>
+
+#include "benchmark_helpers.h"
+
+// Wall time of one timestep of a convection diffusion problem, and the
+// memory of its matrix, on n x n x n box meshes of increasing size: the
+// system is assembled with the operators of the library into a SparseMatrix
+// and then either copied into a dense matrix and solved with
+// colPivHouseholderQr, as the scripts used to, or solved with a sparse LU
+// factorisation. The dense solve is skipped above max_dense cells. The
+// memory is that of the matrix coefficients, without the factorisations.
+//
+// Usage: sparse_operators [max_dense (default 2000)]
+
+using namespace FVMCode;
+
+int main (int argc, char **argv)
+{
+    const unsigned int max_dense = argc > 1 ? std::stoi (argv[1]) : 2000;
+
+    std::cout << std::setw (8) << "cells" << std::setw (14) << "dense MB"
+              << std::setw (14) << "dense s" << std::setw (14) << "sparse MB"
+              << std::setw (14) << "assembly s" << std::setw (14)
+              << "sparse s" << std::endl;
+    for (const unsigned int n : { 6, 8, 10, 12, 16, 24, 32 })
+    {
+        const std::string directory = "sparse_operators_case/polyMesh";
+        Benchmark::write_box_mesh (directory, n, n, n);
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        const unsigned int n_cells = mesh.n_cells ();
+
+        // A fixed value on the first side, and zero gradient on the others
+        BoundaryConditions bcs;
+        for (const BoundaryPatch &patch : mesh.get_patches ())
+            bcs.emplace_back (patch, BoundaryFieldEntry (bcs.empty ()
+                                                             ? "fixedValue"
+                                                             : "zeroGradient",
+                                                         1.));
+        const VectorXd old_field = VectorXd::Zero (n_cells);
+
+        const SparsityPattern sp (mesh);
+        SparseMatrix          matrix (sp);
+        VectorXd              rhs (n_cells);
+        auto                  assemble = [&] () {
+            matrix.set_zero ();
+            rhs.setZero ();
+            Operators::ddt (matrix, rhs, mesh, old_field, 0.05);
+            Operators::laplacian (matrix, rhs, mesh, bcs, 0.01);
+            Operators::div (matrix, rhs, mesh, bcs, Point<3> (1., 0., 0.),
+                            Operators::ConvectionScheme::upwind);
+        };
+        const double assembly_time = Benchmark::time_best_of (3, assemble);
+
+        Eigen::SparseMatrix<double> eigen_matrix;
+        VectorXd                    sparse_solution, dense_solution;
+        const double sparse_time = Benchmark::time_best_of (1, [&] {
+            assemble ();
+            matrix.copy_to (eigen_matrix);
+            Eigen::SparseLU<Eigen::SparseMatrix<double> > solver (
+                eigen_matrix);
+            sparse_solution = solver.solve (rhs);
+        });
+        const double sparse_bytes
+            = (n_cells + sp.n_off_diagonal_entries ()) * sizeof (double);
+
+        std::cout << std::setw (8) << n_cells << std::scientific
+                  << std::setprecision (3);
+        if (n_cells <= max_dense)
+        {
+            const double dense_time = Benchmark::time_best_of (1, [&] {
+                assemble ();
+                matrix.copy_to (eigen_matrix);
+                const Eigen::MatrixXd dense_matrix (eigen_matrix);
+                dense_solution
+                    = dense_matrix.colPivHouseholderQr ().solve (rhs);
+            });
+            AssertThrow ((dense_solution - sparse_solution)
+                                 .lpNorm<Eigen::Infinity> ()
+                             < 1e-10,
+                         std::runtime_error ("Solutions differ"));
+            std::cout << std::setw (14)
+                      << double (n_cells) * n_cells * sizeof (double) / 1e6
+                      << std::setw (14) << dense_time;
+        }
+        else
+            std::cout << std::setw (14) << "-" << std::setw (14) << "-";
+        std::cout << std::setw (14) << sparse_bytes / 1e6 << std::setw (14)
+                  << assembly_time << std::setw (14) << sparse_time
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
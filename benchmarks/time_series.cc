@@ -0,0 +1,90 @@
+#include <FVMCode/field_reader.h>
+#include <FVMCode/output.h>
+#include <FVMCode/time_series.h>
+
+#include "benchmark_helpers.h"
+
+// Compares writing a field of n cells at many output times as time
+// directories with Outputter, in binary format, with appending it to a
+// single time series file, and reading back one frame from each.
+//
+// Usage: time_series [n (default 100000)] [outputs (default 500)]
+
+using namespace FVMCode;
+
+// Number of files and directories below directory
+unsigned int count_entries (const std::string &directory)
+{
+    unsigned int n = 0;
+    for (auto it = std::filesystem::recursive_directory_iterator (directory);
+         it != std::filesystem::recursive_directory_iterator (); ++it)
+        n++;
+    return n;
+}
+
+int main (int argc, char **argv)
+{
+    const unsigned int n         = argc > 1 ? std::stoi (argv[1]) : 100000;
+    const unsigned int n_outputs = argc > 2 ? std::stoi (argv[2]) : 500;
+
+    std::filesystem::remove_all ("time_series_case");
+    std::filesystem::create_directories ("time_series_case/directories");
+    std::filesystem::create_directories ("time_series_case/series");
+
+    Eigen::VectorXd          field = Eigen::VectorXd::LinSpaced (n, 0., 1.);
+    const BoundaryConditions boundary_conditions;
+    // Times that need more than the default two decimals of the directory
+    // names are avoided
+    auto time_of = [] (const unsigned int t) { return 0.01 * t; };
+
+    std::filesystem::current_path ("time_series_case/directories");
+    const double directories_time = Benchmark::time_best_of (1, [&] {
+        for (unsigned int t = 0; t < n_outputs; t++)
+        {
+            Outputter outputter (t, time_of (t), 0.01, 0.01, 2,
+                                 Outputter::Format::binary);
+            outputter.write_time ();
+            outputter.write_scalar_field (field, "T", boundary_conditions);
+        }
+    });
+    std::filesystem::current_path ("../..");
+
+    const double series_time = Benchmark::time_best_of (1, [&] {
+        TimeSeriesWriter writer ("time_series_case/series/T.series", "T", n);
+        for (unsigned int t = 0; t < n_outputs; t++)
+            writer.append (t, time_of (t), field);
+    });
+
+    // Reading the middle output
+    const unsigned int read_output = n_outputs / 2;
+    const double       directory_read_time = Benchmark::time_best_of (5, [&] {
+        Eigen::VectorXd    values;
+        BoundaryConditions read_conditions;
+        Input::read_scalar_field (
+            "time_series_case/directories/"
+                + Outputter::name_from_time (time_of (read_output), 2) + "/T",
+            n, {}, values, read_conditions);
+        Benchmark::do_not_optimise (values);
+    });
+    const double series_read_time = Benchmark::time_best_of (5, [&] {
+        const TimeSeriesReader reader ("time_series_case/series/T.series");
+        Benchmark::do_not_optimise (reader.values (read_output).sum ());
+    });
+
+    std::cout << n << " cells, " << n_outputs << " outputs" << std::endl;
+    for (const auto &[name, time, directory] :
+         { std::make_tuple ("Time directories", directories_time,
+                            "time_series_case/directories"),
+           std::make_tuple ("Time series file", series_time,
+                            "time_series_case/series") })
+        std::cout << std::left << std::setw (20) << name << std::right
+                  << std::scientific << std::setprecision (3) << std::setw (12)
+                  << time / n_outputs << " s/output" << std::setw (10)
+                  << count_entries (directory) << " files and directories"
+                  << std::endl;
+    std::cout << "Reading one output: " << directory_read_time
+              << " s from a time directory, " << series_read_time
+              << " s from the time series file" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/output.h>
+#include <FVMCode/unstructured_mesh.h>
+#include <FVMCode/vtu_output.h>
+
+#include "benchmark_helpers.h"
+
+// Compares the time per output of writing a field of an n x n x n box mesh
+// as an ASCII time directory with Outputter, which ParaView then reads
+// through the OpenFOAM reader, with writing a binary .vtu file with
+// VTUWriter, and reports the one-off cost of encoding the geometry. As
+// every .vtu file repeats the geometry, it also reports how much of each
+// file is geometry and how much is the field.
+//
+// Usage: vtu_output [n (default 40)]
+
+using namespace FVMCode;
+
+int main (int argc, char **argv)
+{
+    const unsigned int n = argc > 1 ? std::stoi (argv[1]) : 40;
+
+    const std::string directory = "vtu_output_case/constant/polyMesh";
+    Benchmark::write_box_mesh (directory, n, n, n);
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (
+        mesh, directory + "/points", directory + "/faces",
+        directory + "/owner", directory + "/neighbour",
+        directory + "/boundary");
+    std::filesystem::current_path ("vtu_output_case");
+
+    std::mt19937                           generator (0);
+    std::uniform_real_distribution<double> distribution (0., 1.);
+    Eigen::VectorXd                        field (mesh.n_cells ());
+    for (unsigned int c = 0; c < mesh.n_cells (); c++)
+        field (c) = distribution (generator);
+    BoundaryConditions boundary_conditions;
+    for (const BoundaryPatch &patch : mesh.get_patches ())
+        boundary_conditions.emplace_back (
+            patch, BoundaryFieldEntry ("zeroGradient", 0));
+
+    const double ascii_time = Benchmark::time_best_of (3, [&] {
+        Outputter outputter (1, 1., 1., 1.);
+        outputter.write_time ();
+        outputter.write_scalar_field (field, "T", boundary_conditions);
+    });
+
+    std::unique_ptr<VTUWriter> writer;
+    const double geometry_time = Benchmark::time_best_of (3, [&] {
+        writer = std::make_unique<VTUWriter> (mesh, "VTK", "case");
+    });
+    double       time     = 0;
+    const double vtu_time = Benchmark::time_best_of (3, [&] {
+        writer->write_scalar_field (time, field, "T");
+        time += 1;
+    });
+
+    std::cout << "Box mesh: " << mesh.n_cells () << " cells" << std::endl
+              << std::scientific << std::setprecision (3)
+              << "ASCII time directory:      " << ascii_time << " s/output, "
+              << std::fixed << std::setprecision (1)
+              << std::filesystem::file_size ("1.00/T") / 1e6 << " MB"
+              << std::endl
+              << std::scientific << std::setprecision (3)
+              << "VTU geometry encoding:     " << geometry_time
+              << " s once, " << std::fixed << std::setprecision (1)
+              << writer->geometry_size () / 1e6 << " MB" << std::endl
+              << std::scientific << std::setprecision (3)
+              << "VTU file:                  " << vtu_time << " s/output, "
+              << std::fixed << std::setprecision (1)
+              << std::filesystem::file_size ("VTK/case_0.vtu") / 1e6 << " MB"
+              << std::endl
+              << "  of which geometry:       "
+              << writer->geometry_size () / 1e6 << " MB, "
+              << 100. * writer->geometry_size ()
+                     / std::filesystem::file_size ("VTK/case_0.vtu")
+              << " %" << std::endl
+              << "  of which field:          "
+              << field.size () * sizeof (double) / 1e6 << " MB" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+#ifndef ASYNC_OUTPUT_H
+#define ASYNC_OUTPUT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <FVMCode/boundary_patch.h>
+#include <FVMCode/output.h>
+
+#include <Eigen/Core>
+
+namespace FVMCode
+{
+
+class TimeSeriesWriter;
+class VTUWriter;
+
+/**
+ * Writes time directories with Outputter, or time series files with
+ * TimeSeriesWriter, on a background thread, so that a simulation does not
+ * wait for the disk.
+ *
+ * write_scalar_field() copies the field into a buffer from a pool and
+ * queues it, and returns without formatting or writing anything. At most
+ * @p queue_size writes wait in the queue besides the one being written, so
+ * with the default of one the output is double buffered: the solver can
+ * compute the next field while the previous one is written. If the queue is
+ * full, write_scalar_field() blocks until there is room, so a simulation
+ * that outputs faster than the disk can take is slowed down rather than
+ * running out of memory. The time spent blocked is counted by
+ * blocked_time(); if output is hidden behind the computation it stays close
+ * to zero. A @p queue_size of zero throws std::invalid_argument.
+ *
+ * With Backend::time_directories, fields are written in @p format. With
+ * Backend::time_series, each field is appended to the time series file
+ * <name>.series in the working directory instead, in the cell order of the
+ * mesh on disk, which write_time_directories() expands into time
+ * directories when needed. The files are created when the first frame of a
+ * field is written, or appended to if @p append_time_series is true, e.g.
+ * when a run is resumed, and closed by the destructor.
+ *
+ * If @p vtu_writer is given, each field is also written with it on the
+ * background thread, so the writer must not be used by the caller until
+ * flush() returns, and must outlive the outputter.
+ *
+ * Errors while writing are rethrown by the next call of
+ * write_scalar_field() or flush(). The destructor writes everything still
+ * queued.
+ */
+class AsyncOutputter
+{
+  public:
+    enum class Backend
+    {
+        time_directories,
+        time_series
+    };
+
+    AsyncOutputter (
+        const unsigned int      queue_size         = 1,
+        const Outputter::Format format             = Outputter::Format::ascii,
+        VTUWriter              *vtu_writer         = nullptr,
+        const Backend           backend            = Backend::time_directories,
+        const bool              append_time_series = false);
+    ~AsyncOutputter ();
+
+    AsyncOutputter (const AsyncOutputter &)            = delete;
+    AsyncOutputter &operator= (const AsyncOutputter &) = delete;
+
+    /**
+     * Queues writing the time directory of @param time, as
+     * Outputter::write_time() followed by Outputter::write_scalar_field()
+     * would, or the frame of @param time of the time series of
+     * @param name. The arguments are copied, so the caller can change the
+     * field as soon as this returns.
+     */
+    void write_scalar_field (
+        const unsigned int timestep_number, const double time,
+        const double dt, const double original_dt,
+        const Eigen::VectorXd &scalar_field, const std::string &name,
+        const BoundaryConditions        &boundary_conditions,
+        const std::vector<unsigned int> &original_cell_index
+        = std::vector<unsigned int> ());
+
+    /**
+     * Waits until everything queued has been written.
+     */
+    void flush ();
+
+    /**
+     * Total time in seconds the calling thread has waited in
+     * write_scalar_field() and flush().
+     */
+    double blocked_time () const;
+
+    /**
+     * Number of time directories written so far.
+     */
+    unsigned int n_written () const;
+
+  private:
+    struct Job
+    {
+        unsigned int              timestep_number;
+        double                    time;
+        double                    dt;
+        double                    original_dt;
+        Eigen::VectorXd           scalar_field;
+        std::string               name;
+        BoundaryConditions        boundary_conditions;
+        std::vector<unsigned int> original_cell_index;
+    };
+
+    // The loop of the background thread
+    void run ();
+    // Appends the field of @p job to its time series
+    void append_to_time_series (const Job &job);
+    // Rethrows an error of the background thread, if there was one
+    void rethrow_error ();
+
+    const unsigned int      queue_size;
+    const Outputter::Format format;
+    VTUWriter *const        vtu_writer;
+    const Backend           backend;
+    const bool              append_time_series;
+
+    // Only used by the background thread: the time series of each field,
+    // and the field of a job in the cell order on disk
+    std::map<std::string, std::unique_ptr<TimeSeriesWriter> > time_series;
+    Eigen::VectorXd original_order;
+
+    mutable std::mutex      mutex;
+    // Signalled when a job is queued, or when the thread should stop
+    std::condition_variable job_queued;
+    // Signalled when a job has been written
+    std::condition_variable job_done;
+    std::deque<Job>         queue;
+    // Buffers of fields that have been written, for reuse
+    std::vector<Eigen::VectorXd> buffer_pool;
+    bool                         writing = false;
+    bool                         stop    = false;
+    std::exception_ptr           error;
+    unsigned int                 n_written_ = 0;
+
+    std::chrono::steady_clock::duration blocked
+        = std::chrono::steady_clock::duration::zero ();
+
+    // Started last, once everything it uses is initialized
+    std::thread thread;
+};
+
+} // namespace FVMCode
+
+#endif
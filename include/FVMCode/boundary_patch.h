@@ -3,6 +3,8 @@
 
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "exceptions.h"
 
@@ -63,6 +65,13 @@ class BoundaryFieldEntry
     }
 };
 
+/**
+ * The boundary condition of a field on each boundary patch, in the order of
+ * the patches of the mesh.
+ */
+using BoundaryConditions
+    = std::vector<std::pair<BoundaryPatch, BoundaryFieldEntry> >;
+
 } // namespace FVMCode
 
 #endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef CELL_SEARCH_TREE_H
+#define CELL_SEARCH_TREE_H
+
+#include <limits>
+#include <vector>
+
+#include "mesh_components.h"
+#include "point.h"
+
+namespace FVMCode
+{
+
+/**
+ * An axis aligned bounding box in 3D.
+ */
+struct BoundingBox
+{
+    // Constructs an empty box, which contains no points
+    BoundingBox ();
+
+    void extend (const Point<3> &point);
+    void extend (const BoundingBox &box);
+
+    bool   contains (const Point<3> &point) const;
+    double center (const unsigned int direction) const;
+    // Direction in which the box has the largest extent
+    unsigned int longest_direction () const;
+
+    Point<3> lower;
+    Point<3> upper;
+};
+
+/**
+ * A bounding volume hierarchy over the bounding boxes of the cells of a
+ * mesh. Built once, in O(N log N), after which finding the cell that
+ * contains a point costs O(log N) bounding box tests plus a
+ * Cell::point_inside() call for each cell whose bounding box contains the
+ * point.
+ *
+ * The tree stores cell indices, so it must be rebuilt if the cells are
+ * renumbered, and queried with the same cell list it was built from.
+ */
+class CellSearchTree
+{
+  public:
+    using CellList = internal::CellList<3>;
+
+    static constexpr unsigned int invalid_cell
+        = std::numeric_limits<unsigned int>::max ();
+
+    CellSearchTree (const CellList &cells);
+
+    /**
+     * Returns the index of the cell containing @param point, or invalid_cell
+     * if no cell contains it. If the point lies on a face shared by several
+     * cells, the lowest cell index is returned, which matches a linear scan
+     * over the cells.
+     */
+    unsigned int find_cell (const CellList &cells,
+                            const Point<3> &point) const;
+
+    unsigned int n_nodes () const { return nodes.size (); }
+
+  private:
+    struct Node
+    {
+        BoundingBox box;
+        // Nodes are stored in depth first order, so the left child of an
+        // internal node directly follows it. For leaves, [first, first +
+        // count) is a range of cell_indices; internal nodes have count zero.
+        unsigned int first;
+        unsigned int count;
+        unsigned int right_child;
+    };
+
+    // Recursively builds the subtree for cell_indices[begin, end) and
+    // returns the index of its root node
+    unsigned int build (const unsigned int begin, const unsigned int end);
+
+    static constexpr unsigned int max_leaf_size = 4;
+
+    std::vector<BoundingBox>  cell_boxes;
+    std::vector<Point<3> >    cell_box_centers;
+    std::vector<unsigned int> cell_indices;
+    std::vector<Node>         nodes;
+};
+
+} // namespace FVMCode
+
+#endif
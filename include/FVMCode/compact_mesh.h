@@ -0,0 +1,109 @@
+#ifndef COMPACT_MESH_H
+#define COMPACT_MESH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "boundary_patch.h"
+#include "exceptions.h"
+#include "file_parser_forward.h"
+
+namespace FVMCode
+{
+
+/**
+ * A flat, allocation-light representation of a 3D polyhedral mesh, following
+ * the layout used by OpenFOAM's primitiveMesh. Topology is held in
+ * contiguous 32 bit label arrays (owner/neighbour, plus CSR offset/index
+ * arrays for face->vertex and cell->face connectivity) and geometry is held
+ * as structure-of-arrays, so face loops stream through a handful of
+ * contiguous arrays rather than chasing pointers through Face objects.
+ *
+ * Internal faces come first, such that face f is internal iff
+ * f < n_internal_faces(). For an internal face the owner is
+ * owner()[f] and the neighbour is neighbour()[f]; boundary faces only have an
+ * owner. Vectors are stored by component, so the x component of the area
+ * vector of face f is face_area_vectors()[0][f].
+ *
+ * Filled by UnstructuredMeshParser::build_compact_mesh().
+ */
+class CompactMesh
+{
+  public:
+    using label            = std::int32_t;
+    using LabelList        = std::vector<label>;
+    using ScalarList       = std::vector<double>;
+    using VectorComponents = std::array<ScalarList, 3>;
+
+    unsigned int n_points () const { return points_[0].size (); }
+    unsigned int n_faces () const { return owner_.size (); }
+    unsigned int n_internal_faces () const { return neighbour_.size (); }
+    unsigned int n_cells () const { return cell_volumes_.size (); }
+
+    // Topology
+    const LabelList &owner () const { return owner_; }
+    const LabelList &neighbour () const { return neighbour_; }
+    /**
+     * The vertices of face f are
+     * face_vertices()[face_vertex_offsets()[f]] to
+     * face_vertices()[face_vertex_offsets()[f+1] - 1], in cyclic order.
+     */
+    const LabelList &face_vertex_offsets () const { return face_offsets_; }
+    const LabelList &face_vertices () const { return face_vertices_; }
+    /**
+     * The faces of cell c are cell_faces()[cell_face_offsets()[c]] to
+     * cell_faces()[cell_face_offsets()[c+1] - 1].
+     */
+    const LabelList &cell_face_offsets () const { return cell_offsets_; }
+    const LabelList &cell_faces () const { return cell_faces_; }
+
+    const std::vector<BoundaryPatch> &get_patches () const
+    {
+        return boundaries;
+    }
+
+    // Geometry
+    const VectorComponents &points () const { return points_; }
+    const VectorComponents &face_area_vectors () const { return area_vecs_; }
+    const VectorComponents &face_centers () const { return face_centers_; }
+    const ScalarList       &face_areas () const { return face_areas_; }
+    const ScalarList       &face_deltas () const { return deltas_; }
+    const ScalarList       &face_interpolation_factors () const
+    {
+        return interpolation_factors_;
+    }
+    const VectorComponents &cell_centers () const { return cell_centers_; }
+    const ScalarList       &cell_volumes () const { return cell_volumes_; }
+
+    /**
+     * Number of bytes held by the mesh's arrays.
+     */
+    std::size_t memory_consumption () const;
+
+    friend UnstructuredMeshParser;
+
+  private:
+    LabelList owner_;
+    LabelList neighbour_;
+    LabelList face_offsets_;
+    LabelList face_vertices_;
+    LabelList cell_offsets_;
+    LabelList cell_faces_;
+
+    std::vector<BoundaryPatch> boundaries;
+
+    VectorComponents points_;
+    VectorComponents area_vecs_;
+    VectorComponents face_centers_;
+    ScalarList       face_areas_;
+    ScalarList       deltas_;
+    ScalarList       interpolation_factors_;
+    VectorComponents cell_centers_;
+    ScalarList       cell_volumes_;
+};
+
+} // namespace FVMCode
+
+#endif
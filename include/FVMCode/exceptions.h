@@ -14,6 +14,15 @@
     }
 #endif
 
+// Unlike Assert, AssertThrow is also checked when DEBUG is not defined. It is
+// meant for errors in user input, such as malformed mesh files, rather than
+// for programming errors.
+#define AssertThrow(cond, exc)                                                \
+    {                                                                         \
+        if (!(cond))                                                          \
+            throw exc;                                                        \
+    }
+
 #define AssertIndexRange(index, range)                                        \
     {                                                                         \
         Assert (index < range, "Index out of range!");                        \
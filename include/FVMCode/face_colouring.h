@@ -0,0 +1,116 @@
+#ifndef FACE_COLOURING_H
+#define FACE_COLOURING_H
+
+#include <vector>
+
+#include "parallel.h"
+#include "unstructured_mesh.h"
+
+namespace FVMCode
+{
+
+/**
+ * A distance-1 colouring of the internal faces of a mesh: no two faces of
+ * the same colour share a cell. A face loop that scatters into the owner and
+ * neighbour rows can therefore process all faces of one colour concurrently
+ * without atomics, provided the colours themselves are processed one after
+ * the other.
+ *
+ * Colours are assigned greedily in face order, each face getting the lowest
+ * colour not yet used by a face of its owner or neighbour. Within a colour
+ * the faces are listed in increasing index order so that threads working on
+ * neighbouring chunks of a colour touch nearby memory.
+ *
+ * Internal faces are assumed to be numbered first, as in OpenFOAM meshes, so
+ * face indices coincide with the arrow indices of a SparsityPattern built on
+ * the same mesh.
+ */
+class FaceColouring
+{
+  public:
+    /**
+     * The faces of one colour, iterable with a range-based for loop.
+     */
+    class ColourRange
+    {
+      public:
+        ColourRange (const unsigned int *begin, const unsigned int *end)
+            : begin_ (begin)
+            , end_ (end)
+        {
+        }
+
+        const unsigned int *begin () const { return begin_; }
+        const unsigned int *end () const { return end_; }
+        unsigned int        size () const { return end_ - begin_; }
+        unsigned int        operator[] (const unsigned int i) const
+        {
+            return begin_[i];
+        }
+
+      private:
+        const unsigned int *begin_;
+        const unsigned int *end_;
+    };
+
+    FaceColouring (UnstructuredMesh &mesh);
+    /**
+     * Colours the edges (@p owner[f], @p neighbour[f]) of a graph with
+     * @param n_cells vertices.
+     */
+    FaceColouring (const unsigned int               n_cells,
+                   const std::vector<unsigned int> &owner,
+                   const std::vector<unsigned int> &neighbour);
+
+    unsigned int n_colours () const { return colour_offsets.size () - 1; }
+    unsigned int n_faces () const { return face_colour.size (); }
+
+    unsigned int colour_of_face (const unsigned int face) const
+    {
+        AssertIndexRange (face, face_colour.size ());
+        return face_colour[face];
+    }
+
+    ColourRange colour (const unsigned int c) const
+    {
+        AssertIndexRange (c, n_colours ());
+        return ColourRange (faces_by_colour.data () + colour_offsets[c],
+                            faces_by_colour.data () + colour_offsets[c + 1]);
+    }
+
+    /**
+     * Calls @param f (face) for every coloured face, colour by colour,
+     * splitting each colour across the threads of @param pool. @param f may
+     * write to data of the owner and neighbour cells of its face without
+     * synchronisation.
+     */
+    template <typename Function>
+    void for_each_face (Parallel::ThreadPool &pool, Function &&f) const
+    {
+        for (unsigned int c = 0; c < n_colours (); c++)
+        {
+            const unsigned int *faces
+                = faces_by_colour.data () + colour_offsets[c];
+            pool.parallel_for (
+                0, colour_offsets[c + 1] - colour_offsets[c],
+                [&f, faces] (const unsigned int begin, const unsigned int end) {
+                    for (unsigned int i = begin; i < end; i++) f (faces[i]);
+                });
+        }
+    }
+
+  private:
+    void compute (const unsigned int               n_cells,
+                  const std::vector<unsigned int> &owner,
+                  const std::vector<unsigned int> &neighbour);
+
+    std::vector<unsigned int> face_colour;
+    // Faces of colour c are faces_by_colour[colour_offsets[c]] to
+    // faces_by_colour[colour_offsets[c + 1] - 1]
+    std::vector<unsigned int> colour_offsets;
+    std::vector<unsigned int> faces_by_colour;
+};
+
+} // namespace FVMCode
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef FIELD_READER_H
+#define FIELD_READER_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "boundary_patch.h"
+
+namespace FVMCode
+{
+namespace Input
+{
+
+/**
+ * Reads a volScalarField, as written by Outputter::write_scalar_field or by
+ * OpenFOAM in ASCII or binary format, from the contents @p buffer of a
+ * file. The internal field may be "uniform <value>" or "nonuniform
+ * List<scalar> ...", and must have @p n_cells values.
+ *
+ * The boundaryField dictionary must have an entry for each of @p patches,
+ * and @p boundary_conditions gets one condition per patch in the order of
+ * @p patches. The value of a patch must be uniform, except for patches
+ * whose type is not fixedValue, for which the value is ignored, as OpenFOAM
+ * writes the computed boundary values of e.g. zeroGradient patches.
+ * Patch groups and regular expressions as patch names are not supported.
+ *
+ * @p file_name is only used in error messages. Throws std::runtime_error
+ * for malformed input.
+ */
+void read_scalar_field (std::string_view buffer, const std::string &file_name,
+                        const unsigned int                n_cells,
+                        const std::vector<BoundaryPatch> &patches,
+                        Eigen::VectorXd                  &internal_field,
+                        BoundaryConditions &boundary_conditions);
+
+/**
+ * As above, but reads the file @p filename, or @p filename.gz if only the
+ * compressed file exists. The inverse of
+ * Outputter::write_scalar_field(): for a mesh whose cells have been
+ * renumbered, cell c gets the value at position @p original_cell_index[c]
+ * of the file. An empty @p original_cell_index means the cells have not
+ * been renumbered.
+ */
+void read_scalar_field (const std::string                &filename,
+                        const unsigned int                n_cells,
+                        const std::vector<BoundaryPatch> &patches,
+                        Eigen::VectorXd                  &internal_field,
+                        BoundaryConditions &boundary_conditions,
+                        const std::vector<unsigned int> &original_cell_index
+                        = std::vector<unsigned int> ());
+
+/**
+ * A time directory of a case, as written by Outputter.
+ */
+struct TimeDirectory
+{
+    std::string  path;
+    double       time;
+    // The timestep number, from the uniform/time file, or 0 if the
+    // directory has none
+    unsigned int index;
+};
+
+/**
+ * Returns the time directory in @p case_directory with the latest time that
+ * holds the field @p field_name, e.g. to resume a run from, or nothing if
+ * there is none. A time directory is one whose name is a number; its time
+ * is read from uniform/time if that exists, since the name may be rounded.
+ */
+std::optional<TimeDirectory> find_latest_time (
+    const std::string &case_directory, const std::string &field_name);
+
+} // namespace Input
+} // namespace FVMCode
+
+#endif
@@ -2,17 +2,54 @@
 #define FILE_PARSER_H
 
 #include <fstream>
-#include <map>
 
 #include <FVMCode/input.h>
 
+#include "compact_mesh.h"
 #include "exceptions.h"
+#include "parallel.h"
 #include "point.h"
+#include "polymesh_reader.h"
 #include "unstructured_mesh.h"
 
 namespace FVMCode
 {
 
+/**
+ * Settings for reading meshes in OpenFOAM format with UnstructuredMeshParser.
+ */
+struct ParserOptions
+{
+    enum class Backend
+    {
+        // Reads through Input::comment_istream
+        stream,
+        // Memory-maps each file and tokenizes the mapped buffer with
+        // Input::FoamTokenizer. Files that only exist compressed, e.g.
+        // faces.gz, are decompressed into memory instead.
+        memory_mapped
+    };
+
+    Backend backend = Backend::memory_mapped;
+
+    // With the memory mapped backend, read the five polyMesh files at the
+    // same time on separate threads before linking them together
+    bool concurrent = false;
+    // With the memory mapped backend, split the points, faces, owner and
+    // neighbour lists into chunks that are read in parallel
+    bool chunked = false;
+    // Maximum number of threads used for reading
+    unsigned int n_threads = Parallel::default_n_threads ();
+
+    // If not empty, the path of a binary cache of the mesh, holding its
+    // topology, geometry and boundary patches. If the cache was written from
+    // the current versions of the polyMesh files (judged by their sizes and
+    // modification times), the mesh is read from the cache instead of the
+    // polyMesh files. Otherwise the polyMesh files are read and the cache is
+    // (re)written. Only used by the OpenFOAM format constructors.
+    std::string cache_file;
+};
+
 class UnstructuredMeshParser
 {
   public:
@@ -29,10 +66,24 @@ class UnstructuredMeshParser
                             const std::string &faces_file,
                             const std::string &owner_file,
                             const std::string &neighbour_file,
-                            const std::string &boundary_file);
+                            const std::string &boundary_file,
+                            const ParserOptions &options = ParserOptions ());
 
     // Reads mesh in OpenFoam format, assuming files are set up as in OpenFoam
-    UnstructuredMeshParser (UnstructuredMesh &mesh);
+    UnstructuredMeshParser (UnstructuredMesh    &mesh,
+                            const ParserOptions &options = ParserOptions ());
+
+    /**
+     * Fills @param compact_mesh with the topology and geometry of the parsed
+     * mesh. Requires internal faces to be numbered before boundary faces, as
+     * they are in OpenFOAM meshes.
+     */
+    void build_compact_mesh (CompactMesh &compact_mesh) const;
+
+    /**
+     * Whether the mesh was read from ParserOptions::cache_file.
+     */
+    bool loaded_from_cache () const { return from_cache; }
 
   private:
     void skip_foam_header (Input::comment_istream &file) const;
@@ -43,7 +94,23 @@ class UnstructuredMeshParser
     void parse_owner_neighbour_list (const std::string &owner_file,
                                      const std::string &neighbour_file);
     void parse_boundaries_foam (const std::string &boundary_file);
-    void _add_cells_to_faces_neighbours (const std::string &label_list_file);
+    void
+    _add_cells_to_faces_neighbours (const std::string         &label_list_file,
+                                    std::vector<unsigned int> &labels);
+    // Builds the cells from the owner and neighbour lists of the faces
+    void construct_cells (const std::vector<unsigned int> &owner,
+                          const std::vector<unsigned int> &neighbour);
+
+    // Reads the files with the memory mapped backend
+    void read_memory_mapped (const std::string   &points_file,
+                             const std::string   &faces_file,
+                             const std::string   &owner_file,
+                             const std::string   &neighbour_file,
+                             const std::string   &boundary_file,
+                             const ParserOptions &options,
+                             Input::PolyMeshData &data) const;
+    // Builds the mesh from the contents of the polyMesh files
+    void link (Input::PolyMeshData &data);
 
     // Ensures normal vectors are pointing in the right direction relative to
     // owner and neighbour cells
@@ -52,9 +119,16 @@ class UnstructuredMeshParser
 
     void compute_distance_ratios ();
 
+    // Reads the mesh from cache_file if it is a valid cache of the files
+    // source_files, and returns whether it was
+    bool read_cache (const std::string              &cache_file,
+                     const std::vector<std::string> &source_files);
+    void write_cache (const std::string              &cache_file,
+                      const std::vector<std::string> &source_files) const;
+
     UnstructuredMesh &mesh;
 
-    std::map<unsigned int, std::vector<unsigned int> > faces_of_cell;
+    bool from_cache = false;
 };
 
 }
@@ -0,0 +1,198 @@
+#ifndef FOAM_TOKENIZER_H
+#define FOAM_TOKENIZER_H
+
+#include <charconv>
+#include <string>
+#include <string_view>
+
+namespace FVMCode
+{
+namespace Input
+{
+
+/**
+ * The entries of the FoamFile header of an OpenFOAM file that determine how
+ * the rest of the file is read.
+ */
+struct FoamHeader
+{
+    // False if the file has no FoamFile header, in which case the other
+    // members keep their defaults
+    bool present = false;
+    // "format binary;" rather than "format ascii;"
+    bool binary = false;
+    // The "class" entry, e.g. faceList or faceCompactList
+    std::string class_name;
+    // Sizes in bits of labels and scalars in binary data, from the "arch"
+    // entry, e.g. "LSB;label=32;scalar=64"
+    unsigned int label_bits  = 32;
+    unsigned int scalar_bits = 64;
+};
+
+/**
+ * Splits an OpenFOAM file held in memory into tokens. Unlike
+ * comment_istream, the tokenizer works directly on a character buffer (for
+ * example a MappedFile), so it never copies the input, and numbers are
+ * converted with std::from_chars, which does no locale handling.
+ *
+ * Whitespace and comments (// and /\* *\/) are skipped before every token.
+ * Malformed input throws std::runtime_error with the file name and line
+ * number, since reading past the end of the buffer would otherwise be
+ * undefined.
+ */
+class FoamTokenizer
+{
+  public:
+    /**
+     * Tokenizes @param buffer, which must outlive the tokenizer.
+     * @param name is only used in error messages.
+     */
+    FoamTokenizer (std::string_view buffer, const std::string &name = "");
+
+    /**
+     * If the next token is the FoamFile dictionary, skips past its closing
+     * brace, otherwise does nothing.
+     */
+    void skip_foam_header () { read_foam_header (); }
+
+    /**
+     * As skip_foam_header(), but also returns the entries of the header.
+     * Throws if the header describes binary data this machine cannot read,
+     * i.e. big endian data or 32 bit scalars.
+     */
+    FoamHeader read_foam_header ();
+
+    /**
+     * Returns true if only whitespace and comments are left.
+     */
+    bool at_end ()
+    {
+        skip_whitespace_and_comments ();
+        return cursor == end;
+    }
+
+    /**
+     * Returns the next non-whitespace character without consuming it, or
+     * '\0' at the end of the buffer.
+     */
+    char peek ()
+    {
+        skip_whitespace_and_comments ();
+        return cursor == end ? '\0' : *cursor;
+    }
+
+    /**
+     * Consumes the next character, which must be @param c.
+     */
+    void expect (const char c)
+    {
+        skip_whitespace_and_comments ();
+        if (cursor == end || *cursor != c)
+            error (std::string ("expected '") + c + "'");
+        ++cursor;
+    }
+
+    /**
+     * Reads a non-negative integer.
+     */
+    unsigned int read_unsigned ()
+    {
+        unsigned int value;
+        read_number (value, "expected an unsigned integer");
+        return value;
+    }
+
+    double read_double ()
+    {
+        double value;
+        read_number (value, "expected a number");
+        return value;
+    }
+
+    /**
+     * Reads a word: a run of characters up to whitespace, a bracket or a
+     * semicolon. Double quotes around the word are removed.
+     */
+    std::string_view read_word ();
+
+    /**
+     * Returns a pointer to the next @param n_bytes bytes of binary data and
+     * moves past them. Unlike all other methods, nothing is skipped first,
+     * since binary data directly follows the opening bracket of a list.
+     */
+    const char *read_bytes (const std::size_t n_bytes)
+    {
+        if (static_cast<std::size_t> (end - cursor) < n_bytes)
+            error ("unexpected end of binary data");
+        const char *bytes = cursor;
+        cursor += n_bytes;
+        return bytes;
+    }
+
+    /**
+     * Skips the rest of a dictionary entry, up to and including the
+     * semicolon that ends it. Brackets inside the entry are skipped as a
+     * whole.
+     */
+    void skip_entry ();
+    /**
+     * As skip_entry(), but if the entry is a sub-dictionary, skips up to and
+     * including its closing brace.
+     */
+    void skip_entry_or_dictionary ();
+
+    /**
+     * Offset of the next unread character from the start of the buffer.
+     */
+    std::size_t position () const { return cursor - begin; }
+
+    /**
+     * Throws std::runtime_error with @param what, the file name and the
+     * current line.
+     */
+    [[noreturn]] void error (const std::string &what) const;
+
+  private:
+    static bool is_space (const char c)
+    {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f'
+               || c == '\v';
+    }
+
+    void skip_whitespace_and_comments ()
+    {
+        while (cursor != end)
+        {
+            if (is_space (*cursor))
+                ++cursor;
+            else if (*cursor == '/')
+                skip_comment ();
+            else
+                return;
+        }
+    }
+
+    // Skips a comment starting at cursor, or throws if the / does not start
+    // one
+    void skip_comment ();
+
+    template <typename Number>
+    void read_number (Number &value, const char *what)
+    {
+        skip_whitespace_and_comments ();
+        const auto [next, ec] = std::from_chars (cursor, end, value);
+        if (ec != std::errc ())
+            error (what);
+        cursor = next;
+    }
+
+    const char *begin;
+    const char *cursor;
+    const char *end;
+    std::string name;
+};
+
+} // namespace Input
+} // namespace FVMCode
+
+#endif
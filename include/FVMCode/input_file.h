@@ -0,0 +1,72 @@
+#ifndef INPUT_FILE_H
+#define INPUT_FILE_H
+
+#include <future>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "mapped_file.h"
+
+namespace FVMCode
+{
+namespace Input
+{
+
+/**
+ * The contents of an input file that may have been compressed with gzip, as
+ * OpenFOAM does with "writeCompression on". If @p filename exists it is
+ * memory mapped. Otherwise, if @p filename.gz exists, it is decompressed
+ * into memory on a background thread, so that the caller can do other work,
+ * such as parsing other files, in the meantime.
+ */
+class InputFile
+{
+  public:
+    /**
+     * Opens @param filename or @param filename.gz and, for the latter,
+     * starts decompressing. If @param decompress_in_background is false,
+     * the file is decompressed before the constructor returns. Throws
+     * std::runtime_error if neither file can be opened.
+     */
+    explicit InputFile (const std::string &filename,
+                        const bool         decompress_in_background = true);
+    ~InputFile ();
+
+    InputFile (const InputFile &)            = delete;
+    InputFile &operator= (const InputFile &) = delete;
+
+    /**
+     * The contents of the file. For a compressed file this waits for
+     * decompression to finish, and rethrows any error that occurred during
+     * it.
+     */
+    std::string_view view () const;
+
+    /**
+     * Whether the contents were read from a .gz file.
+     */
+    bool compressed () const { return !mapped_file.has_value (); }
+
+    /**
+     * The path of the file actually read.
+     */
+    const std::string &path () const { return path_; }
+
+  private:
+    std::string                   path_;
+    std::optional<MappedFile>     mapped_file;
+    std::string                   decompressed;
+    mutable std::shared_future<void> decompression;
+};
+
+/**
+ * Decompresses all gzip members in @param compressed, and throws
+ * std::runtime_error with @param file_name if the data is corrupt.
+ */
+std::string gunzip (std::string_view compressed, const std::string &file_name);
+
+} // namespace Input
+} // namespace FVMCode
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace FVMCode
+{
+namespace Input
+{
+
+/**
+ * Read-only memory mapping of a whole file. The contents are paged in by the
+ * operating system on first access, so the file is never copied into a
+ * separate buffer. The mapping is released on destruction.
+ */
+class MappedFile
+{
+  public:
+    /**
+     * Maps @param filename. Throws std::runtime_error if the file cannot be
+     * opened or mapped.
+     */
+    explicit MappedFile (const std::string &filename);
+    ~MappedFile ();
+
+    MappedFile (MappedFile &&other) noexcept;
+    MappedFile &operator= (MappedFile &&other) noexcept;
+
+    MappedFile (const MappedFile &)            = delete;
+    MappedFile &operator= (const MappedFile &) = delete;
+
+    const char      *data () const { return data_; }
+    std::size_t      size () const { return size_; }
+    std::string_view view () const { return std::string_view (data_, size_); }
+
+  private:
+    void unmap ();
+
+    const char *data_;
+    std::size_t size_;
+};
+
+} // namespace Input
+} // namespace FVMCode
+
+#endif
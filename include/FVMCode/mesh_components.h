@@ -11,6 +11,8 @@
 namespace FVMCode
 {
 
+class UnstructuredMesh;
+
 /**
  * Represents a generalised face of a dim-dimensional manifold embedded in
  * spacedim-dimensional space. For example, with dim=spacedim=3, this
@@ -74,8 +76,21 @@ template <int dim, int spacedim> class Face
     double interpolation_factor () const { return interpolation_factor_; }
 
     friend UnstructuredMeshParser;
+    friend UnstructuredMesh;
 
   private:
+    // Constructs a face whose geometry has already been computed, e.g. when
+    // reading a mesh cache
+    Face (const std::vector<PointIterator> &vertices,
+          const Point<spacedim> &area_vector, const Point<spacedim> &centroid,
+          const double area)
+        : vertex_list (vertices)
+        , area_vec (area_vector)
+        , centroid (centroid)
+        , scalar_area (area)
+    {
+    }
+
     std::vector<PointIterator> vertex_list;
     std::vector<unsigned int>  neighbour_list;
     // TODO: replace with generalised tensor class
@@ -111,8 +126,19 @@ template <int dim, int spacedim> class Cell
     bool point_inside (const Point<spacedim> &point) const;
 
     friend UnstructuredMeshParser;
+    friend UnstructuredMesh;
 
   private:
+    // Constructs a cell whose geometry has already been computed, e.g. when
+    // reading a mesh cache
+    Cell (const std::vector<FaceIterator> &faces,
+          const Point<spacedim> &centroid, const double volume)
+        : face_list (faces)
+        , centroid (centroid)
+        , volume_ (volume)
+    {
+    }
+
     std::vector<PointIterator> vertices () const;
     void                       compute_volume_and_centroid ();
 
@@ -0,0 +1,79 @@
+#ifndef OPERATORS_H
+#define OPERATORS_H
+
+#include <FVMCode/boundary_patch.h>
+#include <FVMCode/point.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <Eigen/Core>
+
+namespace FVMCode
+{
+
+/**
+ * Finite volume discretisations of the terms of a scalar transport
+ * equation, which add their coefficients to a SparseMatrix built from the
+ * sparsity pattern of the mesh, and their explicit parts to a right hand
+ * side vector, such that the equation is matrix * phi = rhs.
+ *
+ * The matrix and right hand side are not zeroed, so a system is assembled
+ * by calling an operator for each term. Boundary conditions are given per
+ * patch, in the order of the patches of the mesh; "fixedValue" and
+ * "zeroGradient" are supported, and empty patches are skipped. Internal
+ * faces are assembled with SparseMatrix::add_face(), so any owner and
+ * neighbour numbering is allowed.
+ */
+namespace Operators
+{
+
+/**
+ * Implicit Euler time derivative d(phi)/dt, with @param old_field the
+ * field at the start of the timestep @param dt.
+ */
+void ddt (SparseMatrix &matrix, VectorXd &rhs, UnstructuredMesh &mesh,
+          const VectorXd &old_field, const double dt);
+
+/**
+ * Diffusion -div(@param diffusivity grad(phi)), i.e. the negative of the
+ * Laplacian, so that it adds a positive diagonal. Uses the face deltas of
+ * the mesh, without non-orthogonal correction.
+ */
+void laplacian (SparseMatrix &matrix, VectorXd &rhs, UnstructuredMesh &mesh,
+                const BoundaryConditions &boundary_conditions,
+                const double              diffusivity);
+
+enum class ConvectionScheme
+{
+    // First order upwind
+    upwind,
+    // Linear interpolation with the face interpolation factors
+    centred
+};
+
+/**
+ * Convection div(@param velocity phi) for a uniform velocity, with the face
+ * values interpolated by @param scheme. On fixedValue boundaries the face
+ * value is the boundary value, and on zeroGradient boundaries the value of
+ * the cell.
+ */
+void div (SparseMatrix &matrix, VectorXd &rhs, UnstructuredMesh &mesh,
+          const BoundaryConditions &boundary_conditions,
+          const Point<3> &velocity, const ConvectionScheme scheme);
+
+/**
+ * Source of @param strength per unit volume in cell @param cell.
+ */
+void source (VectorXd &rhs, UnstructuredMesh &mesh, const unsigned int cell,
+             const double strength);
+
+/**
+ * Uniform source of @param strength per unit volume in every cell.
+ */
+void source (VectorXd &rhs, UnstructuredMesh &mesh, const double strength);
+
+} // namespace Operators
+
+} // namespace FVMCode
+
+#endif
@@ -15,12 +15,24 @@ namespace FVMCode
 class Outputter
 {
   public:
-    using BoundaryConditions
-    = std::vector<std::pair<BoundaryPatch, BoundaryFieldEntry> >;
-    
+    using BoundaryConditions = FVMCode::BoundaryConditions;
+
+    /**
+     * The format of the fields written. ASCII values are written with the
+     * fewest digits that read back to exactly the same double. Binary
+     * fields hold the raw doubles of the internal field, and are read by
+     * OpenFOAM and ParaView as "format binary;" files.
+     */
+    enum class Format
+    {
+        ascii,
+        binary
+    };
+
     Outputter (const unsigned int timestep_number, const double time,
                const double dt, const double original_dt,
-               const unsigned int file_name_precision = 2);
+               const unsigned int file_name_precision = 2,
+               const Format       format              = Format::ascii);
     static std::string name_from_time (const double time,
                                        unsigned int file_name_precision);
 
@@ -28,17 +40,31 @@ class Outputter
     void write_scalar_field (const VectorXd &scalar_field, std::string name,
                              const BoundaryConditions
                                  &boundary_conditions);
+    /**
+     * Writes a field defined on a mesh whose cells have been renumbered,
+     * putting the value of cell c at position @param original_cell_index[c]
+     * so the file matches the cell order of the mesh on disk (see
+     * UnstructuredMesh::original_cell_indices()). An empty
+     * @param original_cell_index means the cells have not been renumbered.
+     * Throws std::runtime_error if it does not match the field.
+     */
+    void write_scalar_field (const VectorXd &scalar_field, std::string name,
+                             const BoundaryConditions &boundary_conditions,
+                             const std::vector<unsigned int>
+                                 &original_cell_index);
 
   private:
     void        init_directory ();
     std::string get_foam_header (std::string location, std::string class_,
-                                 std::string object);
+                                 std::string object,
+                                 const Format format = Format::ascii);
 
     const std::string  dir_name;
     const double       time;
     const unsigned int timestep_number;
     const double       dt;
     const double       original_dt;
+    const Format       format;
 };
 
 } // namespace FVMCode
@@ -0,0 +1,217 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace FVMCode
+{
+namespace Parallel
+{
+
+/**
+ * Number of threads to use when the caller does not specify one. Falls back
+ * to one if the hardware concurrency cannot be determined.
+ */
+inline unsigned int default_n_threads ()
+{
+    return std::max (1u, std::thread::hardware_concurrency ());
+}
+
+namespace internal
+{
+// Splits [begin, end) into n_chunks contiguous chunks of (nearly) equal size
+// and returns the n_chunks + 1 chunk boundaries
+inline std::vector<unsigned int> chunk_bounds (const unsigned int begin,
+                                               const unsigned int end,
+                                               const unsigned int n_chunks)
+{
+    const unsigned int        n_per_chunk = (end - begin) / n_chunks;
+    const unsigned int        remainder   = (end - begin) % n_chunks;
+    std::vector<unsigned int> bounds (n_chunks + 1);
+    bounds[0] = begin;
+    for (unsigned int t = 0; t < n_chunks; t++)
+        bounds[t + 1] = bounds[t] + n_per_chunk + (t < remainder ? 1 : 0);
+    return bounds;
+}
+} // namespace internal
+
+/**
+ * Splits the range [@param begin, @param end) into @param n_threads
+ * contiguous chunks of (nearly) equal size and calls
+ * @param f (chunk_begin, chunk_end) for each chunk on its own thread. The
+ * calling thread processes the first chunk itself. Returns once all chunks
+ * have been processed.
+ *
+ * This starts new threads on every call, so for loops that are run many
+ * times use ThreadPool::parallel_for instead.
+ */
+template <typename Function>
+void parallel_for (const unsigned int begin, const unsigned int end,
+                   unsigned int n_threads, Function &&f)
+{
+    if (end <= begin)
+        return;
+    n_threads = std::max (1u, std::min (n_threads, end - begin));
+    if (n_threads == 1)
+    {
+        f (begin, end);
+        return;
+    }
+
+    const std::vector<unsigned int> bounds
+        = internal::chunk_bounds (begin, end, n_threads);
+    std::vector<std::thread> threads;
+    threads.reserve (n_threads - 1);
+    for (unsigned int t = 1; t < n_threads; t++)
+        threads.emplace_back (std::ref (f), bounds[t], bounds[t + 1]);
+    f (bounds[0], bounds[1]);
+    for (std::thread &thread : threads)
+        thread.join ();
+}
+
+/**
+ * A fixed set of worker threads that run submitted tasks in order of
+ * submission. The workers are started once, so repeated small parallel
+ * loops do not pay for thread creation. The destructor finishes all
+ * submitted tasks before joining the workers.
+ */
+class ThreadPool
+{
+  public:
+    /**
+     * Starts @param n_threads - 1 workers: the thread calling
+     * parallel_for() does a share of the work itself, so @param n_threads is
+     * the total number of threads working on a loop.
+     */
+    explicit ThreadPool (const unsigned int n_threads = default_n_threads ())
+        : n_threads_ (std::max (1u, n_threads))
+    {
+        for (unsigned int t = 1; t < n_threads_; t++)
+            workers.emplace_back ([this] { work (); });
+    }
+
+    ~ThreadPool ()
+    {
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            stopping = true;
+        }
+        condition.notify_all ();
+        for (std::thread &worker : workers)
+            worker.join ();
+    }
+
+    ThreadPool (const ThreadPool &)            = delete;
+    ThreadPool &operator= (const ThreadPool &) = delete;
+
+    unsigned int n_threads () const { return n_threads_; }
+
+    /**
+     * Queues @param f to run on a worker and returns a future for its
+     * result. Exceptions thrown by @param f are rethrown by the future's
+     * get(). With a single thread the task is run immediately.
+     */
+    template <typename Function>
+    std::future<std::invoke_result_t<Function> > submit (Function &&f)
+    {
+        using Result = std::invoke_result_t<Function>;
+        auto task    = std::make_shared<std::packaged_task<Result ()> > (
+            std::forward<Function> (f));
+        std::future<Result> result = task->get_future ();
+        if (workers.empty ())
+        {
+            (*task) ();
+            return result;
+        }
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            tasks.emplace ([task] { (*task) (); });
+        }
+        condition.notify_one ();
+        return result;
+    }
+
+    /**
+     * As Parallel::parallel_for, but running the chunks on the pool's
+     * workers.
+     */
+    template <typename Function>
+    void parallel_for (const unsigned int begin, const unsigned int end,
+                       Function &&f)
+    {
+        if (end <= begin)
+            return;
+        const unsigned int n_chunks = std::min (n_threads_, end - begin);
+        if (n_chunks == 1)
+        {
+            f (begin, end);
+            return;
+        }
+
+        const std::vector<unsigned int> bounds
+            = internal::chunk_bounds (begin, end, n_chunks);
+        std::vector<std::future<void> > chunks;
+        chunks.reserve (n_chunks - 1);
+        for (unsigned int t = 1; t < n_chunks; t++)
+            chunks.push_back (submit ([&f, &bounds, t] {
+                f (bounds[t], bounds[t + 1]);
+            }));
+        // The other chunks refer to f and bounds, so they must all finish
+        // before an exception from any chunk is passed on
+        std::exception_ptr error;
+        try
+        {
+            f (bounds[0], bounds[1]);
+        }
+        catch (...)
+        {
+            error = std::current_exception ();
+        }
+        for (std::future<void> &chunk : chunks)
+            chunk.wait ();
+        if (error)
+            std::rethrow_exception (error);
+        for (std::future<void> &chunk : chunks)
+            chunk.get ();
+    }
+
+  private:
+    void work ()
+    {
+        while (true)
+        {
+            std::function<void ()> task;
+            {
+                std::unique_lock<std::mutex> lock (mutex);
+                condition.wait (lock,
+                                [this] { return stopping || !tasks.empty (); });
+                if (tasks.empty ())
+                    return;
+                task = std::move (tasks.front ());
+                tasks.pop ();
+            }
+            task ();
+        }
+    }
+
+    const unsigned int                  n_threads_;
+    std::vector<std::thread>            workers;
+    std::queue<std::function<void ()> > tasks;
+    std::mutex                          mutex;
+    std::condition_variable             condition;
+    bool                                stopping = false;
+};
+
+} // namespace Parallel
+} // namespace FVMCode
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef PARTITIONING_H
+#define PARTITIONING_H
+
+#include <vector>
+
+#include "unstructured_mesh.h"
+
+namespace FVMCode
+{
+
+/**
+ * The cells and faces assigned to one partition of a MeshPartitioning. All
+ * lists are sorted in increasing index order.
+ */
+struct Partition
+{
+    // Cells owned by the partition
+    std::vector<unsigned int> cells;
+    // Internal faces whose owner and neighbour both belong to the partition
+    std::vector<unsigned int> internal_faces;
+    // Internal faces between a cell of this partition and a cell of another
+    // partition. Each such face appears in the lists of both partitions.
+    std::vector<unsigned int> interface_faces;
+    // Boundary faces whose owner belongs to the partition
+    std::vector<unsigned int> boundary_faces;
+    // Cells of other partitions that share an interface face with this one
+    std::vector<unsigned int> halo_cells;
+};
+
+/**
+ * Splits the cells of a mesh into a number of partitions of (nearly) equal
+ * size for shared memory domain decomposition, using recursive coordinate
+ * bisection: the cell centroids are repeatedly split along the direction in
+ * which they are most spread out, at the position that divides the cells in
+ * proportion to the number of partitions on either side, so that each
+ * partition is a compact block of space with a small surface, and hence a
+ * small edge cut.
+ *
+ * Each partition can then be processed by its own thread. Faces in
+ * Partition::internal_faces only touch cells owned by that partition, so
+ * they can be processed without synchronisation; interface faces need
+ * separate treatment.
+ */
+class MeshPartitioning
+{
+  public:
+    MeshPartitioning (UnstructuredMesh &mesh, const unsigned int n_partitions);
+
+    unsigned int n_partitions () const { return partition_list.size (); }
+
+    unsigned int partition_of_cell (const unsigned int cell) const
+    {
+        AssertIndexRange (cell, cell_partition.size ());
+        return cell_partition[cell];
+    }
+    const std::vector<unsigned int> &cell_partitions () const
+    {
+        return cell_partition;
+    }
+
+    const Partition &partition (const unsigned int p) const
+    {
+        AssertIndexRange (p, partition_list.size ());
+        return partition_list[p];
+    }
+    const std::vector<Partition> &partitions () const
+    {
+        return partition_list;
+    }
+
+    /**
+     * Number of internal faces whose owner and neighbour lie in different
+     * partitions.
+     */
+    unsigned int edge_cut () const { return n_cut_faces; }
+    /**
+     * Ratio of the largest partition size to the mean partition size, so 1
+     * is perfectly balanced.
+     */
+    double load_imbalance () const;
+
+  private:
+    // Assigns the cells cells[begin, end) to partitions
+    // [first_partition, first_partition + n_parts)
+    void bisect (const std::vector<Point<3> > &centers,
+                 std::vector<unsigned int> &cells, const unsigned int begin,
+                 const unsigned int end, const unsigned int first_partition,
+                 const unsigned int n_parts);
+
+    std::vector<unsigned int> cell_partition;
+    std::vector<Partition>    partition_list;
+    unsigned int              n_cut_faces;
+};
+
+} // namespace FVMCode
+
+#endif
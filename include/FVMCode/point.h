@@ -1,7 +1,9 @@
 #ifndef POINT_H
 #define POINT_H
 
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <vector>
 #include <iostream>
 
@@ -39,6 +41,23 @@ std::ostream& operator<<(std::ostream& os, const Point<dim,Number> &p);
 template <int dim, typename Number>
 inline Point<3, Number> cross_p(const Point<dim, Number> &p1, const Point<dim, Number> &p2);
 
+namespace internal
+{
+/**
+ * Alignment used for the coordinate storage of a Point. This is the size of
+ * the coordinate array rounded up to the next power of two (capped at 32
+ * bytes, the width of an AVX register), such that a Point<3> of doubles sits
+ * in a single aligned 32 byte slot and can be loaded with one vector load.
+ */
+template <int dim, typename Number> constexpr std::size_t point_alignment ()
+{
+    std::size_t alignment = alignof (Number);
+    while (alignment < dim * sizeof (Number) && alignment < 32)
+        alignment *= 2;
+    return alignment;
+}
+} // namespace internal
+
 template <int dim, typename Number> class Point
 {
   public:
@@ -64,7 +83,10 @@ template <int dim, typename Number> class Point
     Number dot (const Point<dim, Number> &p) const;
 
   private:
-    std::vector<Number> values;
+    // Fixed-size inline storage, so that Points (and the temporaries created
+    // by the arithmetic operators) never touch the heap
+    alignas (internal::point_alignment<dim, Number> ())
+        std::array<Number, dim> values;
 };
 
 } // namespace FVMCode
@@ -76,13 +98,13 @@ namespace FVMCode
 
 template <int dim, typename Number>
 Point<dim, Number>::Point ()
-    : values (dim)
+    : values {}
 {
 }
 
 template <int dim, typename Number>
 Point<dim, Number>::Point (const Number &x)
-    : values (1)
+    : values {}
 {
     static_assert (
         dim == 1,
@@ -92,7 +114,7 @@ Point<dim, Number>::Point (const Number &x)
 
 template <int dim, typename Number>
 Point<dim, Number>::Point (const Number &x, const Number &y)
-    : values (2)
+    : values {}
 {
     static_assert (
         dim == 2,
@@ -103,7 +125,7 @@ Point<dim, Number>::Point (const Number &x, const Number &y)
 
 template <int dim, typename Number>
 Point<dim, Number>::Point (const Number &x, const Number &y, const Number &z)
-    : values (3)
+    : values {}
 {
     static_assert (
         dim == 3,
@@ -132,7 +154,7 @@ Point<dim, Number>::operator+= (const Point<dim, Number> &p)
 {
     for (unsigned int i = 0; i < dim; i++)
     {
-        values[i] += p(i);
+        values[i] += p.values[i];
     }
     return *this;
 }
@@ -143,7 +165,7 @@ Point<dim, Number>::operator-= (const Point<dim, Number> &p)
 {
     for (unsigned int i = 0; i < dim; i++)
     {
-        values[i] -= p(i);
+        values[i] -= p.values[i];
     }
     return *this;
 }
@@ -175,7 +197,8 @@ Point<dim, Number>::distance_squared (const Point<dim, Number> &p) const
     Number sum = 0;
     for (unsigned int i = 0; i < dim; i++)
     {
-        sum += std::pow (p (i) - values[i], 2);
+        const Number diff = p.values[i] - values[i];
+        sum += diff * diff;
     }
     return sum;
 }
@@ -198,7 +221,7 @@ inline Number Point<dim, Number>::norm_squared () const
     Number sum = 0;
     for (unsigned int i = 0; i < dim; i++)
     {
-        sum += std::pow (values[i], 2);
+        sum += values[i] * values[i];
     }
     return sum;
 }
@@ -209,7 +232,7 @@ inline Number Point<dim, Number>::dot (const Point<dim, Number> &p) const
     Number sum = 0;
     for (unsigned int i = 0; i < dim; i++)
     {
-        sum += values[i] * p(i);
+        sum += values[i] * p.values[i];
     }
     return sum;
 }
@@ -0,0 +1,101 @@
+#ifndef POLYMESH_READER_H
+#define POLYMESH_READER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "boundary_patch.h"
+#include "parallel.h"
+#include "point.h"
+
+namespace FVMCode
+{
+namespace Input
+{
+
+/**
+ * The contents of an OpenFOAM constant/polyMesh directory as flat arrays, as
+ * read from the files and before any mesh objects are built.
+ */
+struct PolyMeshData
+{
+    std::vector<Point<3> > points;
+    // The vertices of face f are face_vertices[face_offsets[f]] to
+    // face_vertices[face_offsets[f + 1] - 1]
+    std::vector<unsigned int>  face_offsets;
+    std::vector<unsigned int>  face_vertices;
+    std::vector<unsigned int>  owner;
+    std::vector<unsigned int>  neighbour;
+    std::vector<BoundaryPatch> boundaries;
+};
+
+/**
+ * Readers for the individual polyMesh files. Each takes the whole contents
+ * of a file in @p buffer, including the FoamFile header, and uses
+ * @p file_name only in error messages. They throw std::runtime_error for
+ * malformed input.
+ */
+void read_points (std::string_view buffer, const std::string &file_name,
+                  std::vector<Point<3> > &points);
+void read_faces (std::string_view buffer, const std::string &file_name,
+                 std::vector<unsigned int> &face_offsets,
+                 std::vector<unsigned int> &face_vertices);
+/**
+ * Reads an owner or neighbour file.
+ */
+void read_labels (std::string_view buffer, const std::string &file_name,
+                  std::vector<unsigned int> &labels);
+void read_boundaries (std::string_view buffer, const std::string &file_name,
+                      std::vector<BoundaryPatch> &boundaries);
+
+/**
+ * Builds the faces of each cell from the owner and neighbour lists, such
+ * that the faces of cell c are cell_faces[cell_offsets[c]] to
+ * cell_faces[cell_offsets[c + 1] - 1]: first the faces it owns, then the
+ * faces it neighbours, each in increasing order. The number of cells is one
+ * more than the largest label. Throws std::runtime_error if a label is not
+ * smaller than the total number of labels, as no mesh has more cells than
+ * that.
+ *
+ * This is a counting sort taking two passes over the labels. No memory is
+ * allocated other than by resizing the output vectors.
+ */
+void build_cell_faces (const std::vector<unsigned int> &owner,
+                       const std::vector<unsigned int> &neighbour,
+                       std::vector<unsigned int>       &cell_offsets,
+                       std::vector<unsigned int>       &cell_faces);
+
+/**
+ * Default value of the min_chunk_size argument of the chunked readers
+ */
+constexpr std::size_t default_min_chunk_size = 1 << 20;
+
+/**
+ * Chunked versions of the readers above for large files. The body of the
+ * list is split at line boundaries into one chunk per thread of @p pool,
+ * each chunk is read into a local buffer by its own thread, and the buffers
+ * are stitched together using a prefix sum of their entry counts. Chunks
+ * are at least @p min_chunk_size bytes, so small files are read serially.
+ *
+ * Splitting assumes that each entry of the list ends its line and that
+ * there are no comments inside the list, which holds for files written by
+ * OpenFOAM. If the chunks cannot be read, the file is read again serially,
+ * which also reports any error in the file with the right line number.
+ */
+void read_points (std::string_view buffer, const std::string &file_name,
+                  std::vector<Point<3> > &points, Parallel::ThreadPool &pool,
+                  const std::size_t min_chunk_size = default_min_chunk_size);
+void read_faces (std::string_view buffer, const std::string &file_name,
+                 std::vector<unsigned int> &face_offsets,
+                 std::vector<unsigned int> &face_vertices,
+                 Parallel::ThreadPool &pool,
+                 const std::size_t min_chunk_size = default_min_chunk_size);
+void read_labels (std::string_view buffer, const std::string &file_name,
+                  std::vector<unsigned int> &labels, Parallel::ThreadPool &pool,
+                  const std::size_t min_chunk_size = default_min_chunk_size);
+
+} // namespace Input
+} // namespace FVMCode
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef RENUMBERING_H
+#define RENUMBERING_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "point.h"
+
+namespace FVMCode
+{
+namespace Renumbering
+{
+
+/**
+ * Computes the reverse Cuthill-McKee ordering of the graph with
+ * @param n_nodes nodes and the undirected edges @param edges. Each connected
+ * component is traversed breadth first from a pseudo-peripheral node of
+ * minimum degree, visiting neighbours in order of increasing degree, and the
+ * resulting order is reversed.
+ *
+ * Returns the new-to-old permutation, i.e. entry i of the result is the
+ * original index of the node that is numbered i in the new ordering.
+ */
+std::vector<unsigned int> reverse_cuthill_mckee (
+    const unsigned int                                        n_nodes,
+    const std::vector<std::pair<unsigned int, unsigned int> > &edges);
+
+enum class SpaceFillingCurve
+{
+    morton,
+    hilbert
+};
+
+/**
+ * Position of the integer coordinates (@param x, @param y, @param z), each
+ * of which must be less than 2^21, along the Morton (Z-order) curve, which
+ * simply interleaves the bits of the coordinates.
+ */
+std::uint64_t morton_key (const std::uint32_t x, const std::uint32_t y,
+                          const std::uint32_t z);
+
+/**
+ * Position of the integer coordinates (@param x, @param y, @param z), each
+ * of which must be less than 2^21, along the 3D Hilbert curve. Unlike the
+ * Morton curve, consecutive positions along the Hilbert curve are always
+ * adjacent, which gives better locality.
+ */
+std::uint64_t hilbert_key (const std::uint32_t x, const std::uint32_t y,
+                           const std::uint32_t z);
+
+/**
+ * Orders @param points along the space filling curve @param curve, after
+ * scaling their bounding box onto a 2^21 x 2^21 x 2^21 grid. Returns the
+ * new-to-old permutation (see reverse_cuthill_mckee()).
+ */
+std::vector<unsigned int>
+space_filling_curve_order (const std::vector<Point<3> > &points,
+                           const SpaceFillingCurve       curve);
+
+/**
+ * Returns the inverse of the permutation @param permutation.
+ */
+std::vector<unsigned int>
+invert_permutation (const std::vector<unsigned int> &permutation);
+
+} // namespace Renumbering
+} // namespace FVMCode
+
+#endif
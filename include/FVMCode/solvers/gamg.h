@@ -0,0 +1,208 @@
+#ifndef GAMG_H
+#define GAMG_H
+
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_control.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+
+#include <vector>
+
+namespace FVMCode
+{
+
+/**
+ * Settings for the multigrid hierarchy of GAMG.
+ */
+struct GAMGOptions
+{
+    enum class Smoother
+    {
+        // A forward Gauss-Seidel sweep on the way down, and a backward sweep
+        // on the way up, which keeps the V-cycle symmetric
+        gauss_seidel,
+        // x += M^-1 (b - A x), with M the DIC factorisation of the level.
+        // Only for symmetric matrices.
+        dic
+    };
+
+    enum class Cycle
+    {
+        // One coarse level correction on each level
+        v,
+        // Two coarse level corrections on each level. Each pairing halves
+        // the number of cells, so with merge_levels = 2 a W-cycle costs
+        // about twice as much as a V-cycle, but its convergence depends
+        // far less on the number of levels.
+        w
+    };
+
+    Smoother smoother = Smoother::gauss_seidel;
+    Cycle    cycle    = Cycle::w;
+    // Smoothing sweeps on each level before and after the coarse level
+    // correction
+    unsigned int n_pre_sweeps  = 1;
+    unsigned int n_post_sweeps = 1;
+    // The number of rounds of pairing merged into one level, as OpenFOAM's
+    // mergeLevels, so each level has about 2^merge_levels times fewer cells
+    // than the one above
+    unsigned int merge_levels = 2;
+    // Levels are added until the coarsest has at most this many cells,
+    // which are then solved for directly. If coarsening stops before, at
+    // max_levels or because pairing no longer reduces the number of cells,
+    // the coarsest level is smoothed instead.
+    unsigned int max_coarsest_cells = 50;
+    unsigned int max_levels         = 50;
+    // Scale the coarse level correction on each level to minimise the
+    // energy norm of the error, as OpenFOAM does. Only used by SolverGAMG:
+    // the scaling makes the cycle nonlinear, so vmult() never applies it.
+    bool scale_correction = true;
+};
+
+/**
+ * An algebraic multigrid hierarchy in the style of OpenFOAM's GAMG. Each
+ * round of agglomeration merges cells in pairs, pairing each cell with the
+ * neighbour it is most strongly coupled to by the magnitude of the upper and
+ * lower coefficients of their face. Cells left without an unpaired neighbour
+ * join the agglomerate of their most strongly coupled neighbour. A coarse
+ * level is GAMGOptions::merge_levels rounds of pairing below the level above
+ * it. The coarse matrices are the Galerkin products R A P with
+ * piecewise constant P and R = P^T, so a coarse diagonal entry sums the
+ * diagonal entries and the coefficients of the faces inside its agglomerate,
+ * and a coarse face sums the coefficients of the faces between two
+ * agglomerates.
+ *
+ * The agglomeration and the coarse sparsity patterns only depend on the
+ * matrix the hierarchy is built from. For a sequence of matrices with the
+ * same pattern, as in a transient simulation on a fixed mesh, build the
+ * hierarchy once and call update() for each new matrix, which only
+ * recomputes the coarse coefficients and smoothers.
+ *
+ * As a Preconditioner, vmult() applies one cycle from a zero initial guess,
+ * which is symmetric if the matrix is, so the hierarchy can precondition
+ * SolverCG. The matrix must outlive the hierarchy.
+ */
+class GAMG : public Preconditioner
+{
+  public:
+    GAMG (const SparseMatrix &matrix,
+          const GAMGOptions  &options = GAMGOptions ());
+
+    /**
+     * Recomputes the coarse matrices and smoothers from @param matrix, which
+     * must have the same sparsity pattern as the matrix the hierarchy was
+     * built from, keeping the agglomeration.
+     */
+    void update (const SparseMatrix &matrix);
+
+    void vmult (const VectorXd &src, VectorXd &dst) const override;
+
+    /**
+     * Applies one cycle to @param rhs from a zero initial guess, with the
+     * correction scaling of GAMGOptions::scale_correction if
+     * @param scale_correction is true.
+     */
+    void apply_cycle (const VectorXd &rhs, VectorXd &x,
+                      const bool scale_correction) const;
+
+    /**
+     * Number of levels, including the original matrix.
+     */
+    unsigned int n_levels () const { return coarse_matrices.size () + 1; }
+    /**
+     * Number of cells on @param level, with level 0 the original matrix.
+     */
+    unsigned int n_cells (const unsigned int level) const;
+    /**
+     * The matrix of @param level.
+     */
+    const SparseMatrix &level_matrix (const unsigned int level) const;
+    /**
+     * The cell of level + 1 that each cell of @param level is part of.
+     */
+    const std::vector<unsigned int> &
+    coarse_cells (const unsigned int level) const;
+
+    const GAMGOptions options;
+
+  private:
+    // How level l is agglomerated into level l + 1
+    struct Agglomeration
+    {
+        // The coarse cell of each cell
+        std::vector<unsigned int> coarse_cell;
+        // The coarse arrow index of each arrow index, or invalid_face if the
+        // two cells of the face are in the same coarse cell
+        std::vector<unsigned int> coarse_face;
+        // Whether the coarse cell of the lower row of each arrow index has
+        // the higher index, so the upper and lower coefficients swap
+        std::vector<char> flipped;
+    };
+    static constexpr unsigned int invalid_face
+        = static_cast<unsigned int> (-1);
+
+    // Agglomerates the coarsest level into a new one, whose matrix has the
+    // coarse sparsity pattern but no values yet
+    void build_agglomeration (const SparseMatrix &matrix);
+    // Numbers the coarse faces of @p agglomeration from its coarse cells,
+    // and returns the (owner, neighbour) pairs of the coarse faces
+    static std::vector<std::pair<unsigned int, unsigned int> >
+    number_coarse_faces (const SparsityPattern &sp,
+                         const unsigned int     n_coarse,
+                         Agglomeration         &agglomeration);
+    // Sets @p coarse to the Galerkin product of @p fine
+    static void restrict_matrix (const SparseMatrix  &fine,
+                                 const Agglomeration &agglomeration,
+                                 SparseMatrix        &coarse);
+    // Sets up the smoothers, the direct solver of the coarsest level and the
+    // vectors of each level for the current matrices
+    void update_smoothers ();
+    void smooth (const unsigned int level, const VectorXd &rhs, VectorXd &x,
+                 const bool forward) const;
+    // A cycle for level_rhs[level] from level_x[level], or from zero if
+    // @p zero_start
+    void cycle (const unsigned int level, const bool zero_start,
+                const bool scale_correction) const;
+
+    const SparseMatrix                  *fine_matrix;
+    std::vector<Agglomeration>           agglomerations;
+    std::vector<SparseMatrix>            coarse_matrices;
+    std::vector<PreconditionerDIC>       dic_smoothers;
+    // Whether the coarsest level is small enough for coarsest_solver
+    bool                                 direct_coarsest;
+    Eigen::PartialPivLU<Eigen::MatrixXd> coarsest_solver;
+
+    // Right hand side, solution and work vectors of each level
+    mutable std::vector<VectorXd> level_rhs, level_x, level_residual,
+        level_work;
+};
+
+/**
+ * Solves with cycles of a GAMG hierarchy, each applied to the residual of
+ * the current solution.
+ */
+class SolverGAMG
+{
+  public:
+    SolverGAMG (const SolverControl &control = SolverControl ());
+
+    /**
+     * Solves @param matrix x = @param rhs, starting from the value of
+     * @param x on entry. @param gamg must have been built from, or updated
+     * with, @param matrix.
+     */
+    SolverResult solve (const SparseMatrix &matrix, VectorXd &x,
+                        const VectorXd &rhs, const GAMG &gamg) const;
+
+    SolverControl control;
+
+  private:
+    mutable VectorXd residual, correction;
+};
+
+} // namespace FVMCode
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef PRECONDITIONERS_H
+#define PRECONDITIONERS_H
+
+#include <vector>
+
+#include <FVMCode/sparsity/sparse_matrix.h>
+
+#include <Eigen/Core>
+
+namespace FVMCode
+{
+
+/**
+ * Approximates the inverse of a matrix for the iterative solvers.
+ */
+class Preconditioner
+{
+  public:
+    virtual ~Preconditioner () = default;
+
+    /**
+     * Sets @param dst to the approximate inverse applied to @param src.
+     */
+    virtual void vmult (const VectorXd &src, VectorXd &dst) const = 0;
+};
+
+/**
+ * No preconditioning.
+ */
+class PreconditionerIdentity : public Preconditioner
+{
+  public:
+    void vmult (const VectorXd &src, VectorXd &dst) const override
+    {
+        dst = src;
+    }
+};
+
+/**
+ * Divides by the diagonal of the matrix.
+ */
+class PreconditionerJacobi : public Preconditioner
+{
+  public:
+    PreconditionerJacobi (const SparseMatrix &matrix);
+
+    void vmult (const VectorXd &src, VectorXd &dst) const override;
+
+  private:
+    VectorXd inverse_diagonal;
+};
+
+/**
+ * Diagonal incomplete Cholesky factorisation of a symmetric matrix, as
+ * used by OpenFOAM: the preconditioner is (D + L) D^-1 (D + U), with L and
+ * U the strictly lower and upper triangles of the matrix and D the diagonal
+ * chosen such that the preconditioner has the diagonal of the matrix. Only D
+ * is stored; L and U are those of the matrix, which must therefore outlive
+ * the preconditioner and not change. Construction is a single sweep over
+ * the arrow indices in SparsityPattern::upper_triangular_order().
+ */
+class PreconditionerDIC : public Preconditioner
+{
+  public:
+    PreconditionerDIC (const SparseMatrix &matrix);
+
+    void vmult (const VectorXd &src, VectorXd &dst) const override;
+
+  private:
+    const SparseMatrix &matrix;
+    // The reciprocal of D
+    std::vector<double> reciprocal_diagonal;
+};
+
+/**
+ * Diagonal incomplete LU factorisation, the generalisation of DIC to
+ * matrices with an asymmetric off-diagonal part such as those of convection
+ * terms, as used by OpenFOAM: the preconditioner is (D + L) D^-1 (D + U),
+ * with D chosen such that it has the diagonal of the matrix. As for DIC, only
+ * D is stored, and the matrix must outlive the preconditioner and not
+ * change.
+ */
+class PreconditionerDILU : public Preconditioner
+{
+  public:
+    PreconditionerDILU (const SparseMatrix &matrix);
+
+    void vmult (const VectorXd &src, VectorXd &dst) const override;
+
+  private:
+    const SparseMatrix &matrix;
+    // The reciprocal of D
+    std::vector<double> reciprocal_diagonal;
+};
+
+} // namespace FVMCode
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef SOLVER_BICGSTAB_H
+#define SOLVER_BICGSTAB_H
+
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_control.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+
+#include <Eigen/Core>
+
+namespace FVMCode
+{
+
+/**
+ * The right preconditioned BiCGStab method for general, in particular
+ * non-symmetric, matrices. The vector updates of an iteration are fused
+ * with the inner products and norms that follow them, so an iteration
+ * makes five passes over the vectors besides the two matrix-vector products
+ * and the two applications of the preconditioner, where a direct
+ * implementation makes ten. The work vectors are kept between calls to
+ * solve().
+ */
+class SolverBiCGStab
+{
+  public:
+    SolverBiCGStab (const SolverControl &control = SolverControl ());
+
+    /**
+     * Solves @param matrix x = @param rhs, starting from the value of
+     * @param x on entry. The preconditioner defaults to the identity.
+     */
+    SolverResult solve (const SparseMatrix &matrix, VectorXd &x,
+                        const VectorXd &rhs) const;
+    SolverResult solve (const SparseMatrix &matrix, VectorXd &x,
+                        const VectorXd       &rhs,
+                        const Preconditioner &preconditioner) const;
+
+    SolverControl control;
+
+  private:
+    mutable VectorXd residual, shadow_residual, direction, v, s, t,
+        preconditioned_direction, preconditioned_s;
+};
+
+} // namespace FVMCode
+
+#endif
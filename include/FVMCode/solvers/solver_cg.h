@@ -0,0 +1,42 @@
+#ifndef SOLVER_CG_H
+#define SOLVER_CG_H
+
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_control.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+
+#include <Eigen/Core>
+
+namespace FVMCode
+{
+
+/**
+ * The preconditioned conjugate gradient method for symmetric positive
+ * definite matrices. The work vectors are kept between calls to solve(), so
+ * a solver reused for a sequence of systems of the same size does not
+ * allocate.
+ */
+class SolverCG
+{
+  public:
+    SolverCG (const SolverControl &control = SolverControl ());
+
+    /**
+     * Solves @param matrix x = @param rhs, starting from the value of
+     * @param x on entry. The preconditioner defaults to the identity.
+     */
+    SolverResult solve (const SparseMatrix &matrix, VectorXd &x,
+                        const VectorXd &rhs) const;
+    SolverResult solve (const SparseMatrix &matrix, VectorXd &x,
+                        const VectorXd       &rhs,
+                        const Preconditioner &preconditioner) const;
+
+    SolverControl control;
+
+  private:
+    mutable VectorXd residual, direction, preconditioned, product;
+};
+
+} // namespace FVMCode
+
+#endif
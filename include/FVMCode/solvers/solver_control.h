@@ -0,0 +1,34 @@
+#ifndef SOLVER_CONTROL_H
+#define SOLVER_CONTROL_H
+
+namespace FVMCode
+{
+
+/**
+ * When an iterative solver stops. The residual is the 2-norm of b - A x. A
+ * solver stops once the residual is at most @p tolerance, or at most
+ * @p relative_tolerance times the residual of the initial guess, or after
+ * @p max_iterations iterations.
+ */
+struct SolverControl
+{
+    unsigned int max_iterations     = 1000;
+    double       tolerance          = 1e-10;
+    double       relative_tolerance = 0.;
+};
+
+/**
+ * What an iterative solver did. Not converging within the maximum number of
+ * iterations is not an error, so callers should check @p converged.
+ */
+struct SolverResult
+{
+    unsigned int iterations       = 0;
+    double       initial_residual = 0.;
+    double       final_residual   = 0.;
+    bool         converged        = false;
+};
+
+} // namespace FVMCode
+
+#endif
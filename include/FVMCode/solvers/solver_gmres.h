@@ -0,0 +1,50 @@
+#ifndef SOLVER_GMRES_H
+#define SOLVER_GMRES_H
+
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_control.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+
+#include <Eigen/Core>
+
+#include <vector>
+
+namespace FVMCode
+{
+
+/**
+ * The right preconditioned GMRES method for general matrices, restarted
+ * after @p restart iterations to bound the memory for the Krylov basis at
+ * restart + 1 vectors. The orthogonalisation is modified Gram-Schmidt with
+ * the subtraction of each basis vector fused with the inner product with the
+ * next, so orthogonalising against k vectors takes k + 1 passes rather than
+ * 2k + 1. Within a cycle, the residual is the estimate from the Givens
+ * rotations; it is computed exactly at every restart and at the end.
+ */
+class SolverGMRES
+{
+  public:
+    SolverGMRES (const SolverControl &control = SolverControl (),
+                 const unsigned int   restart = 30);
+
+    /**
+     * Solves @param matrix x = @param rhs, starting from the value of
+     * @param x on entry. The preconditioner defaults to the identity.
+     */
+    SolverResult solve (const SparseMatrix &matrix, VectorXd &x,
+                        const VectorXd &rhs) const;
+    SolverResult solve (const SparseMatrix &matrix, VectorXd &x,
+                        const VectorXd       &rhs,
+                        const Preconditioner &preconditioner) const;
+
+    SolverControl control;
+    unsigned int  restart;
+
+  private:
+    mutable std::vector<VectorXd> basis;
+    mutable VectorXd              residual, preconditioned, update;
+};
+
+} // namespace FVMCode
+
+#endif
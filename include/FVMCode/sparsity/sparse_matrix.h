@@ -2,9 +2,12 @@
 #define SPARSE_MATRIX_H
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 using Eigen::VectorXd;
 
+#include <FVMCode/face_colouring.h>
+#include <FVMCode/parallel.h>
 #include <FVMCode/sparsity/sparsity_pattern.h>
 
 namespace FVMCode
@@ -39,7 +42,72 @@ class SparseMatrix
      * Adds result of matrix * @param src to @param dst.
      */
     void vmult_add (const VectorXd &src, VectorXd &dst) const;
+    /**
+     * As vmult(), but multithreaded over the threads of @param pool.
+     * @param colouring must colour the internal faces of the mesh the
+     * sparsity pattern was built from.
+     */
+    void vmult (const VectorXd &src, VectorXd &dst,
+                const FaceColouring &colouring,
+                Parallel::ThreadPool &pool) const;
+    /**
+     * As vmult_add(), but multithreaded over the threads of @param pool.
+     * The off-diagonal entries are processed one face colour at a time so
+     * that no two threads write to the same row of @param dst.
+     */
+    void vmult_add (const VectorXd &src, VectorXd &dst,
+                    const FaceColouring &colouring,
+                    Parallel::ThreadPool &pool) const;
+
+    /**
+     * Sets all entries to zero, keeping the sparsity pattern, e.g. before
+     * assembling the system of the next timestep.
+     */
+    void set_zero ();
+
+    /**
+     * Copies the matrix into @param matrix, for use with Eigen's sparse
+     * solvers.
+     */
+    void copy_to (Eigen::SparseMatrix<double> &matrix) const;
+
+    /**
+     * Adds @param upper to the entry in the row of the owner and the column
+     * of the neighbour of internal face @param face, and @param lower to the
+     * entry in the row of the neighbour and the column of the owner. Unlike
+     * operator(), this needs no lookup, so face-based assembly costs O(1)
+     * per coefficient.
+     */
+    void add_face (const unsigned int face, const double upper,
+                   const double lower);
+    /**
+     * Adds @param value to the diagonal entry of row @param cell.
+     */
+    void add_diag (const unsigned int cell, const double value);
 
+    const SparsityPattern &get_sparsity_pattern () const { return sp; }
+    /**
+     * The stored values, for solvers and preconditioners that work on the
+     * arrow storage directly: the diagonal by row, and the upper and lower
+     * triangles by arrow index, such that upper_values()[index] is entry
+     * (i, j) and lower_values()[index] is entry (j, i) for (i, j) =
+     * SparsityPattern::ij_from_arrow_index(index).
+     */
+    const std::vector<double> &diagonal_values () const { return diagonal; }
+    const std::vector<double> &upper_values () const
+    {
+        return upper_triangular;
+    }
+    const std::vector<double> &lower_values () const
+    {
+        return lower_triangular;
+    }
+
+    /**
+     * Entry (i, j). Off-diagonal entries are found with
+     * SparsityPattern::arrow_index_from_ij(); prefer add_face() and
+     * add_diag() for assembly.
+     */
     const double &operator() (const unsigned int i,
                               const unsigned int j) const;
     double       &operator() (const unsigned int i, const unsigned int j);
@@ -54,4 +122,36 @@ class SparseMatrix
 
 } // namespace FVMCode
 
+// ==========================
+//     Implementations
+// ==========================
+
+namespace FVMCode
+{
+
+inline void SparseMatrix::add_face (const unsigned int face,
+                                    const double upper, const double lower)
+{
+    AssertIndexRange (face, upper_triangular.size ());
+    if (sp.owner_is_higher (face))
+    {
+        upper_triangular[face] += lower;
+        lower_triangular[face] += upper;
+    }
+    else
+    {
+        upper_triangular[face] += upper;
+        lower_triangular[face] += lower;
+    }
+}
+
+inline void SparseMatrix::add_diag (const unsigned int cell,
+                                    const double       value)
+{
+    AssertIndexRange (cell, diagonal.size ());
+    diagonal[cell] += value;
+}
+
+} // namespace FVMCode
+
 #endif
\ No newline at end of file
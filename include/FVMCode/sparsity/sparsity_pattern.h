@@ -11,11 +11,35 @@ namespace FVMCode
 
 /**
  * Provides addressing for SparseMatrix
+ *
+ * The off-diagonal entries are numbered by the internal faces of the mesh:
+ * arrow index f is the pair of entries coupling the owner and neighbour of
+ * internal face f. Face-based assembly can therefore address them directly
+ * (see SparseMatrix::add_face()), and only lookups by row and column need
+ * arrow_index_from_ij().
  */
 class SparsityPattern
 {
   public:
-    SparsityPattern (UnstructuredMesh &mesh);
+    /**
+     * Builds the pattern of the internal faces of @param mesh. If
+     * @param build_debug_index is true, arrow_index_from_ij() is also
+     * checked against a std::map of all pairs, which costs O(log N) per
+     * lookup and a heap allocation per face.
+     */
+    SparsityPattern (UnstructuredMesh &mesh,
+                     const bool        build_debug_index = false);
+    /**
+     * Builds the pattern of @param n_eqns equations coupled by the pairs of
+     * @param faces, which take the place of the (owner, neighbour) pairs of
+     * internal faces: arrow index f couples the two equations of faces[f].
+     * For matrices that do not come from a mesh, such as the coarse levels
+     * of a multigrid hierarchy. Each pair must appear only once.
+     */
+    SparsityPattern (
+        const unsigned int                                         n_eqns,
+        const std::vector<std::pair<unsigned int, unsigned int> > &faces,
+        const bool build_debug_index = false);
 
     /**
      * Number of rows/columns/equations.
@@ -43,7 +67,9 @@ class SparsityPattern
     void print_gnuplot (std::ofstream &out) const;
 
     /**
-     * Requires i < j.
+     * Requires i < j. Searches the entries of row i, so costs O(log m) for
+     * m entries in the row. Throws std::out_of_range if (i, j) is not in
+     * the pattern.
      */
     unsigned int arrow_index_from_ij (const unsigned int i,
                                       const unsigned int j) const;
@@ -51,12 +77,59 @@ class SparsityPattern
      * Always gives i < j (i.e. in upper triangle)
      */
     std::pair<unsigned int, unsigned int>
-    ij_from_arrow_index (const unsigned int arrow_index) const;
+    ij_from_arrow_index (const unsigned int arrow_index) const
+    {
+        return ij_indices[arrow_index];
+    }
+
+    /**
+     * Whether the owner of the face of @param arrow_index has a higher index
+     * than its neighbour, i.e. the owner row of the face is in the lower
+     * triangle.
+     */
+    bool owner_is_higher (const unsigned int arrow_index) const
+    {
+        AssertIndexRange (arrow_index, owner_higher.size ());
+        return owner_higher[arrow_index];
+    }
+
+    /**
+     * The arrow indices sorted by the row and then the column of their
+     * entry in the upper triangle, as needed by sweeps such as incomplete
+     * factorisations, in which an entry of a row depends on the rows before
+     * it.
+     */
+    const std::vector<unsigned int> &upper_triangular_order () const
+    {
+        return row_entries;
+    }
+    /**
+     * The entries of row i of the upper triangle are upper_triangular_order()
+     * from upper_triangular_row_start()[i] up to, but not including,
+     * upper_triangular_row_start()[i + 1].
+     */
+    const std::vector<unsigned int> &upper_triangular_row_start () const
+    {
+        return row_start;
+    }
 
   private:
+    // Adds the pair of face f to ij_indices and owner_higher
+    void add_face (const unsigned int owner, const unsigned int neighbour);
+    // Builds row_start and row_entries, and reverse_lookup if requested,
+    // from ij_indices
+    void build_row_index (const bool build_debug_index);
+
     unsigned int n;
     // Only stores i,j pairs where i < j (i.e. in the upper triangle)
     std::vector<std::pair<unsigned int, unsigned int> > ij_indices;
+    std::vector<char>                                   owner_higher;
+    // The arrow indices of the entries of row i of the upper triangle are
+    // row_entries[row_start[i]] to row_entries[row_start[i + 1] - 1], sorted
+    // by column
+    std::vector<unsigned int> row_start;
+    std::vector<unsigned int> row_entries;
+    // Only built if requested, to check row_entries
     std::map<std::pair<unsigned int, unsigned int>, unsigned int>
         reverse_lookup;
 };
@@ -0,0 +1,170 @@
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <FVMCode/boundary_patch.h>
+#include <FVMCode/exceptions.h>
+#include <FVMCode/mapped_file.h>
+#include <FVMCode/output.h>
+
+#include <Eigen/Core>
+
+namespace FVMCode
+{
+
+/**
+ * A time series file holds the values of one field at many output times, as
+ * an alternative to writing a time directory per output time with
+ * Outputter, which creates several files per output.
+ *
+ * The file starts with a fixed size header, followed by one frame per
+ * output time, each a small frame header (time and timestep number) and
+ * the raw values of the field, and ends with an index of all frames. Frames
+ * are only ever appended; the index is written when the file is closed. If
+ * a run ends without closing the file, the frames are still found by
+ * TimeSeriesReader, which then rebuilds the index from the frame headers.
+ */
+namespace TimeSeries
+{
+struct Header
+{
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t n_values;
+    std::uint64_t n_frames;
+    // Zero if the file has not been closed
+    std::uint64_t index_offset;
+    char          field_name[88];
+};
+
+struct FrameHeader
+{
+    double        time;
+    std::uint64_t timestep_number;
+};
+
+struct IndexEntry
+{
+    double        time;
+    std::uint64_t timestep_number;
+    // Offset in bytes of the values of the frame from the start of the file
+    std::uint64_t offset;
+};
+} // namespace TimeSeries
+
+/**
+ * Appends frames to a time series file.
+ */
+class TimeSeriesWriter
+{
+  public:
+    /**
+     * Creates @param filename for frames of @param n_values values of
+     * @param field_name. If @param append is true and the file exists, the
+     * new frames are appended to it instead, e.g. when a run is resumed. The
+     * file must then hold the same field with the same number of values.
+     * Throws std::runtime_error if the file cannot be opened.
+     */
+    TimeSeriesWriter (const std::string &filename,
+                      const std::string &field_name,
+                      const unsigned int n_values, const bool append = false);
+    /**
+     * Closes the file if close() has not been called.
+     */
+    ~TimeSeriesWriter ();
+
+    TimeSeriesWriter (const TimeSeriesWriter &)            = delete;
+    TimeSeriesWriter &operator= (const TimeSeriesWriter &) = delete;
+
+    /**
+     * Appends the frame of @param time with a single write.
+     */
+    void append (const unsigned int timestep_number, const double time,
+                 const Eigen::VectorXd &values);
+
+    /**
+     * Writes the index and completes the header. No frames can be appended
+     * afterwards.
+     */
+    void close ();
+
+    unsigned int n_frames () const { return index.size (); }
+
+  private:
+    std::fstream                        file;
+    TimeSeries::Header                  header;
+    std::vector<TimeSeries::IndexEntry> index;
+    // Offset of the end of the last frame
+    std::uint64_t end_of_frames;
+};
+
+/**
+ * Read access to a time series file through a memory mapping, so that a
+ * frame is only read from disk when its values are accessed.
+ */
+class TimeSeriesReader
+{
+  public:
+    /**
+     * Opens @param filename. Throws std::runtime_error if it is not a time
+     * series file.
+     */
+    explicit TimeSeriesReader (const std::string &filename);
+
+    const std::string &field_name () const { return field_name_; }
+    unsigned int       n_values () const { return n_values_; }
+    unsigned int       n_frames () const { return index.size (); }
+
+    double time (const unsigned int frame) const
+    {
+        AssertIndexRange (frame, index.size ());
+        return index[frame].time;
+    }
+    unsigned int timestep_number (const unsigned int frame) const
+    {
+        AssertIndexRange (frame, index.size ());
+        return index[frame].timestep_number;
+    }
+
+    /**
+     * The values of @param frame, pointing into the mapped file, which
+     * must outlive them.
+     */
+    Eigen::Map<const Eigen::VectorXd> values (const unsigned int frame) const
+    {
+        AssertIndexRange (frame, index.size ());
+        return Eigen::Map<const Eigen::VectorXd> (
+            reinterpret_cast<const double *> (file.data ()
+                                              + index[frame].offset),
+            n_values_);
+    }
+
+  private:
+    Input::MappedFile                   file;
+    std::string                         field_name_;
+    unsigned int                        n_values_;
+    std::vector<TimeSeries::IndexEntry> index;
+};
+
+/**
+ * Writes each frame of @p time_series as a time directory with Outputter,
+ * for OpenFOAM or ParaView. As Outputter does, the directories are
+ * created in the working directory, and @p boundary_conditions and
+ * @p original_cell_index are passed to Outputter::write_scalar_field(). The
+ * time step of a frame is taken as the difference to the previous frame.
+ */
+void write_time_directories (
+    const TimeSeriesReader &time_series,
+    const BoundaryConditions &boundary_conditions,
+    const Outputter::Format format = Outputter::Format::ascii,
+    const std::vector<unsigned int> &original_cell_index
+    = std::vector<unsigned int> ());
+
+} // namespace FVMCode
+
+#endif
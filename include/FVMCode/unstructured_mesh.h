@@ -2,12 +2,16 @@
 #define UNSTRUCTURED_MESH_H
 
 #include <iterator>
+#include <memory>
 #include <vector>
 
 #include "boundary_patch.h"
+#include "cell_search_tree.h"
 #include "file_parser_forward.h"
 #include "mesh_components.h"
+#include "parallel.h"
 #include "point.h"
+#include "renumbering.h"
 
 namespace FVMCode
 {
@@ -39,15 +43,116 @@ class UnstructuredMesh
     CellIterator  get_cell (unsigned int index);
     FaceIterator  get_face (unsigned int index);
 
+    /**
+     * Builds a bounding volume hierarchy over the cells, after which
+     * get_cell_containing_point() and get_cells_containing_points() cost
+     * O(log N) per point rather than O(N). Without it they scan every cell.
+     */
+    void build_search_tree ();
+    bool has_search_tree () const { return search_tree != nullptr; }
+
+    /**
+     * Finds the cell containing @param point. Throws std::out_of_range if
+     * the point lies outside the mesh.
+     */
     unsigned int get_cell_containing_point (const Point<3> &point);
+    /**
+     * Finds the cell containing @param point by walking from @param
+     * hint_cell: at each step it moves to the neighbour across the face of
+     * the current cell that the point lies furthest beyond, and stops once
+     * the point lies behind all faces. If the walk reaches a boundary face it
+     * falls back to a full search (using the search tree if one was built).
+     * For coherent query streams, such as points sampled along a line or
+     * probes that move a little between timesteps, passing the previous
+     * result as the hint makes each query close to O(1). Throws
+     * std::out_of_range if the point lies outside the mesh.
+     */
+    unsigned int get_cell_containing_point (const Point<3>    &point,
+                                            const unsigned int hint_cell);
+    /**
+     * Finds the cell containing each of @param points, splitting the points
+     * between @param n_threads threads. Points outside the mesh are given
+     * the index CellSearchTree::invalid_cell.
+     */
+    std::vector<unsigned int>
+    get_cells_containing_points (const std::vector<Point<3> > &points,
+                                 const unsigned int             n_threads
+                                 = Parallel::default_n_threads ());
+
+    /**
+     * Maximum difference between the owner and neighbour indices of the
+     * internal faces, i.e. the band of the matrix of a face-based
+     * discretisation on this mesh.
+     */
+    unsigned int matrix_band () const;
+
+    struct RenumberingReport
+    {
+        unsigned int band_before;
+        unsigned int band_after;
+    };
+
+    /**
+     * Renumbers the cells using the reverse Cuthill-McKee algorithm on the
+     * cell adjacency graph, to reduce the matrix band and improve cache
+     * locality of face loops. Owner and neighbour indices are rewritten and
+     * internal faces are reordered so that they remain sorted by owner and
+     * then neighbour (upper triangular order), with the owner always the
+     * lower index. Boundary faces keep their positions, so boundary patches
+     * are unaffected. Requires internal faces to be numbered before boundary
+     * faces. Returns the matrix band before and after renumbering.
+     */
+    RenumberingReport renumber_cells_rcm ();
+
+    /**
+     * Orders the cells along a space filling curve through their centroids,
+     * and the points along the same curve through their coordinates. Faces
+     * are reordered as in renumber_cells_rcm(), which puts the internal
+     * faces in the order of the curve too. This improves cache reuse in
+     * geometry computations and face loops on large meshes. Returns the
+     * matrix band before and after renumbering.
+     */
+    RenumberingReport
+    renumber_space_filling_curve (const Renumbering::SpaceFillingCurve curve
+                                  = Renumbering::SpaceFillingCurve::hilbert);
+
+    /**
+     * Index each cell had when the mesh was read, such that cell c of the
+     * renumbered mesh was cell original_cell_indices()[c] of the mesh on
+     * disk. Empty if the cells have never been renumbered. Pass this to
+     * Outputter::write_scalar_field() to write fields in the original order.
+     */
+    const std::vector<unsigned int> &original_cell_indices () const
+    {
+        return original_cell_index;
+    }
 
     friend UnstructuredMeshParser;
 
   private:
+    /**
+     * Applies the cell renumbering @param new_to_old (see
+     * original_cell_indices() for the convention) as described in
+     * renumber_cells_rcm().
+     */
+    void renumber_cells (const std::vector<unsigned int> &new_to_old);
+    /**
+     * Moves the points into the order @param new_to_old and updates the
+     * faces' vertex iterators.
+     */
+    void renumber_points (const std::vector<unsigned int> &new_to_old);
+
+    // Returns CellSearchTree::invalid_cell if the point lies outside the mesh
+    unsigned int find_cell (const Point<3> &point) const;
+
     PointList                  point_list;
     CellList                   cell_list;
     FaceList                   face_list;
     std::vector<BoundaryPatch> boundaries;
+
+    std::shared_ptr<const CellSearchTree> search_tree;
+
+    std::vector<unsigned int> original_cell_index;
 };
 
 } // namespace FVMCode
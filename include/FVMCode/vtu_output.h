@@ -0,0 +1,100 @@
+#ifndef VTU_OUTPUT_H
+#define VTU_OUTPUT_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <FVMCode/unstructured_mesh.h>
+
+#include <Eigen/Core>
+
+namespace FVMCode
+{
+
+/**
+ * Writes cell fields as VTK XML unstructured grid (.vtu) files that ParaView
+ * reads directly, without converting the time directories written by
+ * Outputter, together with a .pvd collection listing them by time.
+ *
+ * Hexahedral cells are written as VTK hexahedra, and all other cells as VTK
+ * polyhedra built from their faces, with the vertices of the faces the cell
+ * does not own reversed so that all face normals point out of the cell.
+ * All arrays are stored in appended raw binary, with 32 bit labels unless
+ * the mesh is too large for them.
+ *
+ * The points and cells are encoded once, when the writer is constructed;
+ * each output copies that block into its file and adds the fields after
+ * it. A .vtu file cannot refer to the geometry of another file, so each one
+ * still holds the full mesh, which for hexahedral meshes is most of the
+ * file: a .vtu output is several times the size of the ASCII time directory
+ * of the same field (see benchmarks/vtu_output). The writer is meant for
+ * viewing, not for the output of every timestep of long runs, for which
+ * AsyncOutputter::Backend::time_series stores only the fields.
+ *
+ * The fields are written in the order of the cells of @p mesh, so fields of
+ * a renumbered mesh need no reordering.
+ */
+class VTUWriter
+{
+  public:
+    using Fields
+        = std::vector<std::pair<std::string, const Eigen::VectorXd *> >;
+
+    /**
+     * Encodes the geometry of @param mesh, for files written to
+     * @param directory, named after @param base_name, which is created if
+     * necessary. If @param append is true and the collection
+     * <base_name>.pvd exists, the outputs it lists are kept, e.g. when a run
+     * is resumed; outputs at or after the time of the first new one are
+     * dropped from it.
+     */
+    VTUWriter (UnstructuredMesh &mesh, const std::string &directory,
+               const std::string &base_name, const bool append = false);
+
+    /**
+     * Writes @param fields, given as pairs of name and field, for @param
+     * time to the file <base_name>_<n>.vtu, where n counts the outputs, and
+     * adds it to the collection. The collection is rewritten after every
+     * output, so it is complete even if a run ends early. Throws
+     * std::runtime_error if a file cannot be written.
+     */
+    void write_scalar_fields (const double time, const Fields &fields);
+    /**
+     * Writes the single field @param scalar_field called @param name, as
+     * write_scalar_fields() does.
+     */
+    void write_scalar_field (const double time,
+                             const Eigen::VectorXd &scalar_field,
+                             const std::string     &name);
+
+    /**
+     * Number of outputs listed in the collection.
+     */
+    unsigned int n_outputs () const { return outputs.size (); }
+
+    /**
+     * Size in bytes of the encoded geometry written to every file.
+     */
+    std::size_t geometry_size () const { return geometry_data.size (); }
+
+  private:
+    void write_collection () const;
+
+    const std::string directory;
+    const std::string base_name;
+    const unsigned int n_cells;
+
+    // The <Piece> element up to and excluding <CellData>, and the <Points>
+    // and <Cells> elements, whose offsets are into geometry_data
+    std::string       piece_xml;
+    std::string       geometry_xml;
+    std::vector<char> geometry_data;
+
+    // Time and file name of each output
+    std::vector<std::pair<double, std::string> > outputs;
+};
+
+} // namespace FVMCode
+
+#endif
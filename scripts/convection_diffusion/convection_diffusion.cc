@@ -1,8 +1,11 @@
+#include <FVMCode/async_output.h>
 #include <FVMCode/boundary_patch.h>
 #include <FVMCode/exceptions.h>
+#include <FVMCode/field_reader.h>
 #include <FVMCode/file_parser.h>
 #include <FVMCode/output.h>
 #include <FVMCode/unstructured_mesh.h>
+#include <FVMCode/vtu_output.h>
 
 #include <Eigen/Dense>
 
@@ -11,13 +14,11 @@ using Eigen::Vector3d;
 using Eigen::VectorXd;
 
 using namespace FVMCode;
-using BoundaryConditions
-    = std::vector<std::pair<BoundaryPatch, BoundaryFieldEntry> >;
 
-void output (const VectorXd &temperature, const BoundaryConditions &bcs,
-             double &next_output_time, const unsigned int &timestep_number,
-             const double &time, const double &dt,
-             const double &output_time_interval);
+void output (AsyncOutputter &outputter, const VectorXd &temperature,
+             const BoundaryConditions &bcs, double &next_output_time,
+             const unsigned int &timestep_number, const double &time,
+             const double &dt, const double &output_time_interval);
 
 void construct_temporal_term (MatrixXd &system_matrix, VectorXd &system_rhs,
                               UnstructuredMesh &mesh,
@@ -49,8 +50,13 @@ void construct_convection_term_BCs (MatrixXd                 &system_matrix,
                                     const BoundaryConditions &bcs,
                                     const Point<3, double>   &velocity);
 
-int main ()
+// Usage: convection_diffusion [--resume]
+// With --resume, the run continues from the latest time directory holding
+// T, if there is one.
+int main (int argc, char **argv)
 {
+    const bool resume = argc > 1 && std::string (argv[1]) == "--resume";
+
     UnstructuredMesh mesh;
     {
         UnstructuredMeshParser parser (mesh);
@@ -104,13 +110,33 @@ int main ()
 
     std::cout << "System setup" << std::endl;
 
-    // First output
-    unsigned int timestep_number  = 0;
-    double       next_output_time = time;
-    output (temperature, bc, next_output_time, timestep_number, time, dt,
-            output_time_interval);
+    // For viewing in ParaView, with VTK/convection_diffusion.pvd. Written
+    // by the outputter, in the background.
+    VTUWriter      vtu_writer (mesh, "VTK", "convection_diffusion", resume);
+    AsyncOutputter outputter (1, Outputter::Format::ascii, &vtu_writer);
+    unsigned int   timestep_number  = 0;
+    double         next_output_time = time;
+    const std::optional<Input::TimeDirectory> latest
+        = resume ? Input::find_latest_time (".", "T") : std::nullopt;
+    if (latest)
+    {
+        // Restart from the latest output. The boundary conditions are
+        // those written with it.
+        Input::read_scalar_field (latest->path + "/T", mesh.n_cells (),
+                                  mesh.get_patches (), temperature, bc);
+        time             = latest->time;
+        timestep_number  = latest->index;
+        next_output_time = time + output_time_interval;
+        std::cout << "Resuming from t = " << time << std::endl;
+    }
+    else
+    {
+        // First output
+        output (outputter, temperature, bc, next_output_time, timestep_number,
+                time, dt, output_time_interval);
 
-    std::cout << "First output complete" << std::endl;
+        std::cout << "First output queued" << std::endl;
+    }
 
     while (time < end_time)
     {
@@ -138,16 +164,20 @@ int main ()
         // solve system
         temperature = system_matrix.colPivHouseholderQr ().solve (system_rhs);
         std::cout << "\tSystem solved" << std::endl;
-        output (temperature, bc, next_output_time, timestep_number, time, dt,
-                output_time_interval);
-        std::cout << "\tOutput complete" << std::endl;
+        output (outputter, temperature, bc, next_output_time, timestep_number,
+                time, dt, output_time_interval);
+        std::cout << "\tOutput queued" << std::endl;
     }
+
+    outputter.flush ();
+    std::cout << "Waited " << outputter.blocked_time ()
+              << " s for output to be written" << std::endl;
 }
 
-void output (const VectorXd &temperature, const BoundaryConditions &bcs,
-             double &next_output_time, const unsigned int &timestep_number,
-             const double &time, const double &dt,
-             const double &output_time_interval)
+void output (AsyncOutputter &outputter, const VectorXd &temperature,
+             const BoundaryConditions &bcs, double &next_output_time,
+             const unsigned int &timestep_number, const double &time,
+             const double &dt, const double &output_time_interval)
 {
     if (time >= next_output_time - 1e-12)
     {
@@ -155,9 +185,10 @@ void output (const VectorXd &temperature, const BoundaryConditions &bcs,
         next_output_time = time + output_time_interval;
         std::cout << "\tNext output time = " << next_output_time << std::endl;
 
-        Outputter outputter (timestep_number, time, dt, dt);
-        outputter.write_time ();
-        outputter.write_scalar_field (temperature, "T", bcs);
+        // Written in the background while the next timesteps are computed,
+        // together with the VTU file
+        outputter.write_scalar_field (timestep_number, time, dt, dt,
+                                      temperature, "T", bcs);
     }
 }
 
@@ -0,0 +1,134 @@
+#include <FVMCode/async_output.h>
+#include <FVMCode/boundary_patch.h>
+#include <FVMCode/exceptions.h>
+#include <FVMCode/field_reader.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/operators.h>
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_bicgstab.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+#include <FVMCode/vtu_output.h>
+
+using Eigen::VectorXd;
+
+using namespace FVMCode;
+
+// The convection_diffusion case, assembled with the operators of the library
+// into a SparseMatrix and solved with BiCGStab with a DILU preconditioner,
+// starting from the previous timestep, so that memory grows linearly with
+// the number of cells rather than quadratically.
+//
+// Usage: convection_diffusion_sparse [--resume]
+// With --resume, the run continues from the latest time directory holding
+// T, if there is one.
+int main (int argc, char **argv)
+{
+    const bool resume = argc > 1 && std::string (argv[1]) == "--resume";
+
+    UnstructuredMesh mesh;
+    {
+        UnstructuredMeshParser parser (mesh);
+    }
+
+    std::cout << "Mesh parsed" << std::endl;
+
+    // BCs
+    BoundaryConditions bc;
+    for (const BoundaryPatch &patch : mesh.get_patches ())
+    {
+        if (patch.type == empty)
+            bc.emplace_back (patch, BoundaryFieldEntry ("empty", 0));
+        else if (patch.name == "leftWall")
+            bc.emplace_back (patch, BoundaryFieldEntry ("fixedValue", 0));
+        else
+            bc.emplace_back (patch, BoundaryFieldEntry ("zeroGradient", 0));
+    }
+
+    std::cout << "BCs constructed" << std::endl;
+
+    // Setup
+    const SparsityPattern sp (mesh);
+    SparseMatrix          system_matrix (sp);
+    VectorXd              system_rhs (mesh.n_cells ());
+    VectorXd              temperature = VectorXd::Zero (mesh.n_cells ());
+
+    const double   dt                   = 0.05;
+    const double   output_time_interval = 0.05;
+    const double   diffusion_const      = 0.01;
+    const double   source_strength      = 1.;
+    const Point<3> source_location (0.5, 0., 0.);
+    const Point<3> velocity (1., 0., 0.);
+
+    const unsigned int source_cell_index
+        = mesh.get_cell_containing_point (source_location);
+
+    double       time     = 0;
+    const double end_time = 1.;
+
+    SolverControl control;
+    control.tolerance          = 1e-12;
+    control.relative_tolerance = 1e-8;
+    const SolverBiCGStab solver (control);
+
+    std::cout << "System setup" << std::endl;
+
+    VTUWriter      vtu_writer (mesh, "VTK", "convection_diffusion", resume);
+    AsyncOutputter outputter (1, Outputter::Format::ascii, &vtu_writer);
+    unsigned int   timestep_number  = 0;
+    double         next_output_time = time;
+    auto           output           = [&] () {
+        if (time < next_output_time - 1e-12)
+            return;
+        next_output_time = time + output_time_interval;
+        outputter.write_scalar_field (timestep_number, time, dt, dt,
+                                      temperature, "T", bc);
+    };
+
+    const std::optional<Input::TimeDirectory> latest
+        = resume ? Input::find_latest_time (".", "T") : std::nullopt;
+    if (latest)
+    {
+        // Restart from the latest output. The boundary conditions are
+        // those written with it.
+        Input::read_scalar_field (latest->path + "/T", mesh.n_cells (),
+                                  mesh.get_patches (), temperature, bc);
+        time             = latest->time;
+        timestep_number  = latest->index;
+        next_output_time = time + output_time_interval;
+        std::cout << "Resuming from t = " << time << std::endl;
+    }
+    else
+        output ();
+
+    while (time < end_time)
+    {
+        time += dt;
+        timestep_number++;
+        std::cout << "Timestep " << timestep_number << ", t = " << time
+                  << std::endl;
+
+        system_matrix.set_zero ();
+        system_rhs.setZero ();
+        Operators::ddt (system_matrix, system_rhs, mesh, temperature, dt);
+        Operators::source (system_rhs, mesh, source_cell_index,
+                           source_strength);
+        Operators::laplacian (system_matrix, system_rhs, mesh, bc,
+                              diffusion_const);
+        Operators::div (system_matrix, system_rhs, mesh, bc, velocity,
+                        Operators::ConvectionScheme::upwind);
+
+        const PreconditionerDILU preconditioner (system_matrix);
+        const SolverResult       result = solver.solve (
+            system_matrix, temperature, system_rhs, preconditioner);
+        AssertThrow (result.converged,
+                     std::runtime_error ("BiCGStab did not converge"));
+
+        output ();
+    }
+
+    outputter.flush ();
+    std::cout << "Waited " << outputter.blocked_time ()
+              << " s for output to be written" << std::endl;
+}
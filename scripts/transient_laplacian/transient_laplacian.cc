@@ -1,3 +1,5 @@
+#include <FVMCode/async_output.h>
+#include <FVMCode/field_reader.h>
 #include <FVMCode/file_parser.h>
 #include <FVMCode/unstructured_mesh.h>
 
@@ -10,10 +12,15 @@ std::string output_dir = "output/case1";
 
 void output_results (const VectorXd &v, const unsigned int counter,
                      const double time);
+void write_restart_data (FVMCode::AsyncOutputter           &outputter,
+                         const VectorXd                    &v,
+                         const FVMCode::BoundaryConditions &bcs,
+                         const unsigned int counter, const double time,
+                         const double dt);
 void write_config (const double start_time, const double end_time,
                    const double dt);
 
-void run ()
+void run (const bool resume)
 {
     using namespace FVMCode;
     UnstructuredMesh       mesh;
@@ -35,14 +42,42 @@ void run ()
     double       time     = 0;
     const double end_time = 1.;
 
-    // Initial conditions
-    temperature                   = VectorXd::Constant (mesh.n_cells (), 1);
-    unsigned int output_counter   = 0;
-    double       next_output_time = 0;
-    write_config (time, end_time, dt);
-    output_results (temperature, output_counter, time);
-    output_counter++;
-    next_output_time += output_time_interval;
+    // The boundary conditions applied below, for the restart data
+    BoundaryConditions bcs;
+    for (const auto &boundary : mesh.get_patches ())
+        bcs.emplace_back (boundary,
+                          BoundaryFieldEntry (boundary.type == empty
+                                                  ? "empty"
+                                                  : "fixedValue",
+                                              boundary.name == "inlet" ? 1
+                                                                       : 0));
+
+    AsyncOutputter outputter;
+    unsigned int   output_counter   = 0;
+    double         next_output_time = 0;
+    const std::optional<Input::TimeDirectory> latest
+        = resume ? Input::find_latest_time (".", "T") : std::nullopt;
+    if (latest)
+    {
+        // Continue from the latest output
+        Input::read_scalar_field (latest->path + "/T", mesh.n_cells (),
+                                  mesh.get_patches (), temperature, bcs);
+        time             = latest->time;
+        output_counter   = latest->index + 1;
+        next_output_time = time + output_time_interval;
+        std::cout << "Resuming from t = " << time << std::endl;
+    }
+    else
+    {
+        // Initial conditions
+        temperature = VectorXd::Constant (mesh.n_cells (), 1);
+        write_config (time, end_time, dt);
+        output_results (temperature, output_counter, time);
+        write_restart_data (outputter, temperature, bcs, output_counter,
+                            time, dt);
+        output_counter++;
+        next_output_time += output_time_interval;
+    }
 
     while (time < end_time)
     {
@@ -126,10 +161,16 @@ void run ()
         if (time >= next_output_time)
         {
             output_results (temperature, output_counter, time);
+            write_restart_data (outputter, temperature, bcs, output_counter,
+                                time, dt);
             output_counter++;
             next_output_time += output_time_interval;
         }
     }
+
+    outputter.flush ();
+    std::cout << "Waited " << outputter.blocked_time ()
+              << " s for output to be written" << std::endl;
 }
 
 void output_results (const VectorXd &v, const unsigned int counter,
@@ -151,6 +192,17 @@ void output_results (const VectorXd &v, const unsigned int counter,
     }
 }
 
+// Queues writing the temperature as an OpenFOAM time directory, which a run
+// started with --resume continues from
+void write_restart_data (FVMCode::AsyncOutputter           &outputter,
+                         const VectorXd                    &v,
+                         const FVMCode::BoundaryConditions &bcs,
+                         const unsigned int counter, const double time,
+                         const double dt)
+{
+    outputter.write_scalar_field (counter, time, dt, dt, v, "T", bcs);
+}
+
 void write_config (const double start_time, const double end_time,
                    const double dt)
 {
@@ -165,8 +217,9 @@ void write_config (const double start_time, const double end_time,
     outfile << "dt " << dt << std::endl;
 }
 
-int main ()
+// Usage: transient_laplacian [--resume]
+int main (int argc, char **argv)
 {
-    run ();
+    run (argc > 1 && std::string (argv[1]) == "--resume");
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include <FVMCode/async_output.h>
+#include <FVMCode/field_reader.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/operators.h>
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_cg.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/time_series.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <filesystem>
+
+using Eigen::VectorXd;
+
+// The transient_laplacian case, assembled with the operators of the library
+// into a SparseMatrix and solved with the conjugate gradient method with a
+// DIC preconditioner, starting from the previous timestep. Writes the
+// temperature as time directories, or with @p time_series appended to the
+// single file T.series.
+void run (const bool resume, const bool time_series)
+{
+    using namespace FVMCode;
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (
+        mesh, "constant/polyMesh/points", "constant/polyMesh/faces",
+        "constant/polyMesh/owner", "constant/polyMesh/neighbour",
+        "constant/polyMesh/boundary");
+
+    // Setup system
+    const SparsityPattern sp (mesh);
+    SparseMatrix          system_matrix (sp);
+    VectorXd              system_rhs (mesh.n_cells ());
+    VectorXd              temperature (mesh.n_cells ());
+
+    const double dt                   = 0.05;
+    const double output_time_interval = 0.05;
+    const double diff_const           = 0.01;
+    const double source_strength      = 1.;
+
+    double       time     = 0;
+    const double end_time = 1.;
+
+    BoundaryConditions bcs;
+    for (const auto &boundary : mesh.get_patches ())
+        bcs.emplace_back (boundary,
+                          BoundaryFieldEntry (boundary.type == empty
+                                                  ? "empty"
+                                                  : "fixedValue",
+                                              boundary.name == "inlet" ? 1
+                                                                       : 0));
+
+    SolverControl control;
+    control.tolerance          = 1e-12;
+    control.relative_tolerance = 1e-8;
+    const SolverCG solver (control);
+
+    AsyncOutputter outputter (1, Outputter::Format::ascii, nullptr,
+                              time_series
+                                  ? AsyncOutputter::Backend::time_series
+                                  : AsyncOutputter::Backend::time_directories,
+                              resume);
+    unsigned int   output_counter   = 0;
+    double         next_output_time = 0;
+    const std::optional<Input::TimeDirectory> latest
+        = resume && !time_series ? Input::find_latest_time (".", "T")
+                                 : std::nullopt;
+    const bool resume_time_series
+        = resume && time_series && std::filesystem::exists ("T.series")
+          && TimeSeriesReader ("T.series").n_frames () > 0;
+    if (latest)
+    {
+        // Continue from the latest output
+        Input::read_scalar_field (latest->path + "/T", mesh.n_cells (),
+                                  mesh.get_patches (), temperature, bcs);
+        time             = latest->time;
+        output_counter   = latest->index + 1;
+        next_output_time = time + output_time_interval;
+        std::cout << "Resuming from t = " << time << std::endl;
+    }
+    else if (resume_time_series)
+    {
+        // Continue from the last frame. The boundary conditions are not
+        // part of the time series, but do not change.
+        const TimeSeriesReader series ("T.series");
+        const unsigned int     last = series.n_frames () - 1;
+        temperature                 = series.values (last);
+        time                        = series.time (last);
+        output_counter              = series.timestep_number (last) + 1;
+        next_output_time            = time + output_time_interval;
+        std::cout << "Resuming from t = " << time << std::endl;
+    }
+    else
+    {
+        // Initial conditions
+        temperature = VectorXd::Constant (mesh.n_cells (), 1);
+        outputter.write_scalar_field (output_counter, time, dt, dt,
+                                      temperature, "T", bcs);
+        output_counter++;
+        next_output_time += output_time_interval;
+    }
+
+    while (time < end_time)
+    {
+        time += dt;
+
+        system_matrix.set_zero ();
+        system_rhs.setZero ();
+        Operators::ddt (system_matrix, system_rhs, mesh, temperature, dt);
+        Operators::source (system_rhs, mesh, source_strength);
+        Operators::laplacian (system_matrix, system_rhs, mesh, bcs,
+                              diff_const);
+
+        const PreconditionerDIC preconditioner (system_matrix);
+        const SolverResult      result = solver.solve (
+            system_matrix, temperature, system_rhs, preconditioner);
+        AssertThrow (result.converged,
+                     std::runtime_error ("CG did not converge"));
+
+        // output temperature
+        if (time >= next_output_time)
+        {
+            outputter.write_scalar_field (output_counter, time, dt, dt,
+                                          temperature, "T", bcs);
+            output_counter++;
+            next_output_time += output_time_interval;
+        }
+    }
+
+    outputter.flush ();
+    std::cout << "Waited " << outputter.blocked_time ()
+              << " s for output to be written" << std::endl;
+}
+
+// Usage: transient_laplacian_sparse [--resume] [--time-series]
+int main (int argc, char **argv)
+{
+    bool resume = false, time_series = false;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument (argv[i]);
+        resume |= argument == "--resume";
+        time_series |= argument == "--time-series";
+    }
+    run (resume, time_series);
+    return EXIT_SUCCESS;
+}
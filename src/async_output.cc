@@ -0,0 +1,208 @@
+#include <FVMCode/async_output.h>
+#include <FVMCode/time_series.h>
+#include <FVMCode/vtu_output.h>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace FVMCode
+{
+
+namespace
+{
+// Checked before the thread starts: with an empty queue, the first
+// write_scalar_field() would wait forever
+unsigned int checked_queue_size (const unsigned int queue_size)
+{
+    AssertThrow (queue_size > 0,
+                 std::invalid_argument (
+                     "The output queue must hold at least one field"));
+    return queue_size;
+}
+} // namespace
+
+AsyncOutputter::AsyncOutputter (const unsigned int      queue_size,
+                                const Outputter::Format format,
+                                VTUWriter              *vtu_writer,
+                                const Backend           backend,
+                                const bool              append_time_series)
+    : queue_size (checked_queue_size (queue_size))
+    , format (format)
+    , vtu_writer (vtu_writer)
+    , backend (backend)
+    , append_time_series (append_time_series)
+    , thread ([this] { run (); })
+{
+}
+
+AsyncOutputter::~AsyncOutputter ()
+{
+    try
+    {
+        flush ();
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "WARNING: writing output failed: " << e.what ()
+                  << std::endl;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        stop = true;
+    }
+    job_queued.notify_one ();
+    thread.join ();
+}
+
+void AsyncOutputter::write_scalar_field (
+    const unsigned int timestep_number, const double time, const double dt,
+    const double original_dt, const Eigen::VectorXd &scalar_field,
+    const std::string &name, const BoundaryConditions &boundary_conditions,
+    const std::vector<unsigned int> &original_cell_index)
+{
+    Eigen::VectorXd buffer;
+    {
+        std::unique_lock<std::mutex> lock (mutex);
+        rethrow_error ();
+        if (queue.size () >= queue_size)
+        {
+            const auto start = std::chrono::steady_clock::now ();
+            job_done.wait (lock, [this] {
+                return queue.size () < queue_size || error;
+            });
+            blocked += std::chrono::steady_clock::now () - start;
+            rethrow_error ();
+        }
+        if (!buffer_pool.empty ())
+        {
+            buffer = std::move (buffer_pool.back ());
+            buffer_pool.pop_back ();
+        }
+    }
+
+    // Copying needs no lock. A pooled buffer of the right size is reused
+    // without allocating.
+    buffer = scalar_field;
+    Job job { timestep_number, time, dt, original_dt, std::move (buffer),
+              name, boundary_conditions, original_cell_index };
+
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        queue.push_back (std::move (job));
+    }
+    job_queued.notify_one ();
+}
+
+void AsyncOutputter::flush ()
+{
+    std::unique_lock<std::mutex> lock (mutex);
+    const auto                   start = std::chrono::steady_clock::now ();
+    job_done.wait (lock, [this] { return queue.empty () && !writing; });
+    blocked += std::chrono::steady_clock::now () - start;
+    rethrow_error ();
+}
+
+double AsyncOutputter::blocked_time () const
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    return std::chrono::duration<double> (blocked).count ();
+}
+
+unsigned int AsyncOutputter::n_written () const
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    return n_written_;
+}
+
+void AsyncOutputter::run ()
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock (mutex);
+            job_queued.wait (lock, [this] { return stop || !queue.empty (); });
+            if (queue.empty ())
+                return;
+            job = std::move (queue.front ());
+            queue.pop_front ();
+            writing = true;
+        }
+
+        std::exception_ptr job_error;
+        try
+        {
+            if (backend == Backend::time_series)
+                append_to_time_series (job);
+            else
+            {
+                Outputter outputter (job.timestep_number, job.time, job.dt,
+                                     job.original_dt, 2, format);
+                outputter.write_time ();
+                outputter.write_scalar_field (job.scalar_field, job.name,
+                                              job.boundary_conditions,
+                                              job.original_cell_index);
+            }
+            if (vtu_writer)
+                vtu_writer->write_scalar_field (job.time, job.scalar_field,
+                                                job.name);
+        }
+        catch (...)
+        {
+            job_error = std::current_exception ();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            if (job_error && !error)
+                error = job_error;
+            buffer_pool.push_back (std::move (job.scalar_field));
+            writing = false;
+            n_written_++;
+        }
+        job_done.notify_all ();
+    }
+}
+
+void AsyncOutputter::append_to_time_series (const Job &job)
+{
+    std::unique_ptr<TimeSeriesWriter> &writer = time_series[job.name];
+    if (!writer)
+        writer = std::make_unique<TimeSeriesWriter> (
+            job.name + ".series", job.name, job.scalar_field.size (),
+            append_time_series);
+
+    if (job.original_cell_index.empty ())
+    {
+        writer->append (job.timestep_number, job.time, job.scalar_field);
+        return;
+    }
+    // As Outputter::write_scalar_field() does for time directories
+    AssertThrow (job.original_cell_index.size ()
+                     == static_cast<std::size_t> (job.scalar_field.size ()),
+                 std::runtime_error (
+                     "Permutation and field have different sizes"));
+    original_order.resize (job.scalar_field.size ());
+    for (unsigned int c = 0; c < job.original_cell_index.size (); c++)
+    {
+        AssertThrow (job.original_cell_index[c]
+                         < job.original_cell_index.size (),
+                     std::runtime_error ("Cell index out of range in "
+                                         "permutation"));
+        original_order (job.original_cell_index[c]) = job.scalar_field (c);
+    }
+    writer->append (job.timestep_number, job.time, original_order);
+}
+
+void AsyncOutputter::rethrow_error ()
+{
+    if (error)
+    {
+        std::exception_ptr e = error;
+        error                = nullptr;
+        std::rethrow_exception (e);
+    }
+}
+
+} // namespace FVMCode
@@ -0,0 +1,164 @@
+#include <FVMCode/cell_search_tree.h>
+
+#include <algorithm>
+
+namespace FVMCode
+{
+
+BoundingBox::BoundingBox ()
+    : lower (std::numeric_limits<double>::max (),
+             std::numeric_limits<double>::max (),
+             std::numeric_limits<double>::max ())
+    , upper (std::numeric_limits<double>::lowest (),
+             std::numeric_limits<double>::lowest (),
+             std::numeric_limits<double>::lowest ())
+{
+}
+
+void BoundingBox::extend (const Point<3> &point)
+{
+    for (unsigned int d = 0; d < 3; d++)
+    {
+        lower (d) = std::min (lower (d), point (d));
+        upper (d) = std::max (upper (d), point (d));
+    }
+}
+
+void BoundingBox::extend (const BoundingBox &box)
+{
+    extend (box.lower);
+    extend (box.upper);
+}
+
+bool BoundingBox::contains (const Point<3> &point) const
+{
+    for (unsigned int d = 0; d < 3; d++)
+    {
+        // Pad the box slightly so that points on a cell face are not missed
+        // due to round off
+        const double tolerance = 1e-12 * (upper (d) - lower (d));
+        if (point (d) < lower (d) - tolerance
+            || point (d) > upper (d) + tolerance)
+            return false;
+    }
+    return true;
+}
+
+double BoundingBox::center (const unsigned int direction) const
+{
+    return 0.5 * (lower (direction) + upper (direction));
+}
+
+unsigned int BoundingBox::longest_direction () const
+{
+    unsigned int direction = 0;
+    for (unsigned int d = 1; d < 3; d++)
+        if (upper (d) - lower (d) > upper (direction) - lower (direction))
+            direction = d;
+    return direction;
+}
+
+CellSearchTree::CellSearchTree (const CellList &cells)
+    : cell_boxes (cells.size ())
+    , cell_box_centers (cells.size ())
+    , cell_indices (cells.size ())
+{
+    for (unsigned int c = 0; c < cells.size (); c++)
+    {
+        for (const auto &face : cells[c].faces ())
+            for (const auto &vertex : face->vertices ())
+                cell_boxes[c].extend (*vertex);
+        for (unsigned int d = 0; d < 3; d++)
+            cell_box_centers[c](d) = cell_boxes[c].center (d);
+        cell_indices[c] = c;
+    }
+
+    // A binary tree with leaves of at least max_leaf_size / 2 cells has
+    // fewer than this many nodes
+    nodes.reserve (4 * cells.size () / max_leaf_size + 1);
+    if (!cells.empty ())
+        build (0, cells.size ());
+}
+
+unsigned int CellSearchTree::build (const unsigned int begin,
+                                    const unsigned int end)
+{
+    const unsigned int node_index = nodes.size ();
+    nodes.push_back (Node ());
+
+    BoundingBox box;
+    BoundingBox center_box;
+    for (unsigned int i = begin; i < end; i++)
+    {
+        box.extend (cell_boxes[cell_indices[i]]);
+        center_box.extend (cell_box_centers[cell_indices[i]]);
+    }
+    nodes[node_index].box = box;
+
+    if (end - begin <= max_leaf_size)
+    {
+        nodes[node_index].first       = begin;
+        nodes[node_index].count       = end - begin;
+        nodes[node_index].right_child = 0;
+        return node_index;
+    }
+
+    // Median split of the box centres along the direction in which they are
+    // most spread out
+    const unsigned int direction = center_box.longest_direction ();
+    const unsigned int middle    = begin + (end - begin) / 2;
+    std::nth_element (cell_indices.begin () + begin,
+                      cell_indices.begin () + middle,
+                      cell_indices.begin () + end,
+                      [&] (const unsigned int a, const unsigned int b) {
+                          return cell_box_centers[a](direction)
+                                 < cell_box_centers[b](direction);
+                      });
+
+    build (begin, middle);
+    const unsigned int right_child = build (middle, end);
+
+    nodes[node_index].first       = 0;
+    nodes[node_index].count       = 0;
+    nodes[node_index].right_child = right_child;
+    return node_index;
+}
+
+unsigned int CellSearchTree::find_cell (const CellList &cells,
+                                        const Point<3> &point) const
+{
+    unsigned int result = invalid_cell;
+    if (nodes.empty ())
+        return result;
+
+    // Depth first traversal with an explicit stack. The tree depth is
+    // logarithmic in the number of cells, so this stays small.
+    unsigned int stack[128];
+    unsigned int stack_size = 0;
+    stack[stack_size++]     = 0;
+    while (stack_size > 0)
+    {
+        const Node &node = nodes[stack[--stack_size]];
+        if (!node.box.contains (point))
+            continue;
+
+        if (node.count == 0)
+        {
+            const unsigned int node_index = &node - nodes.data ();
+            stack[stack_size++]           = node.right_child;
+            stack[stack_size++]           = node_index + 1;
+            continue;
+        }
+
+        for (unsigned int i = node.first; i < node.first + node.count; i++)
+        {
+            const unsigned int c = cell_indices[i];
+            if (c < result && cell_boxes[c].contains (point)
+                && cells[c].point_inside (point))
+                result = c;
+        }
+    }
+    return result;
+}
+
+} // namespace FVMCode
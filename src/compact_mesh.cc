@@ -0,0 +1,26 @@
+#include <FVMCode/compact_mesh.h>
+
+#include <initializer_list>
+
+namespace FVMCode
+{
+
+std::size_t CompactMesh::memory_consumption () const
+{
+    std::size_t bytes = sizeof (*this);
+    for (const LabelList *list : { &owner_, &neighbour_, &face_offsets_,
+                                   &face_vertices_, &cell_offsets_,
+                                   &cell_faces_ })
+        bytes += list->capacity () * sizeof (label);
+    for (const VectorComponents *vectors :
+         { &points_, &area_vecs_, &face_centers_, &cell_centers_ })
+        for (const ScalarList &component : *vectors)
+            bytes += component.capacity () * sizeof (double);
+    for (const ScalarList *list : { &face_areas_, &deltas_,
+                                    &interpolation_factors_, &cell_volumes_ })
+        bytes += list->capacity () * sizeof (double);
+    bytes += boundaries.capacity () * sizeof (BoundaryPatch);
+    return bytes;
+}
+
+} // namespace FVMCode
@@ -0,0 +1,108 @@
+#include <FVMCode/exceptions.h>
+#include <FVMCode/face_colouring.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace FVMCode
+{
+
+namespace
+{
+// The index of the lowest bit of @p bits that is not set, which must exist
+unsigned int lowest_clear_bit (std::uint64_t bits)
+{
+    unsigned int b = 0;
+    for (; bits & 1; bits >>= 1) b++;
+    return b;
+}
+} // namespace
+
+FaceColouring::FaceColouring (UnstructuredMesh &mesh)
+{
+    const unsigned int n_internal_faces
+        = mesh.get_patches ().empty () ? mesh.n_faces ()
+                                       : mesh.get_patches ()[0].start_face;
+    std::vector<unsigned int> owner (n_internal_faces);
+    std::vector<unsigned int> neighbour (n_internal_faces);
+    for (unsigned int f = 0; f < n_internal_faces; f++)
+    {
+        const auto &face = mesh.get_face (f);
+        Assert (!face->is_boundary (),
+                "Face should not be at boundary! Check face numbering.");
+        owner[f]     = face->neighbour_indices ()[0];
+        neighbour[f] = face->neighbour_indices ()[1];
+    }
+    compute (mesh.n_cells (), owner, neighbour);
+}
+
+FaceColouring::FaceColouring (const unsigned int               n_cells,
+                              const std::vector<unsigned int> &owner,
+                              const std::vector<unsigned int> &neighbour)
+{
+    compute (n_cells, owner, neighbour);
+}
+
+void FaceColouring::compute (const unsigned int               n_cells,
+                             const std::vector<unsigned int> &owner,
+                             const std::vector<unsigned int> &neighbour)
+{
+    Assert (owner.size () == neighbour.size (),
+            "Owner and neighbour lists are of different size");
+    const unsigned int n_faces = owner.size ();
+
+    // Bit b of word w of the colours of a cell is set once a face of the
+    // cell has colour 64 w + b. Greedy colouring needs at most (faces of
+    // owner) + (faces of neighbour) - 1 colours, so one word is enough for
+    // any sensible cell shape, but another is added to every cell whenever a
+    // face finds all colours used.
+    unsigned int               n_words = 1;
+    std::vector<std::uint64_t> used_colours (n_cells, 0);
+    face_colour.resize (n_faces);
+    unsigned int n_used_colours = 0;
+    for (unsigned int f = 0; f < n_faces; f++)
+    {
+        AssertIndexRange (owner[f], n_cells);
+        AssertIndexRange (neighbour[f], n_cells);
+        std::size_t  o = std::size_t (owner[f]) * n_words;
+        std::size_t  n = std::size_t (neighbour[f]) * n_words;
+        unsigned int w = 0;
+        while (w < n_words
+               && (used_colours[o + w] | used_colours[n + w])
+                      == ~std::uint64_t (0))
+            w++;
+        if (w == n_words)
+        {
+            std::vector<std::uint64_t> grown (
+                std::size_t (n_cells) * (n_words + 1), 0);
+            for (std::size_t cell = 0; cell < n_cells; cell++)
+                std::copy_n (&used_colours[cell * n_words], n_words,
+                             &grown[cell * (n_words + 1)]);
+            used_colours.swap (grown);
+            o += owner[f];
+            n += neighbour[f];
+            n_words++;
+        }
+        const unsigned int b
+            = lowest_clear_bit (used_colours[o + w] | used_colours[n + w]);
+        const unsigned int c = 64 * w + b;
+        face_colour[f]       = c;
+        used_colours[o + w] |= std::uint64_t (1) << b;
+        used_colours[n + w] |= std::uint64_t (1) << b;
+        n_used_colours = std::max (n_used_colours, c + 1);
+    }
+
+    // Counting sort of the faces by colour
+    colour_offsets.assign (n_used_colours + 1, 0);
+    for (unsigned int f = 0; f < n_faces; f++)
+        colour_offsets[face_colour[f] + 1]++;
+    for (unsigned int c = 0; c < n_used_colours; c++)
+        colour_offsets[c + 1] += colour_offsets[c];
+    faces_by_colour.resize (n_faces);
+    std::vector<unsigned int> next (colour_offsets.begin (),
+                                    colour_offsets.end () - 1);
+    for (unsigned int f = 0; f < n_faces; f++)
+        faces_by_colour[next[face_colour[f]]++] = f;
+}
+
+} // namespace FVMCode
@@ -0,0 +1,257 @@
+#include <FVMCode/field_reader.h>
+#include <FVMCode/foam_tokenizer.h>
+#include <FVMCode/input_file.h>
+
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace FVMCode
+{
+namespace Input
+{
+
+namespace
+{
+// Reads the value of a field entry, either "uniform v", which gives
+// n_uniform_values copies of v, or "nonuniform List<scalar> n (v_0 ...)",
+// where the list may also be written in binary or as n{v}
+void read_field_values (FoamTokenizer &tokens, const FoamHeader &header,
+                        const unsigned int n_uniform_values,
+                        Eigen::VectorXd   &values)
+{
+    const std::string_view kind = tokens.read_word ();
+    if (kind == "uniform")
+    {
+        values.setConstant (n_uniform_values, tokens.read_double ());
+        return;
+    }
+    if (kind != "nonuniform")
+        tokens.error ("expected uniform or nonuniform, found '"
+                      + std::string (kind) + "'");
+
+    const std::string_view type = tokens.read_word ();
+    if (type != "List<scalar>")
+        tokens.error ("expected List<scalar>, found '" + std::string (type)
+                      + "'");
+    const unsigned int n_values = tokens.read_unsigned ();
+    if (tokens.peek () == '{')
+    {
+        tokens.expect ('{');
+        values.setConstant (n_values, tokens.read_double ());
+        tokens.expect ('}');
+        return;
+    }
+
+    values.resize (n_values);
+    tokens.expect ('(');
+    if (header.binary)
+        std::memcpy (values.data (),
+                     tokens.read_bytes (std::size_t (n_values)
+                                        * sizeof (double)),
+                     std::size_t (n_values) * sizeof (double));
+    else
+        for (unsigned int n = 0; n < n_values; n++)
+            values (n) = tokens.read_double ();
+    tokens.expect (')');
+}
+
+void read_boundary_field (FoamTokenizer &tokens, const FoamHeader &header,
+                          const std::vector<BoundaryPatch> &patches,
+                          BoundaryConditions &boundary_conditions)
+{
+    std::vector<std::optional<BoundaryFieldEntry> > entries (patches.size ());
+    Eigen::VectorXd                                  values;
+
+    tokens.expect ('{');
+    while (tokens.peek () != '}')
+    {
+        if (tokens.peek () == '\0')
+            tokens.error ("end of file reached inside boundaryField");
+        const std::string_view name = tokens.read_word ();
+        unsigned int           p    = 0;
+        while (p < patches.size () && patches[p].name != name) p++;
+        if (p == patches.size ())
+        {
+            // Not a patch of the mesh, e.g. a patch group
+            tokens.skip_entry_or_dictionary ();
+            continue;
+        }
+
+        std::string type;
+        double      value         = 0;
+        bool        uniform_value = true;
+        tokens.expect ('{');
+        while (tokens.peek () != '}')
+        {
+            if (tokens.peek () == '\0')
+                tokens.error ("end of file reached inside patch "
+                              + patches[p].name);
+            const std::string_view keyword = tokens.read_word ();
+            if (keyword == "type")
+            {
+                type = tokens.read_word ();
+                tokens.expect (';');
+            }
+            else if (keyword == "value")
+            {
+                read_field_values (tokens, header, patches[p].n_faces,
+                                   values);
+                tokens.expect (';');
+                if (values.size () > 0)
+                {
+                    value         = values (0);
+                    uniform_value = (values.array () == value).all ();
+                }
+            }
+            else
+                tokens.skip_entry_or_dictionary ();
+        }
+        tokens.expect ('}');
+
+        if (type.empty ())
+            tokens.error ("patch " + patches[p].name + " has no type");
+        if (!uniform_value)
+        {
+            if (type == "fixedValue")
+                tokens.error ("patch " + patches[p].name
+                              + " has a nonuniform fixed value, which is "
+                                "not supported");
+            value = 0;
+        }
+        entries[p].emplace (type, value);
+    }
+    tokens.expect ('}');
+
+    boundary_conditions.clear ();
+    for (unsigned int p = 0; p < patches.size (); p++)
+    {
+        if (!entries[p])
+            tokens.error ("boundaryField has no entry for patch "
+                          + patches[p].name);
+        boundary_conditions.emplace_back (patches[p], *entries[p]);
+    }
+}
+} // namespace
+
+void read_scalar_field (std::string_view buffer, const std::string &file_name,
+                        const unsigned int                n_cells,
+                        const std::vector<BoundaryPatch> &patches,
+                        Eigen::VectorXd                  &internal_field,
+                        BoundaryConditions &boundary_conditions)
+{
+    FoamTokenizer    tokens (buffer, file_name);
+    const FoamHeader header = tokens.read_foam_header ();
+    if (!header.class_name.empty () && header.class_name != "volScalarField")
+        tokens.error ("expected a volScalarField, found "
+                      + header.class_name);
+
+    bool found_internal_field = false, found_boundary_field = false;
+    while (!tokens.at_end ())
+    {
+        const std::string_view keyword = tokens.read_word ();
+        if (keyword == "internalField")
+        {
+            read_field_values (tokens, header, n_cells, internal_field);
+            if (internal_field.size () != n_cells)
+                tokens.error ("internalField has "
+                              + std::to_string (internal_field.size ())
+                              + " values, but the mesh has "
+                              + std::to_string (n_cells) + " cells");
+            tokens.expect (';');
+            found_internal_field = true;
+        }
+        else if (keyword == "boundaryField")
+        {
+            read_boundary_field (tokens, header, patches,
+                                 boundary_conditions);
+            found_boundary_field = true;
+        }
+        else
+            tokens.skip_entry_or_dictionary ();
+    }
+
+    if (!found_internal_field)
+        tokens.error ("no internalField");
+    if (!found_boundary_field)
+        tokens.error ("no boundaryField");
+}
+
+void read_scalar_field (const std::string                &filename,
+                        const unsigned int                n_cells,
+                        const std::vector<BoundaryPatch> &patches,
+                        Eigen::VectorXd                  &internal_field,
+                        BoundaryConditions               &boundary_conditions,
+                        const std::vector<unsigned int> &original_cell_index)
+{
+    const InputFile file (filename);
+    read_scalar_field (file.view (), file.path (), n_cells, patches,
+                       internal_field, boundary_conditions);
+
+    if (original_cell_index.empty ())
+        return;
+    AssertThrow (original_cell_index.size () == n_cells,
+                 std::runtime_error (
+                     "Permutation and field have different sizes"));
+    const Eigen::VectorXd original_order = internal_field;
+    for (unsigned int c = 0; c < n_cells; c++)
+    {
+        AssertThrow (original_cell_index[c] < n_cells,
+                     std::runtime_error ("Cell index out of range in "
+                                         "permutation"));
+        internal_field (c) = original_order (original_cell_index[c]);
+    }
+}
+
+std::optional<TimeDirectory> find_latest_time (
+    const std::string &case_directory, const std::string &field_name)
+{
+    namespace fs = std::filesystem;
+
+    std::optional<TimeDirectory> latest;
+    for (const fs::directory_entry &entry :
+         fs::directory_iterator (case_directory))
+    {
+        if (!entry.is_directory ())
+            continue;
+        const std::string name = entry.path ().filename ().string ();
+        TimeDirectory     directory { entry.path ().string (), 0., 0 };
+        const auto [end, ec] = std::from_chars (
+            name.data (), name.data () + name.size (), directory.time);
+        if (ec != std::errc () || end != name.data () + name.size ())
+            continue;
+        const fs::path field = entry.path () / field_name;
+        if (!fs::exists (field) && !fs::exists (field.string () + ".gz"))
+            continue;
+
+        const fs::path time_file = entry.path () / "uniform" / "time";
+        if (fs::exists (time_file) || fs::exists (time_file.string () + ".gz"))
+        {
+            const InputFile  file (time_file.string ());
+            FoamTokenizer    tokens (file.view (), file.path ());
+            tokens.skip_foam_header ();
+            while (!tokens.at_end ())
+            {
+                const std::string_view keyword = tokens.read_word ();
+                if (keyword == "value")
+                    directory.time = tokens.read_double ();
+                else if (keyword == "index")
+                    directory.index = tokens.read_unsigned ();
+                else
+                {
+                    tokens.skip_entry ();
+                    continue;
+                }
+                tokens.expect (';');
+            }
+        }
+
+        if (!latest || directory.time > latest->time)
+            latest = directory;
+    }
+    return latest;
+}
+
+} // namespace Input
+} // namespace FVMCode
@@ -1,6 +1,11 @@
 #include <FVMCode/exceptions.h>
 #include <FVMCode/file_parser.h>
 #include <FVMCode/input.h>
+#include <FVMCode/input_file.h>
+
+#include <exception>
+#include <memory>
+#include <stdexcept>
 
 namespace FVMCode
 {
@@ -25,22 +30,47 @@ UnstructuredMeshParser::UnstructuredMeshParser (
 UnstructuredMeshParser::UnstructuredMeshParser (
     UnstructuredMesh &mesh, const std::string &points_file,
     const std::string &faces_file, const std::string &owner_file,
-    const std::string &neighbour_file, const std::string &boundary_file)
+    const std::string &neighbour_file, const std::string &boundary_file,
+    const ParserOptions &options)
     : mesh (mesh)
 {
-    parse_points (points_file);
-    parse_faces (faces_file);
-    parse_owner_neighbour_list (owner_file, neighbour_file);
-    parse_boundaries_foam (boundary_file);
+    const std::vector<std::string> source_files
+        = { points_file, faces_file, owner_file, neighbour_file,
+            boundary_file };
+    if (!options.cache_file.empty ()
+        && read_cache (options.cache_file, source_files))
+    {
+        from_cache = true;
+        return;
+    }
+
+    if (options.backend == ParserOptions::Backend::stream)
+    {
+        parse_points (points_file);
+        parse_faces (faces_file);
+        parse_owner_neighbour_list (owner_file, neighbour_file);
+        parse_boundaries_foam (boundary_file);
+    }
+    else
+    {
+        Input::PolyMeshData data;
+        read_memory_mapped (points_file, faces_file, owner_file,
+                            neighbour_file, boundary_file, options, data);
+        link (data);
+    }
 
     compute_distance_ratios ();
+
+    if (!options.cache_file.empty ())
+        write_cache (options.cache_file, source_files);
 }
 
-UnstructuredMeshParser::UnstructuredMeshParser (UnstructuredMesh &mesh)
+UnstructuredMeshParser::UnstructuredMeshParser (UnstructuredMesh    &mesh,
+                                                const ParserOptions &options)
     : UnstructuredMeshParser (
         mesh, "constant/polyMesh/points", "constant/polyMesh/faces",
         "constant/polyMesh/owner", "constant/polyMesh/neighbour",
-        "constant/polyMesh/boundary")
+        "constant/polyMesh/boundary", options)
 {
 }
 
@@ -65,9 +95,10 @@ void UnstructuredMeshParser::skip_foam_header (Input::comment_istream &file) con
     {
         if (file.peek () == EOF)
         {
-            Assert (false, "End of file has been reached before FoamFile "
-                           "dictionary has closed!");
-            break;
+            AssertThrow (false,
+                         std::runtime_error (
+                             "End of file has been reached before FoamFile "
+                             "dictionary has closed!"));
         }
         file >> inchar;
         if (inchar == '{')
@@ -242,37 +273,38 @@ void UnstructuredMeshParser::parse_boundaries_legacy (
 void UnstructuredMeshParser::parse_owner_neighbour_list (
     const std::string &owner_file, const std::string &neighbour_file)
 {
-    _add_cells_to_faces_neighbours (owner_file);
-    _add_cells_to_faces_neighbours (neighbour_file);
-
-    // Now the faces all have indices in their neighbour lists, and we've
-    // populated the map from cell_index -> face_indices
-    // We can therefore construct the cells using the faces_of_cell map
-
-    for (const auto &[cell_index, face_indices] : faces_of_cell)
-    {
-        (void)cell_index;
+    std::vector<unsigned int> owner, neighbour;
+    _add_cells_to_faces_neighbours (owner_file, owner);
+    _add_cells_to_faces_neighbours (neighbour_file, neighbour);
 
-        std::vector<UnstructuredMesh::FaceIterator> faces (
-            face_indices.size ());
+    // Now the faces all have indices in their neighbour lists
+    construct_cells (owner, neighbour);
+}
 
-        for (unsigned int f = 0; f < face_indices.size (); f++)
-        {
-            faces[f] = mesh.get_face (face_indices[f]);
-        }
+void UnstructuredMeshParser::construct_cells (
+    const std::vector<unsigned int> &owner,
+    const std::vector<unsigned int> &neighbour)
+{
+    std::vector<unsigned int> cell_offsets, cell_faces;
+    Input::build_cell_faces (owner, neighbour, cell_offsets, cell_faces);
 
-        // Note that because faces_of_cell is an ordered map, we expect the
-        // cell indices to be in the right order for us to do this:
-        Cell<3> cell (faces);
-        mesh.cell_list.push_back (cell);
+    const unsigned int n_cells = cell_offsets.size () - 1;
+    mesh.cell_list.reserve (n_cells);
+    std::vector<UnstructuredMesh::FaceIterator> faces;
+    for (unsigned int c = 0; c < n_cells; c++)
+    {
+        faces.clear ();
+        for (unsigned int f = cell_offsets[c]; f < cell_offsets[c + 1]; f++)
+            faces.push_back (mesh.get_face (cell_faces[f]));
+        mesh.cell_list.push_back (Cell<3> (faces));
     }
 }
 
 // For each line in the owner/neighbour file, add the cell index to the
-// neighbour list of the corresponding face. Needs to be called in order using
-// parse_owner_neighbour_list.
+// neighbour list of the corresponding face and to labels. Needs to be called
+// in order using parse_owner_neighbour_list.
 void UnstructuredMeshParser::_add_cells_to_faces_neighbours (
-    const std::string &label_list_file)
+    const std::string &label_list_file, std::vector<unsigned int> &labels)
 {
     Input::comment_istream file(label_list_file);
     skip_foam_header(file);
@@ -285,11 +317,12 @@ void UnstructuredMeshParser::_add_cells_to_faces_neighbours (
 
     unsigned int cell_index;
 
+    labels.resize (n_entries);
     for (unsigned int n = 0; n < n_entries; n++)
     {
         file >> cell_index;
         mesh.get_face (n)->neighbour_list.push_back (cell_index);
-        faces_of_cell[cell_index].push_back (n);
+        labels[n] = cell_index;
     }
 
     char closed_bracket;
@@ -371,6 +404,142 @@ void UnstructuredMeshParser::parse_boundaries_foam (
     Assert (closed_bracket_round == ')', "Malformed boundary file");
 }
 
+void UnstructuredMeshParser::read_memory_mapped (
+    const std::string &points_file, const std::string &faces_file,
+    const std::string &owner_file, const std::string &neighbour_file,
+    const std::string &boundary_file, const ParserOptions &options,
+    Input::PolyMeshData &data) const
+{
+    // Threads reading chunks of the larger files, if any
+    std::unique_ptr<Parallel::ThreadPool> chunk_pool;
+    if (options.chunked)
+        chunk_pool = std::make_unique<Parallel::ThreadPool> (options.n_threads);
+
+    // Opening the files first starts decompressing any compressed ones in
+    // the background, so that decompression overlaps with reading the
+    // files before them
+    const Input::InputFile faces (faces_file), points (points_file),
+        owner (owner_file), neighbour (neighbour_file),
+        boundary (boundary_file);
+
+    // The files are independent of each other until they are linked, so
+    // each can be read by its own task
+    const std::function<void ()> tasks[] = {
+        [&] {
+            if (chunk_pool)
+                Input::read_faces (faces.view (), faces.path (),
+                                   data.face_offsets, data.face_vertices,
+                                   *chunk_pool);
+            else
+                Input::read_faces (faces.view (), faces.path (),
+                                   data.face_offsets, data.face_vertices);
+        },
+        [&] {
+            if (chunk_pool)
+                Input::read_points (points.view (), points.path (),
+                                    data.points, *chunk_pool);
+            else
+                Input::read_points (points.view (), points.path (),
+                                    data.points);
+        },
+        [&] {
+            if (chunk_pool)
+                Input::read_labels (owner.view (), owner.path (), data.owner,
+                                    *chunk_pool);
+            else
+                Input::read_labels (owner.view (), owner.path (), data.owner);
+        },
+        [&] {
+            if (chunk_pool)
+                Input::read_labels (neighbour.view (), neighbour.path (),
+                                    data.neighbour, *chunk_pool);
+            else
+                Input::read_labels (neighbour.view (), neighbour.path (),
+                                    data.neighbour);
+        },
+        [&] {
+            Input::read_boundaries (boundary.view (), boundary.path (),
+                                    data.boundaries);
+        }
+    };
+
+    if (!options.concurrent)
+    {
+        for (const auto &task : tasks) task ();
+        return;
+    }
+
+    // The calling thread reads the largest file (faces) while the pool's
+    // workers read the others
+    Parallel::ThreadPool pool (std::min<unsigned int> (options.n_threads,
+                                                       std::size (tasks)));
+    std::vector<std::future<void> > results;
+    for (unsigned int t = 1; t < std::size (tasks); t++)
+        results.push_back (pool.submit (tasks[t]));
+    std::exception_ptr faces_error;
+    try
+    {
+        tasks[0]();
+    }
+    catch (...)
+    {
+        faces_error = std::current_exception ();
+    }
+    // get() rethrows any exception thrown while reading. All tasks are
+    // waited for first, since they write to data.
+    for (auto &result : results) result.wait ();
+    if (faces_error)
+        std::rethrow_exception (faces_error);
+    for (auto &result : results) result.get ();
+}
+
+void UnstructuredMeshParser::link (Input::PolyMeshData &data)
+{
+    const unsigned int n_points = data.points.size ();
+    const unsigned int n_faces  = data.face_offsets.size () - 1;
+    AssertThrow (n_points > 0, std::runtime_error ("Mesh has no points"));
+    AssertThrow (n_faces > 0, std::runtime_error ("Mesh has no faces"));
+    AssertThrow (data.owner.size () == n_faces,
+                 std::runtime_error (
+                     "Owner list and face list are of different size"));
+    AssertThrow (data.neighbour.size () <= n_faces,
+                 std::runtime_error ("Neighbour list is longer than face "
+                                     "list"));
+
+    mesh.point_list = std::move (data.points);
+
+    mesh.face_list.reserve (n_faces);
+    std::vector<UnstructuredMesh::PointIterator> vertices;
+    for (unsigned int f = 0; f < n_faces; f++)
+    {
+        vertices.clear ();
+        for (unsigned int v = data.face_offsets[f];
+             v < data.face_offsets[f + 1]; v++)
+        {
+            const unsigned int index = data.face_vertices[v];
+            AssertThrow (index < n_points,
+                         std::runtime_error ("Point index too large"));
+            vertices.push_back (mesh.get_point (index));
+        }
+        Face<3> face (vertices);
+        // Room for the owner and neighbour, so that adding them below does
+        // not reallocate
+        face.neighbour_list.reserve (f < data.neighbour.size () ? 2 : 1);
+        mesh.face_list.push_back (std::move (face));
+    }
+
+    // As in _add_cells_to_faces_neighbours, owners first so that they come
+    // first in the neighbour lists
+    for (const std::vector<unsigned int> *labels :
+         { &data.owner, &data.neighbour })
+        for (unsigned int f = 0; f < labels->size (); f++)
+            mesh.face_list[f].neighbour_list.push_back ((*labels)[f]);
+    construct_cells (data.owner, data.neighbour);
+
+    for (const BoundaryPatch &patch : data.boundaries)
+        mesh.boundaries.push_back (patch);
+}
+
 void UnstructuredMeshParser::fix_normals ()
 {
     for (Face<3> &face : mesh.faces ())
@@ -445,4 +614,110 @@ void UnstructuredMeshParser::compute_distance_ratios ()
     }
 }
 
-} // namespace FVMCode
\ No newline at end of file
+void UnstructuredMeshParser::build_compact_mesh (
+    CompactMesh &compact_mesh) const
+{
+    using label = CompactMesh::label;
+
+    const unsigned int n_points = mesh.n_points ();
+    const unsigned int n_faces  = mesh.n_faces ();
+    const unsigned int n_cells  = mesh.n_cells ();
+
+    compact_mesh.boundaries.clear ();
+    for (const BoundaryPatch &patch : mesh.boundaries)
+        compact_mesh.boundaries.push_back (patch);
+
+    // Points
+    for (unsigned int d = 0; d < 3; d++)
+    {
+        compact_mesh.points_[d].resize (n_points);
+        for (unsigned int p = 0; p < n_points; p++)
+            compact_mesh.points_[d][p] = mesh.point_list[p](d);
+    }
+
+    // Face topology. Sizes are counted first so that every array is
+    // allocated exactly once.
+    unsigned int n_internal_faces = 0;
+    unsigned int n_face_vertices  = 0;
+    for (const Face<3> &face : mesh.face_list)
+    {
+        if (!face.is_boundary ())
+            n_internal_faces++;
+        n_face_vertices += face.n_vertices ();
+    }
+
+    compact_mesh.owner_.resize (n_faces);
+    compact_mesh.neighbour_.resize (n_internal_faces);
+    compact_mesh.face_offsets_.resize (n_faces + 1);
+    compact_mesh.face_vertices_.resize (n_face_vertices);
+    compact_mesh.face_offsets_[0] = 0;
+    for (unsigned int f = 0; f < n_faces; f++)
+    {
+        const Face<3> &face = mesh.face_list[f];
+        AssertThrow (face.is_boundary () == (f >= n_internal_faces),
+                     std::runtime_error ("Internal faces must be numbered "
+                                         "before boundary faces"));
+
+        compact_mesh.owner_[f] = face.neighbour_list[0];
+        if (!face.is_boundary ())
+            compact_mesh.neighbour_[f] = face.neighbour_list[1];
+
+        label offset = compact_mesh.face_offsets_[f];
+        for (const auto &vertex : face.vertex_list)
+            compact_mesh.face_vertices_[offset++]
+                = vertex - mesh.point_list.begin ();
+        compact_mesh.face_offsets_[f + 1] = offset;
+    }
+
+    // Cell topology
+    unsigned int n_cell_faces = 0;
+    for (const Cell<3> &cell : mesh.cell_list)
+        n_cell_faces += cell.face_list.size ();
+
+    compact_mesh.cell_offsets_.resize (n_cells + 1);
+    compact_mesh.cell_faces_.resize (n_cell_faces);
+    compact_mesh.cell_offsets_[0] = 0;
+    for (unsigned int c = 0; c < n_cells; c++)
+    {
+        label offset = compact_mesh.cell_offsets_[c];
+        for (const auto &face : mesh.cell_list[c].face_list)
+            compact_mesh.cell_faces_[offset++] = face - mesh.face_list.begin ();
+        compact_mesh.cell_offsets_[c + 1] = offset;
+    }
+
+    // Face geometry
+    for (unsigned int d = 0; d < 3; d++)
+    {
+        compact_mesh.area_vecs_[d].resize (n_faces);
+        compact_mesh.face_centers_[d].resize (n_faces);
+    }
+    compact_mesh.face_areas_.resize (n_faces);
+    compact_mesh.deltas_.resize (n_faces);
+    compact_mesh.interpolation_factors_.resize (n_faces);
+    for (unsigned int f = 0; f < n_faces; f++)
+    {
+        const Face<3> &face = mesh.face_list[f];
+        for (unsigned int d = 0; d < 3; d++)
+        {
+            compact_mesh.area_vecs_[d][f]    = face.area_vec (d);
+            compact_mesh.face_centers_[d][f] = face.centroid (d);
+        }
+        compact_mesh.face_areas_[f]            = face.scalar_area;
+        compact_mesh.deltas_[f]                = face.delta_;
+        compact_mesh.interpolation_factors_[f] = face.interpolation_factor_;
+    }
+
+    // Cell geometry
+    for (unsigned int d = 0; d < 3; d++)
+        compact_mesh.cell_centers_[d].resize (n_cells);
+    compact_mesh.cell_volumes_.resize (n_cells);
+    for (unsigned int c = 0; c < n_cells; c++)
+    {
+        const Cell<3> &cell = mesh.cell_list[c];
+        for (unsigned int d = 0; d < 3; d++)
+            compact_mesh.cell_centers_[d][c] = cell.centroid (d);
+        compact_mesh.cell_volumes_[c] = cell.volume_;
+    }
+}
+
+} // namespace FVMCode
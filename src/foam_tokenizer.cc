@@ -0,0 +1,195 @@
+#include <FVMCode/foam_tokenizer.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace FVMCode
+{
+namespace Input
+{
+
+FoamTokenizer::FoamTokenizer (std::string_view buffer,
+                              const std::string &name)
+    : begin (buffer.data ())
+    , cursor (buffer.data ())
+    , end (buffer.data () + buffer.size ())
+    , name (name)
+{
+}
+
+FoamHeader FoamTokenizer::read_foam_header ()
+{
+    FoamHeader  header;
+    const char *start = cursor;
+    if (peek () == '\0' || read_word () != "FoamFile")
+    {
+        // There is no header
+        cursor = start;
+        return header;
+    }
+    header.present = true;
+
+    expect ('{');
+    while (peek () != '}')
+    {
+        if (peek () == '\0')
+            error ("end of file reached before FoamFile dictionary closed");
+        const std::string_view keyword = read_word ();
+        if (peek () == '{')
+        {
+            // A sub-dictionary, which none of the entries we need are
+            skip_entry_or_dictionary ();
+            continue;
+        }
+        if (keyword == "format")
+        {
+            const std::string_view format = read_word ();
+            if (format == "binary")
+                header.binary = true;
+            else if (format != "ascii")
+                error ("unknown format '" + std::string (format) + "'");
+        }
+        else if (keyword == "class")
+            header.class_name = read_word ();
+        else if (keyword == "arch")
+        {
+            const std::string_view arch = read_word ();
+            // Entries are separated by semicolons
+            std::size_t entry_begin = 0;
+            while (entry_begin <= arch.size ())
+            {
+                std::size_t entry_end = arch.find (';', entry_begin);
+                if (entry_end == std::string_view::npos)
+                    entry_end = arch.size ();
+                const std::string_view entry
+                    = arch.substr (entry_begin, entry_end - entry_begin);
+                entry_begin = entry_end + 1;
+
+                unsigned int *bits = nullptr;
+                if (entry == "MSB")
+                    error ("big endian binary data is not supported");
+                else if (entry.substr (0, 6) == "label=")
+                    bits = &header.label_bits;
+                else if (entry.substr (0, 7) == "scalar=")
+                    bits = &header.scalar_bits;
+                if (bits != nullptr)
+                {
+                    const char *value = entry.data () + entry.find ('=') + 1;
+                    if (std::from_chars (value, entry.data () + entry.size (),
+                                         *bits)
+                            .ec
+                        != std::errc ())
+                        error ("malformed arch entry");
+                }
+            }
+            if (header.label_bits != 32 && header.label_bits != 64)
+                error ("labels must be 32 or 64 bit");
+            if (header.scalar_bits != 64)
+                error ("only 64 bit scalars are supported");
+        }
+        skip_entry ();
+    }
+    expect ('}');
+    return header;
+}
+
+std::string_view FoamTokenizer::read_word ()
+{
+    skip_whitespace_and_comments ();
+    if (cursor != end && *cursor == '"')
+    {
+        const char *start = ++cursor;
+        while (cursor != end && *cursor != '"') ++cursor;
+        if (cursor == end)
+            error ("unterminated string");
+        return std::string_view (start, cursor++ - start);
+    }
+
+    const char *start = cursor;
+    while (cursor != end && !is_space (*cursor) && *cursor != ';'
+           && *cursor != '(' && *cursor != ')' && *cursor != '{'
+           && *cursor != '}')
+        ++cursor;
+    if (cursor == start)
+        error ("expected a word");
+    return std::string_view (start, cursor - start);
+}
+
+void FoamTokenizer::skip_entry_or_dictionary ()
+{
+    if (peek () != '{')
+    {
+        skip_entry ();
+        return;
+    }
+    unsigned int depth = 0;
+    do
+    {
+        skip_whitespace_and_comments ();
+        if (cursor == end)
+            error ("end of file reached inside a dictionary");
+        if (*cursor == '"')
+        {
+            read_word ();
+            continue;
+        }
+        if (*cursor == '{')
+            depth++;
+        else if (*cursor == '}')
+            depth--;
+        ++cursor;
+    } while (depth > 0);
+}
+
+void FoamTokenizer::skip_entry ()
+{
+    unsigned int depth = 0;
+    while (true)
+    {
+        skip_whitespace_and_comments ();
+        if (cursor == end)
+            error ("end of file reached inside an entry");
+        const char c = *cursor++;
+        if (c == '(' || c == '{')
+            depth++;
+        else if ((c == ')' || c == '}') && depth > 0)
+            depth--;
+        else if (c == ';' && depth == 0)
+            return;
+        else if (c == '"')
+        {
+            while (cursor != end && *cursor != '"') ++cursor;
+            if (cursor != end)
+                ++cursor;
+        }
+    }
+}
+
+void FoamTokenizer::skip_comment ()
+{
+    if (end - cursor < 2 || (cursor[1] != '/' && cursor[1] != '*'))
+        error ("unexpected '/'");
+
+    if (cursor[1] == '/')
+    {
+        cursor = std::find (cursor + 2, end, '\n');
+        return;
+    }
+
+    // Block comment
+    const std::string_view rest (cursor + 2, end - cursor - 2);
+    const std::size_t      close = rest.find ("*/");
+    if (close == std::string_view::npos)
+        error ("unfinished block comment");
+    cursor += 2 + close + 2;
+}
+
+void FoamTokenizer::error (const std::string &what) const
+{
+    const unsigned int line = 1 + std::count (begin, cursor, '\n');
+    throw std::runtime_error ("Error reading " + name + " at line "
+                              + std::to_string (line) + ": " + what);
+}
+
+} // namespace Input
+} // namespace FVMCode
@@ -0,0 +1,127 @@
+#include <FVMCode/exceptions.h>
+#include <FVMCode/input_file.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace FVMCode
+{
+namespace Input
+{
+
+InputFile::InputFile (const std::string &filename,
+                      const bool         decompress_in_background)
+    : path_ (filename)
+{
+    if (std::filesystem::exists (filename)
+        || !std::filesystem::exists (filename + ".gz"))
+    {
+        // Throws if the file does not exist
+        mapped_file.emplace (filename);
+        return;
+    }
+
+    path_ = filename + ".gz";
+    // The compressed file is mapped by the decompressing thread itself, so
+    // that opening a file costs the caller nothing
+    auto decompress = [this] {
+        const MappedFile compressed (path_);
+        decompressed = gunzip (compressed.view (), path_);
+    };
+    if (decompress_in_background)
+        decompression = std::async (std::launch::async, decompress).share ();
+    else
+        decompress ();
+}
+
+InputFile::~InputFile ()
+{
+    // The decompressing thread writes to members of this object
+    if (decompression.valid ())
+        decompression.wait ();
+}
+
+std::string_view InputFile::view () const
+{
+    if (mapped_file)
+        return mapped_file->view ();
+    if (decompression.valid ())
+        decompression.get ();
+    return decompressed;
+}
+
+std::string gunzip (std::string_view compressed, const std::string &file_name)
+{
+    std::string output;
+    // The last four bytes of a gzip member hold the size of the
+    // uncompressed data modulo 2^32, which is exact for a single member
+    // smaller than 4 GB. It is only used as a first guess of the size.
+    if (compressed.size () >= 18)
+    {
+        std::uint32_t size;
+        std::memcpy (&size, compressed.data () + compressed.size () - 4, 4);
+        output.resize (std::max<std::size_t> (size, 1));
+    }
+    else
+        output.resize (1 << 16);
+
+    z_stream stream {};
+    // 15 + 32 accepts gzip and zlib headers with the largest window
+    AssertThrow (inflateInit2 (&stream, 15 + 32) == Z_OK,
+                 std::runtime_error ("Could not initialise zlib"));
+    std::unique_ptr<z_stream, int (*) (z_stream *)> guard (&stream,
+                                                           inflateEnd);
+
+    stream.next_in = reinterpret_cast<Bytef *> (
+        const_cast<char *> (compressed.data ()));
+    std::size_t n_unread  = compressed.size ();
+    std::size_t n_written = 0;
+    while (true)
+    {
+        // avail_in is 32 bit as well, so the input is passed in pieces too.
+        // next_in has already advanced past the used up piece.
+        if (stream.avail_in == 0 && n_unread > 0)
+        {
+            stream.avail_in = std::min<std::size_t> (n_unread, 1u << 30);
+            n_unread -= stream.avail_in;
+        }
+        if (n_written == output.size ())
+            output.resize (2 * output.size ());
+        // avail_out is 32 bit, so very large outputs are filled in pieces
+        const std::size_t n_free = std::min<std::size_t> (
+            output.size () - n_written, 1u << 30);
+        stream.next_out  = reinterpret_cast<Bytef *> (&output[n_written]);
+        stream.avail_out = n_free;
+
+        const int status = inflate (&stream, Z_NO_FLUSH);
+        n_written += n_free - stream.avail_out;
+        if (status == Z_STREAM_END)
+        {
+            // Files may consist of several concatenated gzip members
+            if (stream.avail_in == 0 && n_unread == 0)
+                break;
+            AssertThrow (inflateReset (&stream) == Z_OK,
+                         std::runtime_error ("Could not reset zlib"));
+        }
+        else if (status == Z_OK || status == Z_BUF_ERROR)
+        {
+            // inflate only stops with space left in the output once it has
+            // used up the piece of input it was given
+            AssertThrow (stream.avail_out == 0 || n_unread > 0,
+                         std::runtime_error ("Truncated gzip data in "
+                                             + file_name));
+        }
+        else
+            AssertThrow (false, std::runtime_error ("Corrupt gzip data in "
+                                                    + file_name));
+    }
+    output.resize (n_written);
+    return output;
+}
+
+} // namespace Input
+} // namespace FVMCode
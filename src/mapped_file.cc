@@ -0,0 +1,80 @@
+#include <FVMCode/exceptions.h>
+#include <FVMCode/mapped_file.h>
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace FVMCode
+{
+namespace Input
+{
+
+MappedFile::MappedFile (const std::string &filename)
+    : data_ (nullptr)
+    , size_ (0)
+{
+    const int fd = ::open (filename.c_str (), O_RDONLY);
+    AssertThrow (fd >= 0,
+                 std::runtime_error ("Could not open file " + filename));
+
+    struct stat file_stat;
+    if (::fstat (fd, &file_stat) != 0)
+    {
+        ::close (fd);
+        AssertThrow (false,
+                     std::runtime_error ("Could not stat file " + filename));
+    }
+    size_ = file_stat.st_size;
+
+    // mmap does not accept empty mappings, so an empty file is simply an
+    // empty view
+    if (size_ > 0)
+    {
+        void *address = ::mmap (nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close (fd);
+        AssertThrow (address != MAP_FAILED,
+                     std::runtime_error ("Could not map file " + filename));
+        // The parsers read files front to back
+        ::madvise (address, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char *> (address);
+    }
+    else
+        ::close (fd);
+}
+
+MappedFile::~MappedFile () { unmap (); }
+
+MappedFile::MappedFile (MappedFile &&other) noexcept
+    : data_ (other.data_)
+    , size_ (other.size_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile &MappedFile::operator= (MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        unmap ();
+        data_       = other.data_;
+        size_       = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+void MappedFile::unmap ()
+{
+    if (data_ != nullptr)
+        ::munmap (const_cast<char *> (data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+}
+
+} // namespace Input
+} // namespace FVMCode
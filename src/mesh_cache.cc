@@ -0,0 +1,428 @@
+#include <FVMCode/exceptions.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/mapped_file.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+// Reading and writing of the binary mesh cache of UnstructuredMeshParser.
+//
+// A cache file consists of a Header followed by these arrays, each padded to
+// a multiple of 8 bytes so that every array is suitably aligned in the
+// mapped file:
+//
+//   points                3 * n_points doubles (x, y, z of each point)
+//   face vertex offsets   n_faces + 1 uint32
+//   face vertices         n_face_vertices uint32
+//   face owners           n_faces uint32
+//   face neighbours       n_faces uint32, no_neighbour for boundary faces
+//   face area vectors     3 * n_faces doubles
+//   face centroids        3 * n_faces doubles
+//   face areas            n_faces doubles
+//   face deltas           n_faces doubles
+//   face weights          n_faces doubles (interpolation factors)
+//   cell face offsets     n_cells + 1 uint32
+//   cell faces            n_cell_faces uint32
+//   cell centroids        3 * n_cells doubles
+//   cell volumes          n_cells doubles
+//   boundary patches      patch_bytes bytes: per patch the type, number of
+//                         faces, start face and name length as uint32,
+//                         followed by the name
+//
+// The sizes and modification times of the polyMesh files the cache was
+// written from are stored in the header, and the cache is only used if they
+// match the files on disk. The version is incremented whenever the layout
+// changes.
+
+namespace FVMCode
+{
+
+namespace
+{
+constexpr char          magic[8]     = "FVMMESH";
+constexpr std::uint32_t version      = 1;
+constexpr std::uint32_t byte_order   = 0x01020304;
+constexpr std::uint32_t no_neighbour
+    = std::numeric_limits<std::uint32_t>::max ();
+constexpr unsigned int  n_sources    = 5;
+
+struct SourceStamp
+{
+    std::uint64_t size;
+    std::int64_t  modification_time;
+
+    bool operator== (const SourceStamp &other) const
+    {
+        return size == other.size
+               && modification_time == other.modification_time;
+    }
+};
+
+struct Header
+{
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t n_points;
+    std::uint64_t n_faces;
+    std::uint64_t n_face_vertices;
+    std::uint64_t n_cells;
+    std::uint64_t n_cell_faces;
+    std::uint64_t n_patches;
+    std::uint64_t patch_bytes;
+    SourceStamp   sources[n_sources];
+};
+
+// Stamps the file actually read for filename, which may be filename.gz
+SourceStamp stamp (const std::string &filename)
+{
+    namespace fs     = std::filesystem;
+    std::string path = filename;
+    if (!fs::exists (path) && fs::exists (path + ".gz"))
+        path += ".gz";
+    std::error_code   error;
+    const SourceStamp result
+        = { fs::file_size (path, error),
+            fs::last_write_time (path, error).time_since_epoch ().count () };
+    if (error)
+        return { 0, 0 };
+    return result;
+}
+
+constexpr std::size_t padded (const std::size_t n_bytes)
+{
+    return (n_bytes + 7) / 8 * 8;
+}
+
+// Size of the arrays described by header
+std::size_t payload_size (const Header &header)
+{
+    const std::size_t d = sizeof (double), l = sizeof (std::uint32_t);
+    return padded (3 * header.n_points * d)
+           + padded ((header.n_faces + 1) * l)
+           + padded (header.n_face_vertices * l)
+           + 2 * padded (header.n_faces * l)
+           + 2 * padded (3 * header.n_faces * d)
+           + 3 * padded (header.n_faces * d)
+           + padded ((header.n_cells + 1) * l)
+           + padded (header.n_cell_faces * l) + padded (3 * header.n_cells * d)
+           + padded (header.n_cells * d) + padded (header.patch_bytes);
+}
+
+// Hands out consecutive arrays of a mapped cache file
+class ArrayReader
+{
+  public:
+    ArrayReader (const char *data)
+        : cursor (data)
+    {
+    }
+
+    template <typename T> const T *next (const std::size_t n)
+    {
+        const T *array = reinterpret_cast<const T *> (cursor);
+        cursor += padded (n * sizeof (T));
+        return array;
+    }
+
+  private:
+    const char *cursor;
+};
+
+// Writes consecutive arrays of a cache file
+class ArrayWriter
+{
+  public:
+    ArrayWriter (std::ofstream &out)
+        : out (out)
+    {
+    }
+
+    template <typename T> void write (const std::vector<T> &data)
+    {
+        out.write (reinterpret_cast<const char *> (data.data ()),
+                   data.size () * sizeof (T));
+        pad (data.size () * sizeof (T));
+    }
+
+    void pad (const std::size_t n_bytes)
+    {
+        const char zeros[8] = {};
+        out.write (zeros, padded (n_bytes) - n_bytes);
+    }
+
+  private:
+    std::ofstream &out;
+};
+} // namespace
+
+bool UnstructuredMeshParser::read_cache (
+    const std::string              &cache_file,
+    const std::vector<std::string> &source_files)
+{
+    Assert (source_files.size () == n_sources, "Wrong number of files");
+    if (!std::filesystem::exists (cache_file))
+        return false;
+
+    const Input::MappedFile file (cache_file);
+    if (file.size () < sizeof (Header))
+        return false;
+    Header header;
+    std::memcpy (&header, file.data (), sizeof (Header));
+    if (std::memcmp (header.magic, magic, sizeof (magic)) != 0
+        || header.version != version || header.byte_order != byte_order
+        || file.size () != sizeof (Header) + payload_size (header))
+        return false;
+    for (unsigned int s = 0; s < n_sources; s++)
+        if (!(header.sources[s] == stamp (source_files[s])))
+            return false;
+
+    ArrayReader arrays (file.data () + sizeof (Header));
+    const double *points = arrays.next<double> (3 * header.n_points);
+    const std::uint32_t *face_offsets
+        = arrays.next<std::uint32_t> (header.n_faces + 1);
+    const std::uint32_t *face_vertices
+        = arrays.next<std::uint32_t> (header.n_face_vertices);
+    const std::uint32_t *owner = arrays.next<std::uint32_t> (header.n_faces);
+    const std::uint32_t *neighbour
+        = arrays.next<std::uint32_t> (header.n_faces);
+    const double *area_vectors = arrays.next<double> (3 * header.n_faces);
+    const double *face_centers = arrays.next<double> (3 * header.n_faces);
+    const double *areas        = arrays.next<double> (header.n_faces);
+    const double *deltas       = arrays.next<double> (header.n_faces);
+    const double *weights      = arrays.next<double> (header.n_faces);
+    const std::uint32_t *cell_offsets
+        = arrays.next<std::uint32_t> (header.n_cells + 1);
+    const std::uint32_t *cell_faces
+        = arrays.next<std::uint32_t> (header.n_cell_faces);
+    const double *cell_centers = arrays.next<double> (3 * header.n_cells);
+    const double *volumes      = arrays.next<double> (header.n_cells);
+    const char   *patches      = arrays.next<char> (header.patch_bytes);
+
+    // The cache passed the checks above, so from here on it is trusted up
+    // to cheap bounds checks that keep a damaged file from causing
+    // out-of-bounds accesses
+    AssertThrow (face_offsets[header.n_faces] == header.n_face_vertices
+                     && cell_offsets[header.n_cells] == header.n_cell_faces,
+                 std::runtime_error ("Damaged mesh cache " + cache_file));
+
+    mesh.point_list.resize (header.n_points);
+    for (unsigned int p = 0; p < header.n_points; p++)
+        mesh.point_list[p]
+            = Point<3> (points[3 * p], points[3 * p + 1], points[3 * p + 2]);
+
+    // The internal faces come first, which SparsityPattern and the
+    // operators rely on
+    unsigned int n_internal_faces = 0;
+    mesh.face_list.reserve (header.n_faces);
+    std::vector<UnstructuredMesh::PointIterator> vertices;
+    for (unsigned int f = 0; f < header.n_faces; f++)
+    {
+        AssertThrow (owner[f] < header.n_cells
+                         && (neighbour[f] == no_neighbour
+                             || (neighbour[f] < header.n_cells
+                                 && n_internal_faces == f)),
+                     std::runtime_error ("Damaged mesh cache " + cache_file));
+        if (neighbour[f] != no_neighbour)
+            n_internal_faces++;
+        vertices.clear ();
+        for (unsigned int v = face_offsets[f]; v < face_offsets[f + 1]; v++)
+        {
+            AssertThrow (v < header.n_face_vertices
+                             && face_vertices[v] < header.n_points,
+                         std::runtime_error ("Damaged mesh cache "
+                                             + cache_file));
+            vertices.push_back (mesh.get_point (face_vertices[v]));
+        }
+        Face<3> face (vertices,
+                      Point<3> (area_vectors[3 * f], area_vectors[3 * f + 1],
+                                area_vectors[3 * f + 2]),
+                      Point<3> (face_centers[3 * f], face_centers[3 * f + 1],
+                                face_centers[3 * f + 2]),
+                      areas[f]);
+        face.neighbour_list.push_back (owner[f]);
+        if (neighbour[f] != no_neighbour)
+            face.neighbour_list.push_back (neighbour[f]);
+        face.delta_                = deltas[f];
+        face.interpolation_factor_ = weights[f];
+        mesh.face_list.push_back (std::move (face));
+    }
+
+    mesh.cell_list.reserve (header.n_cells);
+    std::vector<UnstructuredMesh::FaceIterator> faces;
+    for (unsigned int c = 0; c < header.n_cells; c++)
+    {
+        faces.clear ();
+        for (unsigned int f = cell_offsets[c]; f < cell_offsets[c + 1]; f++)
+        {
+            AssertThrow (f < header.n_cell_faces
+                             && cell_faces[f] < header.n_faces,
+                         std::runtime_error ("Damaged mesh cache "
+                                             + cache_file));
+            faces.push_back (mesh.get_face (cell_faces[f]));
+        }
+        mesh.cell_list.push_back (Cell<3> (
+            faces,
+            Point<3> (cell_centers[3 * c], cell_centers[3 * c + 1],
+                      cell_centers[3 * c + 2]),
+            volumes[c]));
+    }
+
+    const char *patch = patches;
+    const char *end   = patches + header.patch_bytes;
+    for (unsigned int p = 0; p < header.n_patches; p++)
+    {
+        std::uint32_t fields[4];
+        AssertThrow (static_cast<std::size_t> (end - patch) >= sizeof (fields),
+                     std::runtime_error ("Damaged mesh cache " + cache_file));
+        std::memcpy (fields, patch, sizeof (fields));
+        patch += sizeof (fields);
+        AssertThrow (fields[3] <= static_cast<std::size_t> (end - patch)
+                         && (fields[0] == wall || fields[0] == empty)
+                         && fields[2] <= header.n_faces
+                         && fields[1] <= header.n_faces - fields[2]
+                         && (p > 0 || fields[2] == n_internal_faces),
+                     std::runtime_error ("Damaged mesh cache " + cache_file));
+        mesh.boundaries.push_back (
+            BoundaryPatch (std::string (patch, fields[3]),
+                           static_cast<BoundaryType> (fields[0]), fields[1],
+                           fields[2]));
+        patch += fields[3];
+    }
+    return true;
+}
+
+void UnstructuredMeshParser::write_cache (
+    const std::string              &cache_file,
+    const std::vector<std::string> &source_files) const
+{
+    Assert (source_files.size () == n_sources, "Wrong number of files");
+
+    Header header {};
+    std::memcpy (header.magic, magic, sizeof (magic));
+    header.version         = version;
+    header.byte_order      = byte_order;
+    header.n_points        = mesh.n_points ();
+    header.n_faces         = mesh.n_faces ();
+    header.n_cells         = mesh.n_cells ();
+    header.n_patches       = mesh.boundaries.size ();
+    header.n_face_vertices = 0;
+    for (const Face<3> &face : mesh.face_list)
+        header.n_face_vertices += face.n_vertices ();
+    header.n_cell_faces = 0;
+    for (const Cell<3> &cell : mesh.cell_list)
+        header.n_cell_faces += cell.face_list.size ();
+    header.patch_bytes = 0;
+    for (const BoundaryPatch &patch : mesh.boundaries)
+        header.patch_bytes += 4 * sizeof (std::uint32_t) + patch.name.size ();
+    for (unsigned int s = 0; s < n_sources; s++)
+        header.sources[s] = stamp (source_files[s]);
+
+    // Written to a temporary file that is renamed at the end, so that a
+    // reader never sees a partly written cache
+    const std::string temporary_file = cache_file + ".tmp";
+    {
+        std::ofstream out (temporary_file, std::ios::binary);
+        if (!out)
+        {
+            std::cerr << "WARNING: could not write mesh cache " << cache_file
+                      << std::endl;
+            return;
+        }
+        out.write (reinterpret_cast<const char *> (&header), sizeof (header));
+        ArrayWriter arrays (out);
+
+        const auto &faces = mesh.face_list;
+        const auto &cells = mesh.cell_list;
+
+        std::vector<double> doubles;
+        auto                push_point = [&] (const Point<3> &point) {
+            for (unsigned int d = 0; d < 3; d++) doubles.push_back (point (d));
+        };
+        std::vector<std::uint32_t> labels;
+
+        for (const Point<3> &point : mesh.point_list) push_point (point);
+        arrays.write (doubles);
+
+        labels.assign (1, 0);
+        for (const Face<3> &face : faces)
+            labels.push_back (labels.back () + face.n_vertices ());
+        arrays.write (labels);
+        labels.clear ();
+        for (const Face<3> &face : faces)
+            for (const auto &vertex : face.vertex_list)
+                labels.push_back (vertex - mesh.point_list.begin ());
+        arrays.write (labels);
+        labels.clear ();
+        for (const Face<3> &face : faces)
+            labels.push_back (face.neighbour_list[0]);
+        arrays.write (labels);
+        labels.clear ();
+        for (const Face<3> &face : faces)
+            labels.push_back (face.is_boundary () ? no_neighbour
+                                                  : face.neighbour_list[1]);
+        arrays.write (labels);
+
+        doubles.clear ();
+        for (const Face<3> &face : faces) push_point (face.area_vec);
+        arrays.write (doubles);
+        doubles.clear ();
+        for (const Face<3> &face : faces) push_point (face.centroid);
+        arrays.write (doubles);
+        doubles.clear ();
+        for (const Face<3> &face : faces) doubles.push_back (face.scalar_area);
+        arrays.write (doubles);
+        doubles.clear ();
+        for (const Face<3> &face : faces) doubles.push_back (face.delta_);
+        arrays.write (doubles);
+        doubles.clear ();
+        for (const Face<3> &face : faces)
+            doubles.push_back (face.interpolation_factor_);
+        arrays.write (doubles);
+
+        labels.assign (1, 0);
+        for (const Cell<3> &cell : cells)
+            labels.push_back (labels.back () + cell.face_list.size ());
+        arrays.write (labels);
+        labels.clear ();
+        for (const Cell<3> &cell : cells)
+            for (const auto &face : cell.face_list)
+                labels.push_back (face - mesh.face_list.begin ());
+        arrays.write (labels);
+        doubles.clear ();
+        for (const Cell<3> &cell : cells) push_point (cell.centroid);
+        arrays.write (doubles);
+        doubles.clear ();
+        for (const Cell<3> &cell : cells) doubles.push_back (cell.volume_);
+        arrays.write (doubles);
+
+        for (const BoundaryPatch &patch : mesh.boundaries)
+        {
+            const std::uint32_t fields[4]
+                = { static_cast<std::uint32_t> (patch.type), patch.n_faces,
+                    patch.start_face,
+                    static_cast<std::uint32_t> (patch.name.size ()) };
+            out.write (reinterpret_cast<const char *> (fields),
+                       sizeof (fields));
+            out.write (patch.name.data (), patch.name.size ());
+        }
+        arrays.pad (header.patch_bytes);
+
+        if (!out)
+        {
+            std::cerr << "WARNING: could not write mesh cache " << cache_file
+                      << std::endl;
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename (temporary_file, cache_file, error);
+    if (error)
+        std::cerr << "WARNING: could not write mesh cache " << cache_file
+                  << std::endl;
+}
+
+} // namespace FVMCode
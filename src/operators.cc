@@ -0,0 +1,142 @@
+#include <FVMCode/operators.h>
+
+#include <stdexcept>
+
+namespace FVMCode
+{
+
+namespace Operators
+{
+
+namespace
+{
+// Calls function (face, boundary_field) for each face of the non-empty
+// patches
+template <typename Function>
+void for_each_boundary_face (UnstructuredMesh         &mesh,
+                             const BoundaryConditions &boundary_conditions,
+                             Function                &&function)
+{
+    AssertThrow (boundary_conditions.size () == mesh.n_boundary_patches (),
+                 std::invalid_argument ("Need one boundary condition per "
+                                        "boundary patch"));
+    for (unsigned int p = 0; p < mesh.n_boundary_patches (); p++)
+    {
+        const BoundaryPatch &patch = mesh.get_patches ()[p];
+        if (patch.type == empty)
+            continue;
+
+        const BoundaryFieldEntry &field = boundary_conditions[p].second;
+        AssertThrow (field.type == "fixedValue"
+                         || field.type == "zeroGradient",
+                     std::invalid_argument ("Boundary type " + field.type
+                                            + " of patch " + patch.name
+                                            + " not implemented"));
+        for (unsigned int f = patch.start_face;
+             f < patch.start_face + patch.n_faces; f++)
+            function (f, field);
+    }
+}
+} // namespace
+
+void ddt (SparseMatrix &matrix, VectorXd &rhs, UnstructuredMesh &mesh,
+          const VectorXd &old_field, const double dt)
+{
+    Assert (old_field.size () == static_cast<long> (mesh.n_cells ()),
+            "Field of wrong size");
+    for (unsigned int i = 0; i < mesh.n_cells (); i++)
+    {
+        const double a_P = mesh.get_cell (i)->volume () / dt;
+        matrix.add_diag (i, a_P);
+        rhs (i) += a_P * old_field (i);
+    }
+}
+
+void laplacian (SparseMatrix &matrix, VectorXd &rhs, UnstructuredMesh &mesh,
+                const BoundaryConditions &boundary_conditions,
+                const double              diffusivity)
+{
+    // Internal faces
+    for (unsigned int f = 0; f < mesh.get_patches ()[0].start_face; f++)
+    {
+        const auto &face = mesh.get_face (f);
+        Assert (!face->is_boundary (),
+                "Face should not be at boundary! Check face numbering.");
+
+        const double a_N = diffusivity * face->area () * face->delta ();
+        matrix.add_diag (face->neighbour_indices ()[0], a_N);
+        matrix.add_diag (face->neighbour_indices ()[1], a_N);
+        matrix.add_face (f, -a_N, -a_N);
+    }
+
+    // Boundary faces. Nothing is added for homogeneous Neumann conditions.
+    for_each_boundary_face (
+        mesh, boundary_conditions,
+        [&] (const unsigned int f, const BoundaryFieldEntry &field) {
+            if (field.type != "fixedValue")
+                return;
+            const auto        &face  = mesh.get_face (f);
+            const unsigned int owner = face->neighbour_indices ()[0];
+            const double a_N = diffusivity * face->area () * face->delta ();
+            matrix.add_diag (owner, a_N);
+            rhs (owner) += a_N * field.value;
+        });
+}
+
+void div (SparseMatrix &matrix, VectorXd &rhs, UnstructuredMesh &mesh,
+          const BoundaryConditions &boundary_conditions,
+          const Point<3> &velocity, const ConvectionScheme scheme)
+{
+    // Internal faces. The flux leaves the owner and enters the neighbour.
+    for (unsigned int f = 0; f < mesh.get_patches ()[0].start_face; f++)
+    {
+        const auto &face = mesh.get_face (f);
+        Assert (!face->is_boundary (),
+                "Face should not be at boundary! Check face numbering.");
+
+        const unsigned int owner     = face->neighbour_indices ()[0];
+        const unsigned int neighbour = face->neighbour_indices ()[1];
+        const double       face_flux = velocity.dot (face->area_vector ());
+
+        // Weight of the owner value in the face value
+        double w;
+        if (scheme == ConvectionScheme::upwind)
+            w = face_flux > 0. ? 1. : 0.;
+        else
+            w = face->interpolation_factor ();
+
+        matrix.add_diag (owner, face_flux * w);
+        matrix.add_diag (neighbour, -face_flux * (1 - w));
+        matrix.add_face (f, face_flux * (1 - w), -face_flux * w);
+    }
+
+    // Boundary faces
+    for_each_boundary_face (
+        mesh, boundary_conditions,
+        [&] (const unsigned int f, const BoundaryFieldEntry &field) {
+            const auto        &face  = mesh.get_face (f);
+            const unsigned int owner = face->neighbour_indices ()[0];
+            const double face_flux   = velocity.dot (face->area_vector ());
+            if (field.type == "fixedValue")
+                rhs (owner) -= face_flux * field.value;
+            else
+                matrix.add_diag (owner, face_flux);
+        });
+}
+
+void source (VectorXd &rhs, UnstructuredMesh &mesh, const unsigned int cell,
+             const double strength)
+{
+    AssertIndexRange (cell, mesh.n_cells ());
+    rhs (cell) += strength * mesh.get_cell (cell)->volume ();
+}
+
+void source (VectorXd &rhs, UnstructuredMesh &mesh, const double strength)
+{
+    for (unsigned int i = 0; i < mesh.n_cells (); i++)
+        rhs (i) += strength * mesh.get_cell (i)->volume ();
+}
+
+} // namespace Operators
+
+} // namespace FVMCode
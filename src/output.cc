@@ -2,24 +2,45 @@
 #include <FVMCode/exceptions.h>
 #include <FVMCode/output.h>
 
+#include <charconv>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 using Eigen::VectorXd;
 
 namespace FVMCode
 {
 
+namespace
+{
+// Longest output of std::to_chars for a double in its shortest round trip
+// form, e.g. -2.2250738585072014e-308
+constexpr std::size_t max_double_chars = 24;
+
+// The shortest representation of value that reads back exactly
+std::string exact_string (const double value)
+{
+    char buffer[max_double_chars];
+    const auto [end, ec] = std::to_chars (buffer, buffer + max_double_chars,
+                                          value);
+    Assert (ec == std::errc (), "Buffer too short");
+    return std::string (buffer, end);
+}
+} // namespace
+
 Outputter::Outputter (const unsigned int timestep_number, const double time,
                       const double dt, const double original_dt,
-                      const unsigned int file_name_precision)
+                      const unsigned int file_name_precision,
+                      const Format       format)
     : dir_name (name_from_time (time, file_name_precision))
     , time (time)
     , timestep_number (timestep_number)
     , dt (dt)
     , original_dt (original_dt)
+    , format (format)
 {
     init_directory ();
 }
@@ -38,13 +59,16 @@ void Outputter::init_directory ()
 }
 
 std::string Outputter::get_foam_header (std::string location,
-                                        std::string class_, std::string object)
+                                        std::string class_, std::string object,
+                                        const Format format)
 {
     std::stringstream header;
     header << "FoamFile" << std::endl
            << "{" << std::endl
            << "\tversion\t2.0;" << std::endl
-           << "\tformat\tascii;" << std::endl
+           << "\tformat\t"
+           << (format == Format::binary ? "binary" : "ascii") << ";"
+           << std::endl
            << "\tarch\t\"LSB;label=32;scalar=64\";" << std::endl
            << "\tclass\t" << class_ << ";" << std::endl
            << "\tlocation\t\"" << location << "\";" << std::endl
@@ -62,11 +86,14 @@ void Outputter::write_time ()
     std::ofstream outfile (uniform_dir / "time");
     outfile << get_foam_header (dir_name + "/uniform", "dictionary", "time");
 
-    outfile << "value\t" << time << ";" << std::endl << std::endl;
+    outfile << "value\t" << exact_string (time) << ";" << std::endl
+            << std::endl;
     outfile << "name\t\"" << dir_name << "\";" << std::endl << std::endl;
     outfile << "index\t" << timestep_number << ";" << std::endl << std::endl;
-    outfile << "deltaT\t" << dt << ";" << std::endl << std::endl;
-    outfile << "deltaT0\t" << original_dt << ";" << std::endl << std::endl;
+    outfile << "deltaT\t" << exact_string (dt) << ";" << std::endl
+            << std::endl;
+    outfile << "deltaT0\t" << exact_string (original_dt) << ";" << std::endl
+            << std::endl;
 
     outfile.close ();
 }
@@ -79,16 +106,33 @@ void Outputter::write_scalar_field (
 
     auto time_dir = std::filesystem::path (dir_name);
 
-    std::ofstream outfile (time_dir / name);
-    outfile << get_foam_header (dir_name, "volScalarField", name);
+    std::ofstream outfile (time_dir / name, std::ios::binary);
+    outfile << get_foam_header (dir_name, "volScalarField", name, format);
 
     outfile << "dimensions\t[0 0 0 0 0 0 0];" << std::endl << std::endl;
 
-    // Internal field
+    // Internal field, written as a single block
     outfile << "internalField\tnonuniform List<scalar>" << std::endl;
     outfile << scalar_field.size () << std::endl;
-    outfile << "(" << std::endl;
-    outfile << scalar_field << std::endl;
+    outfile << "(";
+    if (format == Format::binary)
+        outfile.write (reinterpret_cast<const char *> (scalar_field.data ()),
+                       scalar_field.size () * sizeof (double));
+    else
+    {
+        std::vector<char> buffer (1 + scalar_field.size ()
+                                          * (max_double_chars + 1));
+        char *cursor = buffer.data ();
+        *cursor++    = '\n';
+        for (unsigned int c = 0; c < scalar_field.size (); c++)
+        {
+            cursor = std::to_chars (cursor, cursor + max_double_chars,
+                                    scalar_field (c))
+                         .ptr;
+            *cursor++ = '\n';
+        }
+        outfile.write (buffer.data (), cursor - buffer.data ());
+    }
     outfile << ");" << std::endl;
 
     // Boundary field
@@ -98,11 +142,39 @@ void Outputter::write_scalar_field (
         outfile << "\t" << patch.name << std::endl << "\t{" << std::endl;
         outfile << "\t\ttype\t" << field.type << ";" << std::endl;
         if (field.type == "fixedValue")
-            outfile << "\t\tvalue\tuniform " << field.value << ";"
-                    << std::endl;
+            outfile << "\t\tvalue\tuniform " << exact_string (field.value)
+                    << ";" << std::endl;
         outfile << "\t}" << std::endl;
     }
     outfile << "}" << std::endl;
 }
 
-} // namespace FVMCode
\ No newline at end of file
+void Outputter::write_scalar_field (
+    const VectorXd &scalar_field, std::string name,
+    const BoundaryConditions        &boundary_conditions,
+    const std::vector<unsigned int> &original_cell_index)
+{
+    if (original_cell_index.empty ())
+    {
+        write_scalar_field (scalar_field, name, boundary_conditions);
+        return;
+    }
+
+    // The permutation comes from a renumbering chosen by the user, so it is
+    // checked in all builds
+    AssertThrow (original_cell_index.size ()
+                     == static_cast<std::size_t> (scalar_field.size ()),
+                 std::runtime_error (
+                     "Permutation and field have different sizes"));
+    VectorXd original_order (scalar_field.size ());
+    for (unsigned int c = 0; c < original_cell_index.size (); c++)
+    {
+        AssertThrow (original_cell_index[c] < original_cell_index.size (),
+                     std::runtime_error ("Cell index out of range in "
+                                         "permutation"));
+        original_order (original_cell_index[c]) = scalar_field (c);
+    }
+    write_scalar_field (original_order, name, boundary_conditions);
+}
+
+} // namespace FVMCode
@@ -0,0 +1,111 @@
+#include <FVMCode/cell_search_tree.h>
+#include <FVMCode/partitioning.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace FVMCode
+{
+
+MeshPartitioning::MeshPartitioning (UnstructuredMesh  &mesh,
+                                    const unsigned int n_partitions)
+    : cell_partition (mesh.n_cells ())
+    , partition_list (n_partitions)
+    , n_cut_faces (0)
+{
+    Assert (n_partitions > 0, "Need at least one partition");
+    Assert (n_partitions <= mesh.n_cells (),
+            "Cannot have more partitions than cells");
+
+    std::vector<Point<3> > centers (mesh.n_cells ());
+    for (unsigned int c = 0; c < mesh.n_cells (); c++)
+        centers[c] = mesh.get_cell (c)->center ();
+
+    std::vector<unsigned int> cells (mesh.n_cells ());
+    std::iota (cells.begin (), cells.end (), 0);
+    bisect (centers, cells, 0, cells.size (), 0, n_partitions);
+
+    for (unsigned int c = 0; c < mesh.n_cells (); c++)
+        partition_list[cell_partition[c]].cells.push_back (c);
+
+    for (unsigned int f = 0; f < mesh.n_faces (); f++)
+    {
+        const auto        &face  = mesh.get_face (f);
+        const unsigned int owner = face->neighbour_indices ()[0];
+        if (face->is_boundary ())
+        {
+            partition_list[cell_partition[owner]].boundary_faces.push_back (f);
+            continue;
+        }
+
+        const unsigned int neighbour = face->neighbour_indices ()[1];
+        const unsigned int p_owner   = cell_partition[owner];
+        const unsigned int p_neigh   = cell_partition[neighbour];
+        if (p_owner == p_neigh)
+        {
+            partition_list[p_owner].internal_faces.push_back (f);
+            continue;
+        }
+
+        n_cut_faces++;
+        partition_list[p_owner].interface_faces.push_back (f);
+        partition_list[p_neigh].interface_faces.push_back (f);
+        partition_list[p_owner].halo_cells.push_back (neighbour);
+        partition_list[p_neigh].halo_cells.push_back (owner);
+    }
+
+    for (Partition &partition : partition_list)
+    {
+        std::sort (partition.halo_cells.begin (), partition.halo_cells.end ());
+        partition.halo_cells.erase (std::unique (partition.halo_cells.begin (),
+                                                 partition.halo_cells.end ()),
+                                    partition.halo_cells.end ());
+    }
+}
+
+void MeshPartitioning::bisect (const std::vector<Point<3> > &centers,
+                               std::vector<unsigned int>    &cells,
+                               const unsigned int            begin,
+                               const unsigned int            end,
+                               const unsigned int            first_partition,
+                               const unsigned int            n_parts)
+{
+    if (n_parts == 1)
+    {
+        for (unsigned int i = begin; i < end; i++)
+            cell_partition[cells[i]] = first_partition;
+        return;
+    }
+
+    // Split the number of partitions as evenly as possible, and the cells
+    // in proportion, so that odd partition counts stay balanced
+    const unsigned int n_left_parts = n_parts / 2;
+    const unsigned int middle
+        = begin
+          + (unsigned long)(end - begin) * n_left_parts / n_parts;
+
+    BoundingBox box;
+    for (unsigned int i = begin; i < end; i++)
+        box.extend (centers[cells[i]]);
+    const unsigned int direction = box.longest_direction ();
+
+    std::nth_element (cells.begin () + begin, cells.begin () + middle,
+                      cells.begin () + end,
+                      [&] (const unsigned int a, const unsigned int b) {
+                          return centers[a](direction) < centers[b](direction);
+                      });
+
+    bisect (centers, cells, begin, middle, first_partition, n_left_parts);
+    bisect (centers, cells, middle, end, first_partition + n_left_parts,
+            n_parts - n_left_parts);
+}
+
+double MeshPartitioning::load_imbalance () const
+{
+    unsigned int max_cells = 0;
+    for (const Partition &partition : partition_list)
+        max_cells = std::max<unsigned int> (max_cells, partition.cells.size ());
+    return max_cells * (double)n_partitions () / cell_partition.size ();
+}
+
+} // namespace FVMCode
@@ -0,0 +1,478 @@
+#include <FVMCode/foam_tokenizer.h>
+#include <FVMCode/polymesh_reader.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace FVMCode
+{
+namespace Input
+{
+
+namespace
+{
+// Reads a list of labels, written as "n (l_0 l_1 ...)" in ASCII, or as n
+// followed by the raw labels between brackets in binary
+void read_label_list (FoamTokenizer &tokens, const FoamHeader &header,
+                      std::vector<unsigned int> &labels)
+{
+    const unsigned int n_labels = tokens.read_unsigned ();
+    labels.resize (n_labels);
+    tokens.expect ('(');
+    if (!header.binary)
+        for (unsigned int n = 0; n < n_labels; n++)
+            labels[n] = tokens.read_unsigned ();
+    else if (header.label_bits == 32)
+    {
+        static_assert (sizeof (unsigned int) == sizeof (std::int32_t));
+        std::memcpy (labels.data (),
+                     tokens.read_bytes (n_labels * sizeof (std::int32_t)),
+                     n_labels * sizeof (std::int32_t));
+        // Negative labels have the sign bit set
+        for (const unsigned int label : labels)
+            if (label > static_cast<unsigned int> (
+                    std::numeric_limits<std::int32_t>::max ()))
+                tokens.error ("label out of range");
+    }
+    else
+    {
+        const char *bytes
+            = tokens.read_bytes (std::size_t (n_labels) * sizeof (std::int64_t));
+        for (unsigned int n = 0; n < n_labels; n++)
+        {
+            std::int64_t label;
+            std::memcpy (&label, bytes + n * sizeof (std::int64_t),
+                         sizeof (std::int64_t));
+            // The same range as that of 32 bit labels
+            if (label < 0 || label > std::numeric_limits<std::int32_t>::max ())
+                tokens.error ("label out of range");
+            labels[n] = label;
+        }
+    }
+    tokens.expect (')');
+}
+
+// Splits the body of the list in buffer into at most pool.n_threads ()
+// chunks of at least min_chunk_size bytes. Returns an empty list if the file
+// should be read serially, either because it is small, because it is not an
+// ASCII list of the expected form or because the list could not be located.
+std::vector<std::string_view>
+split_list (std::string_view buffer, const std::string &file_name,
+            const bool entries_in_brackets, const Parallel::ThreadPool &pool,
+            const std::size_t min_chunk_size, unsigned int &n_entries)
+{
+    FoamTokenizer    tokens (buffer, file_name);
+    const FoamHeader header = tokens.read_foam_header ();
+    // Binary data is read with a memcpy anyway
+    if (header.binary || header.class_name == "faceCompactList")
+        return {};
+    n_entries = tokens.read_unsigned ();
+    tokens.expect ('(');
+    const std::size_t begin = tokens.position ();
+
+    // The list is closed by the last bracket of the file outside of the
+    // trailing // comment lines
+    std::size_t end       = std::string_view::npos;
+    std::size_t line_end  = buffer.size ();
+    while (line_end > begin && end == std::string_view::npos)
+    {
+        const std::size_t line_begin
+            = std::max (begin, buffer.rfind ('\n', line_end - 1) + 1);
+        std::string_view line
+            = buffer.substr (line_begin, line_end - line_begin);
+        line = line.substr (0, line.find ("//"));
+        const std::size_t bracket = line.rfind (')');
+        if (bracket != std::string_view::npos)
+            end = line_begin + bracket;
+        line_end = line_begin == 0 ? 0 : line_begin - 1;
+    }
+    if (end == std::string_view::npos)
+        return {};
+
+    const std::string_view body = buffer.substr (begin, end - begin);
+    const unsigned int     n_chunks
+        = std::min<std::size_t> (pool.n_threads (),
+                                 body.size () / std::max<std::size_t> (
+                                     min_chunk_size, 1));
+    if (n_chunks < 2)
+        return {};
+
+    // Chunks end at the end of a line. If entries are bracketed, the line
+    // must also end with a bracket, i.e. with the end of an entry.
+    std::vector<std::string_view> chunks;
+    std::size_t                   chunk_begin = 0;
+    for (unsigned int c = 1; c < n_chunks; c++)
+    {
+        std::size_t split
+            = std::max (chunk_begin, c * body.size () / n_chunks);
+        while (true)
+        {
+            split = body.find ('\n', split);
+            if (split == std::string_view::npos)
+                break;
+            if (!entries_in_brackets)
+                break;
+            std::size_t last = split;
+            while (last > chunk_begin
+                   && (body[last - 1] == ' ' || body[last - 1] == '\t'
+                       || body[last - 1] == '\r'))
+                last--;
+            if (last > chunk_begin && body[last - 1] == ')')
+                break;
+            split++;
+        }
+        if (split == std::string_view::npos)
+            break;
+        chunks.push_back (body.substr (chunk_begin, split - chunk_begin));
+        chunk_begin = split;
+    }
+    chunks.push_back (body.substr (chunk_begin));
+    return chunks;
+}
+
+// Reads each chunk with read_chunk (chunk, c) on the threads of pool
+template <typename Function>
+void read_chunks (const std::vector<std::string_view> &chunks,
+                  Parallel::ThreadPool &pool, Function &&read_chunk)
+{
+    pool.parallel_for (0, chunks.size (),
+                       [&] (const unsigned int begin, const unsigned int end) {
+                           for (unsigned int c = begin; c < end; c++)
+                               read_chunk (chunks[c], c);
+                       });
+}
+
+// Returns the exclusive prefix sum of the sizes of buffers
+template <typename Buffer>
+std::vector<std::size_t> prefix_sum (const std::vector<Buffer> &buffers)
+{
+    std::vector<std::size_t> offsets (buffers.size () + 1, 0);
+    for (unsigned int c = 0; c < buffers.size (); c++)
+        offsets[c + 1] = offsets[c] + buffers[c].size ();
+    return offsets;
+}
+} // namespace
+
+void read_points (std::string_view buffer, const std::string &file_name,
+                  std::vector<Point<3> > &points)
+{
+    FoamTokenizer    tokens (buffer, file_name);
+    const FoamHeader header = tokens.read_foam_header ();
+
+    const unsigned int n_points = tokens.read_unsigned ();
+    points.resize (n_points);
+    tokens.expect ('(');
+    if (header.binary)
+    {
+        // Point<3> may be padded, so the coordinates are copied point by
+        // point
+        const char *bytes
+            = tokens.read_bytes (std::size_t (n_points) * 3 * sizeof (double));
+        for (unsigned int n = 0; n < n_points; n++)
+            std::memcpy (&points[n](0), bytes + n * 3 * sizeof (double),
+                         3 * sizeof (double));
+    }
+    else
+        for (unsigned int n = 0; n < n_points; n++)
+        {
+            tokens.expect ('(');
+            const double x = tokens.read_double ();
+            const double y = tokens.read_double ();
+            const double z = tokens.read_double ();
+            tokens.expect (')');
+            points[n] = Point<3> (x, y, z);
+        }
+    tokens.expect (')');
+}
+
+void read_faces (std::string_view buffer, const std::string &file_name,
+                 std::vector<unsigned int> &face_offsets,
+                 std::vector<unsigned int> &face_vertices)
+{
+    FoamTokenizer    tokens (buffer, file_name);
+    const FoamHeader header = tokens.read_foam_header ();
+
+    if (header.class_name == "faceCompactList")
+    {
+        // The offsets of the faces into the list of vertices, followed by
+        // the list of vertices
+        read_label_list (tokens, header, face_offsets);
+        read_label_list (tokens, header, face_vertices);
+        if (face_offsets.empty () || face_offsets[0] != 0
+            || face_offsets.back () != face_vertices.size ())
+            tokens.error ("face offsets do not match face vertices");
+        for (unsigned int f = 0; f + 1 < face_offsets.size (); f++)
+            if (face_offsets[f + 1] < face_offsets[f] + 3)
+                tokens.error ("face with fewer than three vertices");
+        return;
+    }
+
+    if (header.binary)
+        tokens.error ("binary faces must be a faceCompactList");
+
+    const unsigned int n_faces = tokens.read_unsigned ();
+    face_offsets.resize (n_faces + 1);
+    face_offsets[0] = 0;
+    face_vertices.clear ();
+    // Most meshes are largely hexahedral
+    face_vertices.reserve (4 * n_faces);
+    tokens.expect ('(');
+    for (unsigned int n = 0; n < n_faces; n++)
+    {
+        const unsigned int n_vertices = tokens.read_unsigned ();
+        if (n_vertices < 3)
+            tokens.error ("face with fewer than three vertices");
+        tokens.expect ('(');
+        for (unsigned int v = 0; v < n_vertices; v++)
+            face_vertices.push_back (tokens.read_unsigned ());
+        tokens.expect (')');
+        face_offsets[n + 1] = face_vertices.size ();
+    }
+    tokens.expect (')');
+}
+
+void read_labels (std::string_view buffer, const std::string &file_name,
+                  std::vector<unsigned int> &labels)
+{
+    FoamTokenizer    tokens (buffer, file_name);
+    const FoamHeader header = tokens.read_foam_header ();
+    read_label_list (tokens, header, labels);
+}
+
+void read_boundaries (std::string_view buffer, const std::string &file_name,
+                      std::vector<BoundaryPatch> &boundaries)
+{
+    FoamTokenizer tokens (buffer, file_name);
+    tokens.skip_foam_header ();
+
+    const unsigned int n_patches = tokens.read_unsigned ();
+    boundaries.clear ();
+    boundaries.reserve (n_patches);
+    tokens.expect ('(');
+    for (unsigned int n = 0; n < n_patches; n++)
+    {
+        const std::string name (tokens.read_word ());
+        tokens.expect ('{');
+
+        std::string  type;
+        unsigned int n_faces    = 0;
+        unsigned int start_face = 0;
+        while (tokens.peek () != '}')
+        {
+            const std::string_view field = tokens.read_word ();
+            if (field == "type")
+            {
+                type = tokens.read_word ();
+                tokens.expect (';');
+            }
+            else if (field == "nFaces")
+            {
+                n_faces = tokens.read_unsigned ();
+                tokens.expect (';');
+            }
+            else if (field == "startFace")
+            {
+                start_face = tokens.read_unsigned ();
+                tokens.expect (';');
+            }
+            else
+                tokens.skip_entry ();
+        }
+        tokens.expect ('}');
+
+        if (string_to_type.find (type) == string_to_type.end ())
+            tokens.error ("unsupported type '" + type + "' of patch "
+                          + name);
+        boundaries.push_back (BoundaryPatch (name, type, n_faces, start_face));
+    }
+    tokens.expect (')');
+}
+
+void read_points (std::string_view buffer, const std::string &file_name,
+                  std::vector<Point<3> > &points, Parallel::ThreadPool &pool,
+                  const std::size_t min_chunk_size)
+{
+    unsigned int                        n_points;
+    const std::vector<std::string_view> chunks = split_list (
+        buffer, file_name, true, pool, min_chunk_size, n_points);
+    if (chunks.empty ())
+    {
+        read_points (buffer, file_name, points);
+        return;
+    }
+
+    try
+    {
+        std::vector<std::vector<Point<3> > > chunk_points (chunks.size ());
+        read_chunks (chunks, pool,
+                     [&] (std::string_view chunk, const unsigned int c) {
+                         FoamTokenizer tokens (chunk, file_name);
+                         while (!tokens.at_end ())
+                         {
+                             tokens.expect ('(');
+                             const double x = tokens.read_double ();
+                             const double y = tokens.read_double ();
+                             const double z = tokens.read_double ();
+                             tokens.expect (')');
+                             chunk_points[c].push_back (Point<3> (x, y, z));
+                         }
+                     });
+
+        const std::vector<std::size_t> offsets = prefix_sum (chunk_points);
+        if (offsets.back () != n_points)
+            throw std::runtime_error ("Wrong number of points");
+        points.resize (n_points);
+        read_chunks (chunks, pool, [&] (std::string_view, const unsigned c) {
+            std::copy (chunk_points[c].begin (), chunk_points[c].end (),
+                       points.begin () + offsets[c]);
+        });
+    }
+    catch (std::runtime_error &)
+    {
+        read_points (buffer, file_name, points);
+    }
+}
+
+void read_faces (std::string_view buffer, const std::string &file_name,
+                 std::vector<unsigned int> &face_offsets,
+                 std::vector<unsigned int> &face_vertices,
+                 Parallel::ThreadPool &pool, const std::size_t min_chunk_size)
+{
+    unsigned int                        n_faces;
+    const std::vector<std::string_view> chunks = split_list (
+        buffer, file_name, true, pool, min_chunk_size, n_faces);
+    if (chunks.empty ())
+    {
+        read_faces (buffer, file_name, face_offsets, face_vertices);
+        return;
+    }
+
+    try
+    {
+        // Per chunk, the number of vertices of each face and the vertices
+        std::vector<std::vector<unsigned int> > chunk_sizes (chunks.size ());
+        std::vector<std::vector<unsigned int> > chunk_vertices (
+            chunks.size ());
+        read_chunks (chunks, pool,
+                     [&] (std::string_view chunk, const unsigned int c) {
+                         FoamTokenizer tokens (chunk, file_name);
+                         while (!tokens.at_end ())
+                         {
+                             const unsigned int n_vertices
+                                 = tokens.read_unsigned ();
+                             if (n_vertices < 3)
+                                 tokens.error ("face with fewer than three "
+                                               "vertices");
+                             tokens.expect ('(');
+                             for (unsigned int v = 0; v < n_vertices; v++)
+                                 chunk_vertices[c].push_back (
+                                     tokens.read_unsigned ());
+                             tokens.expect (')');
+                             chunk_sizes[c].push_back (n_vertices);
+                         }
+                     });
+
+        const std::vector<std::size_t> face_starts = prefix_sum (chunk_sizes);
+        const std::vector<std::size_t> vertex_starts
+            = prefix_sum (chunk_vertices);
+        if (face_starts.back () != n_faces)
+            throw std::runtime_error ("Wrong number of faces");
+        face_offsets.resize (n_faces + 1);
+        face_offsets[0] = 0;
+        face_vertices.resize (vertex_starts.back ());
+        read_chunks (chunks, pool, [&] (std::string_view, const unsigned c) {
+            unsigned int offset = vertex_starts[c];
+            for (unsigned int f = 0; f < chunk_sizes[c].size (); f++)
+            {
+                offset += chunk_sizes[c][f];
+                face_offsets[face_starts[c] + f + 1] = offset;
+            }
+            std::copy (chunk_vertices[c].begin (), chunk_vertices[c].end (),
+                       face_vertices.begin () + vertex_starts[c]);
+        });
+    }
+    catch (std::runtime_error &)
+    {
+        read_faces (buffer, file_name, face_offsets, face_vertices);
+    }
+}
+
+void read_labels (std::string_view buffer, const std::string &file_name,
+                  std::vector<unsigned int> &labels, Parallel::ThreadPool &pool,
+                  const std::size_t min_chunk_size)
+{
+    unsigned int                        n_labels;
+    const std::vector<std::string_view> chunks = split_list (
+        buffer, file_name, false, pool, min_chunk_size, n_labels);
+    if (chunks.empty ())
+    {
+        read_labels (buffer, file_name, labels);
+        return;
+    }
+
+    try
+    {
+        std::vector<std::vector<unsigned int> > chunk_labels (chunks.size ());
+        read_chunks (chunks, pool,
+                     [&] (std::string_view chunk, const unsigned int c) {
+                         FoamTokenizer tokens (chunk, file_name);
+                         while (!tokens.at_end ())
+                             chunk_labels[c].push_back (
+                                 tokens.read_unsigned ());
+                     });
+
+        const std::vector<std::size_t> offsets = prefix_sum (chunk_labels);
+        if (offsets.back () != n_labels)
+            throw std::runtime_error ("Wrong number of labels");
+        labels.resize (n_labels);
+        read_chunks (chunks, pool, [&] (std::string_view, const unsigned c) {
+            std::copy (chunk_labels[c].begin (), chunk_labels[c].end (),
+                       labels.begin () + offsets[c]);
+        });
+    }
+    catch (std::runtime_error &)
+    {
+        read_labels (buffer, file_name, labels);
+    }
+}
+
+void build_cell_faces (const std::vector<unsigned int> &owner,
+                       const std::vector<unsigned int> &neighbour,
+                       std::vector<unsigned int>       &cell_offsets,
+                       std::vector<unsigned int>       &cell_faces)
+{
+    // Each cell has at least one face, so a larger label is not a cell but
+    // damaged input, which would make the offsets below overflow
+    const std::size_t n_labels = owner.size () + neighbour.size ();
+    unsigned int      n_cells  = 0;
+    for (const std::vector<unsigned int> *labels : { &owner, &neighbour })
+        for (const unsigned int cell : *labels)
+        {
+            AssertThrow (cell < n_labels,
+                         std::runtime_error ("Cell label out of range"));
+            n_cells = std::max (n_cells, cell + 1);
+        }
+
+    // The faces of cell c are counted in cell_offsets[c + 2], so that after
+    // the prefix sum cell_offsets[c + 1] is the first face of cell c. It is
+    // then incremented for each face of c, and ends up as the first face of
+    // cell c + 1.
+    cell_offsets.assign (n_cells + 2, 0);
+    for (const std::vector<unsigned int> *labels : { &owner, &neighbour })
+        for (const unsigned int cell : *labels)
+            cell_offsets[cell + 2]++;
+    for (unsigned int c = 2; c < n_cells + 2; c++)
+        cell_offsets[c] += cell_offsets[c - 1];
+
+    cell_faces.resize (owner.size () + neighbour.size ());
+    for (const std::vector<unsigned int> *labels : { &owner, &neighbour })
+        for (unsigned int f = 0; f < labels->size (); f++)
+            cell_faces[cell_offsets[(*labels)[f] + 1]++] = f;
+    cell_offsets.pop_back ();
+}
+
+} // namespace Input
+} // namespace FVMCode
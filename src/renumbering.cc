@@ -0,0 +1,281 @@
+#include <FVMCode/exceptions.h>
+#include <FVMCode/renumbering.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace FVMCode
+{
+namespace Renumbering
+{
+
+namespace
+{
+// Adjacency of a graph in compressed sparse row format
+struct Graph
+{
+    std::vector<unsigned int> offsets;
+    std::vector<unsigned int> neighbours;
+
+    unsigned int degree (const unsigned int node) const
+    {
+        return offsets[node + 1] - offsets[node];
+    }
+};
+
+Graph
+build_graph (const unsigned int                                         n_nodes,
+             const std::vector<std::pair<unsigned int, unsigned int> > &edges)
+{
+    Graph graph;
+    graph.offsets.assign (n_nodes + 1, 0);
+    for (const auto &[a, b] : edges)
+    {
+        graph.offsets[a + 1]++;
+        graph.offsets[b + 1]++;
+    }
+    for (unsigned int n = 0; n < n_nodes; n++)
+        graph.offsets[n + 1] += graph.offsets[n];
+
+    graph.neighbours.resize (graph.offsets[n_nodes]);
+    std::vector<unsigned int> fill (graph.offsets.begin (),
+                                    graph.offsets.end () - 1);
+    for (const auto &[a, b] : edges)
+    {
+        graph.neighbours[fill[a]++] = b;
+        graph.neighbours[fill[b]++] = a;
+    }
+    return graph;
+}
+
+// Breadth first traversal from start, visiting unvisited neighbours in order
+// of increasing degree. Appends the visited nodes to order, sets
+// last_level_begin to the position in order where the last level starts and
+// returns the number of levels.
+unsigned int
+cuthill_mckee_level_structure (const Graph &graph, const unsigned int start,
+                               std::vector<bool>         &visited,
+                               std::vector<unsigned int> &order,
+                               unsigned int              &last_level_begin)
+{
+    std::vector<unsigned int> candidates;
+    unsigned int              head     = order.size ();
+    unsigned int              n_levels = 0;
+
+    order.push_back (start);
+    visited[start] = true;
+    while (head < order.size ())
+    {
+        const unsigned int level_end = order.size ();
+        last_level_begin             = head;
+        for (; head < level_end; head++)
+        {
+            const unsigned int node = order[head];
+            candidates.clear ();
+            for (unsigned int i = graph.offsets[node];
+                 i < graph.offsets[node + 1]; i++)
+            {
+                const unsigned int neighbour = graph.neighbours[i];
+                if (!visited[neighbour])
+                {
+                    visited[neighbour] = true;
+                    candidates.push_back (neighbour);
+                }
+            }
+            std::sort (candidates.begin (), candidates.end (),
+                       [&] (const unsigned int a, const unsigned int b) {
+                           return graph.degree (a) < graph.degree (b)
+                                  || (graph.degree (a) == graph.degree (b)
+                                      && a < b);
+                       });
+            order.insert (order.end (), candidates.begin (),
+                          candidates.end ());
+        }
+        n_levels++;
+    }
+    return n_levels;
+}
+
+} // namespace
+
+std::vector<unsigned int> reverse_cuthill_mckee (
+    const unsigned int                                         n_nodes,
+    const std::vector<std::pair<unsigned int, unsigned int> > &edges)
+{
+    const Graph graph = build_graph (n_nodes, edges);
+
+    std::vector<unsigned int> order;
+    order.reserve (n_nodes);
+    std::vector<bool> visited (n_nodes, false);
+
+    // Scratch space for finding pseudo-peripheral nodes
+    std::vector<unsigned int> trial_order;
+    std::vector<bool>         trial_visited (n_nodes, false);
+
+    // Nodes sorted by degree, so each component starts from a low degree node
+    std::vector<unsigned int> by_degree (n_nodes);
+    for (unsigned int n = 0; n < n_nodes; n++)
+        by_degree[n] = n;
+    std::stable_sort (by_degree.begin (), by_degree.end (),
+                      [&] (const unsigned int a, const unsigned int b) {
+                          return graph.degree (a) < graph.degree (b);
+                      });
+
+    for (const unsigned int seed : by_degree)
+    {
+        if (visited[seed])
+            continue;
+
+        // Find a pseudo-peripheral node (George and Liu): repeatedly restart
+        // from the minimum degree node of the last level until the number of
+        // levels stops growing
+        unsigned int start    = seed;
+        unsigned int n_levels = 0;
+        unsigned int last_level_begin;
+        while (true)
+        {
+            trial_order.clear ();
+            const unsigned int levels = cuthill_mckee_level_structure (
+                graph, start, trial_visited, trial_order, last_level_begin);
+            for (const unsigned int node : trial_order)
+                trial_visited[node] = false;
+            if (levels <= n_levels)
+                break;
+            n_levels = levels;
+
+            // Minimum degree node of the last level, i.e. of the nodes
+            // furthest from start
+            unsigned int candidate = trial_order[last_level_begin];
+            for (unsigned int i = last_level_begin + 1; i < trial_order.size ();
+                 i++)
+                if (graph.degree (trial_order[i]) < graph.degree (candidate))
+                    candidate = trial_order[i];
+            if (candidate == start)
+                break;
+            start = candidate;
+        }
+
+        cuthill_mckee_level_structure (graph, start, visited, order,
+                                       last_level_begin);
+    }
+
+    Assert (order.size () == n_nodes, "Not all nodes have been numbered");
+    std::reverse (order.begin (), order.end ());
+    return order;
+}
+
+std::uint64_t morton_key (const std::uint32_t x, const std::uint32_t y,
+                          const std::uint32_t z)
+{
+    // Spreads the lower 21 bits of v out so there are two zero bits between
+    // each of them
+    auto spread = [] (std::uint64_t v) {
+        v &= 0x1fffff;
+        v = (v | v << 32) & 0x1f00000000ffff;
+        v = (v | v << 16) & 0x1f0000ff0000ff;
+        v = (v | v << 8) & 0x100f00f00f00f00f;
+        v = (v | v << 4) & 0x10c30c30c30c30c3;
+        v = (v | v << 2) & 0x1249249249249249;
+        return v;
+    };
+    return spread (x) << 2 | spread (y) << 1 | spread (z);
+}
+
+std::uint64_t hilbert_key (const std::uint32_t x, const std::uint32_t y,
+                           const std::uint32_t z)
+{
+    // Skilling's algorithm (AIP Conf. Proc. 707, 381 (2004)): transform the
+    // coordinates in place into the "transposed" Hilbert index, whose bits
+    // are then interleaved exactly like a Morton key.
+    constexpr unsigned int n_bits = 21;
+    std::uint32_t          X[3]   = { x, y, z };
+
+    // Inverse undo of the excess work
+    for (std::uint32_t Q = 1u << (n_bits - 1); Q > 1; Q >>= 1)
+    {
+        const std::uint32_t P = Q - 1;
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            if (X[i] & Q)
+                X[0] ^= P;
+            else
+            {
+                const std::uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    std::uint32_t t = 0;
+    for (std::uint32_t Q = 1u << (n_bits - 1); Q > 1; Q >>= 1)
+        if (X[2] & Q)
+            t ^= Q - 1;
+    for (unsigned int i = 0; i < 3; i++)
+        X[i] ^= t;
+
+    return morton_key (X[0], X[1], X[2]);
+}
+
+std::vector<unsigned int>
+space_filling_curve_order (const std::vector<Point<3> > &points,
+                           const SpaceFillingCurve       curve)
+{
+    Point<3> lower (std::numeric_limits<double>::max (),
+                    std::numeric_limits<double>::max (),
+                    std::numeric_limits<double>::max ());
+    Point<3> upper (std::numeric_limits<double>::lowest (),
+                    std::numeric_limits<double>::lowest (),
+                    std::numeric_limits<double>::lowest ());
+    for (const Point<3> &point : points)
+        for (unsigned int d = 0; d < 3; d++)
+        {
+            lower (d) = std::min (lower (d), point (d));
+            upper (d) = std::max (upper (d), point (d));
+        }
+
+    // Scale every direction by the same factor so the curve is not
+    // distorted for elongated domains
+    double extent = 0;
+    for (unsigned int d = 0; d < 3; d++)
+        extent = std::max (extent, upper (d) - lower (d));
+    const double scale = extent > 0 ? ((1u << 21) - 1) / extent : 0;
+
+    std::vector<std::uint64_t> keys (points.size ());
+    for (unsigned int i = 0; i < points.size (); i++)
+    {
+        std::uint32_t grid[3];
+        for (unsigned int d = 0; d < 3; d++)
+            grid[d] = (points[i](d) - lower (d)) * scale;
+        keys[i] = (curve == SpaceFillingCurve::hilbert)
+                      ? hilbert_key (grid[0], grid[1], grid[2])
+                      : morton_key (grid[0], grid[1], grid[2]);
+    }
+
+    std::vector<unsigned int> order (points.size ());
+    std::iota (order.begin (), order.end (), 0);
+    std::stable_sort (order.begin (), order.end (),
+                      [&] (const unsigned int a, const unsigned int b) {
+                          return keys[a] < keys[b];
+                      });
+    return order;
+}
+
+std::vector<unsigned int>
+invert_permutation (const std::vector<unsigned int> &permutation)
+{
+    std::vector<unsigned int> inverse (permutation.size ());
+    for (unsigned int i = 0; i < permutation.size (); i++)
+    {
+        AssertIndexRange (permutation[i], permutation.size ());
+        inverse[permutation[i]] = i;
+    }
+    return inverse;
+}
+
+} // namespace Renumbering
+} // namespace FVMCode
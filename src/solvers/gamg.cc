@@ -0,0 +1,467 @@
+#include <FVMCode/solvers/gamg.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace FVMCode
+{
+
+GAMG::GAMG (const SparseMatrix &matrix, const GAMGOptions &options)
+    : options (options)
+    , fine_matrix (&matrix)
+{
+    AssertThrow (options.smoother != GAMGOptions::Smoother::dic
+                     || matrix.symmetric (),
+                 std::invalid_argument ("The DIC smoother needs a symmetric "
+                                        "matrix"));
+
+    // Agglomerate until the coarsest level is small enough, or pairing
+    // stops reducing the number of cells, e.g. for cells without faces
+    while (n_levels () < options.max_levels
+           && n_cells (n_levels () - 1) > options.max_coarsest_cells)
+    {
+        const unsigned int n_fine = n_cells (n_levels () - 1);
+        build_agglomeration (level_matrix (n_levels () - 1));
+        if (n_cells (n_levels () - 1) > 0.9 * n_fine)
+        {
+            agglomerations.pop_back ();
+            coarse_matrices.pop_back ();
+            break;
+        }
+        // The next level is agglomerated by the coefficients of this one
+        restrict_matrix (level_matrix (n_levels () - 2),
+                         agglomerations.back (), coarse_matrices.back ());
+    }
+
+    update_smoothers ();
+}
+
+namespace
+{
+// Pairs the cells of @p matrix, and returns the number of pairs. Each cell
+// is paired with its most strongly coupled unpaired neighbour, or failing
+// that, added to the pair of its most strongly coupled neighbour.
+unsigned int pair_cells (const SparseMatrix        &matrix,
+                         std::vector<unsigned int> &pair)
+{
+    const SparsityPattern     &sp      = matrix.get_sparsity_pattern ();
+    const std::vector<double> &upper   = matrix.upper_values ();
+    const std::vector<double> &lower   = matrix.lower_values ();
+    const unsigned int         n       = matrix.n ();
+    const unsigned int         n_faces = upper.size ();
+
+    // The faces of each cell, in both triangles
+    std::vector<unsigned int> cell_start (n + 1, 0), cell_faces (2 * n_faces);
+    for (unsigned int f = 0; f < n_faces; f++)
+    {
+        const auto [i, j] = sp.ij_from_arrow_index (f);
+        cell_start[i + 1]++;
+        cell_start[j + 1]++;
+    }
+    for (unsigned int i = 0; i < n; i++)
+        cell_start[i + 1] += cell_start[i];
+    {
+        std::vector<unsigned int> next (cell_start.begin (),
+                                        cell_start.end () - 1);
+        for (unsigned int f = 0; f < n_faces; f++)
+        {
+            const auto [i, j] = sp.ij_from_arrow_index (f);
+            cell_faces[next[i]++] = f;
+            cell_faces[next[j]++] = f;
+        }
+    }
+
+    const unsigned int invalid_cell = static_cast<unsigned int> (-1);
+    pair.assign (n, invalid_cell);
+    unsigned int n_pairs = 0;
+    for (unsigned int i = 0; i < n; i++)
+    {
+        if (pair[i] != invalid_cell)
+            continue;
+        unsigned int best_unpaired = invalid_cell, best_any = invalid_cell;
+        double       unpaired_weight = -1., any_weight = -1.;
+        for (unsigned int e = cell_start[i]; e < cell_start[i + 1]; e++)
+        {
+            const unsigned int f         = cell_faces[e];
+            const auto [a, b]            = sp.ij_from_arrow_index (f);
+            const unsigned int neighbour = a == i ? b : a;
+            const double weight = std::fabs (upper[f]) + std::fabs (lower[f]);
+            if (pair[neighbour] == invalid_cell)
+            {
+                if (weight > unpaired_weight)
+                {
+                    unpaired_weight = weight;
+                    best_unpaired   = neighbour;
+                }
+            }
+            else if (weight > any_weight)
+            {
+                any_weight = weight;
+                best_any   = neighbour;
+            }
+        }
+        if (best_unpaired != invalid_cell)
+        {
+            pair[i]             = n_pairs;
+            pair[best_unpaired] = n_pairs;
+            n_pairs++;
+        }
+        else if (best_any != invalid_cell)
+            pair[i] = pair[best_any];
+        else
+            pair[i] = n_pairs++;
+    }
+    return n_pairs;
+}
+} // namespace
+
+void GAMG::build_agglomeration (const SparseMatrix &matrix)
+{
+    const SparsityPattern &sp = matrix.get_sparsity_pattern ();
+    Agglomeration          agglomeration;
+    unsigned int n_coarse = pair_cells (matrix, agglomeration.coarse_cell);
+
+    // Pair the pairs by the coefficients of the intermediate level
+    for (unsigned int round = 1; round < options.merge_levels; round++)
+    {
+        const auto faces = number_coarse_faces (sp, n_coarse, agglomeration);
+        SparseMatrix intermediate (SparsityPattern (n_coarse, faces));
+        restrict_matrix (matrix, agglomeration, intermediate);
+        std::vector<unsigned int> pair;
+        n_coarse = pair_cells (intermediate, pair);
+        for (unsigned int &c : agglomeration.coarse_cell)
+            c = pair[c];
+    }
+
+    const auto faces = number_coarse_faces (sp, n_coarse, agglomeration);
+    agglomerations.push_back (std::move (agglomeration));
+    coarse_matrices.emplace_back (SparsityPattern (n_coarse, faces));
+}
+
+std::vector<std::pair<unsigned int, unsigned int> >
+GAMG::number_coarse_faces (const SparsityPattern &sp,
+                           const unsigned int     n_coarse,
+                           Agglomeration         &agglomeration)
+{
+    // Number the coarse faces by their upper triangle entry, row by row
+    const std::vector<unsigned int> &coarse_cell = agglomeration.coarse_cell;
+    const unsigned int n_faces = sp.n_off_diagonal_entries () / 2;
+    agglomeration.coarse_face.assign (n_faces, invalid_face);
+    agglomeration.flipped.assign (n_faces, false);
+    std::vector<unsigned int> row_start (n_coarse + 1, 0);
+    for (unsigned int f = 0; f < n_faces; f++)
+    {
+        const auto [i, j] = sp.ij_from_arrow_index (f);
+        if (coarse_cell[i] != coarse_cell[j])
+            row_start[std::min (coarse_cell[i], coarse_cell[j]) + 1]++;
+    }
+    for (unsigned int c = 0; c < n_coarse; c++)
+        row_start[c + 1] += row_start[c];
+    std::vector<unsigned int> row_faces (row_start.back ());
+    {
+        std::vector<unsigned int> next (row_start.begin (),
+                                        row_start.end () - 1);
+        for (unsigned int f = 0; f < n_faces; f++)
+        {
+            const auto [i, j] = sp.ij_from_arrow_index (f);
+            if (coarse_cell[i] != coarse_cell[j])
+                row_faces[next[std::min (coarse_cell[i], coarse_cell[j])]++]
+                    = f;
+        }
+    }
+    auto column = [&] (const unsigned int f) {
+        const auto [i, j] = sp.ij_from_arrow_index (f);
+        return std::max (coarse_cell[i], coarse_cell[j]);
+    };
+    std::vector<std::pair<unsigned int, unsigned int> > coarse_faces;
+    for (unsigned int c = 0; c < n_coarse; c++)
+    {
+        std::sort (row_faces.begin () + row_start[c],
+                   row_faces.begin () + row_start[c + 1],
+                   [&] (const unsigned int a, const unsigned int b) {
+                       return column (a) < column (b);
+                   });
+        for (unsigned int e = row_start[c]; e < row_start[c + 1]; e++)
+        {
+            const unsigned int f = row_faces[e];
+            if (e == row_start[c] || column (f) != column (row_faces[e - 1]))
+                coarse_faces.emplace_back (c, column (f));
+            const auto [i, j]            = sp.ij_from_arrow_index (f);
+            agglomeration.coarse_face[f] = coarse_faces.size () - 1;
+            agglomeration.flipped[f]     = coarse_cell[i] > coarse_cell[j];
+        }
+    }
+    return coarse_faces;
+}
+
+void GAMG::update (const SparseMatrix &matrix)
+{
+    Assert (matrix.n () == n_cells (0), "Matrix does not match the hierarchy");
+    Assert (agglomerations.empty ()
+                || matrix.upper_values ().size ()
+                       == agglomerations[0].coarse_face.size (),
+            "Matrix does not match the hierarchy");
+    fine_matrix = &matrix;
+    for (unsigned int level = 0; level + 1 < n_levels (); level++)
+        restrict_matrix (level_matrix (level), agglomerations[level],
+                         coarse_matrices[level]);
+    update_smoothers ();
+}
+
+void GAMG::restrict_matrix (const SparseMatrix  &fine,
+                            const Agglomeration &agglomeration,
+                            SparseMatrix        &coarse)
+{
+    const SparsityPattern     &sp       = fine.get_sparsity_pattern ();
+    const std::vector<double> &diagonal = fine.diagonal_values ();
+    const std::vector<double> &upper    = fine.upper_values ();
+    const std::vector<double> &lower    = fine.lower_values ();
+
+    coarse.set_zero ();
+    for (unsigned int i = 0; i < fine.n (); i++)
+        coarse.add_diag (agglomeration.coarse_cell[i], diagonal[i]);
+    for (unsigned int f = 0; f < upper.size (); f++)
+    {
+        const unsigned int coarse_face = agglomeration.coarse_face[f];
+        if (coarse_face == invalid_face)
+            coarse.add_diag (
+                agglomeration.coarse_cell[sp.ij_from_arrow_index (f).first],
+                upper[f] + lower[f]);
+        else if (agglomeration.flipped[f])
+            coarse.add_face (coarse_face, lower[f], upper[f]);
+        else
+            coarse.add_face (coarse_face, upper[f], lower[f]);
+    }
+}
+
+void GAMG::update_smoothers ()
+{
+    dic_smoothers.clear ();
+    if (options.smoother == GAMGOptions::Smoother::dic)
+        for (unsigned int level = 0; level < n_levels (); level++)
+            dic_smoothers.emplace_back (level_matrix (level));
+
+    // Only a small coarsest level is solved for directly: coarsening can
+    // stop early, e.g. for a matrix without faces, and a dense LU of a
+    // large level would not fit in memory
+    direct_coarsest
+        = n_cells (n_levels () - 1) <= options.max_coarsest_cells;
+    coarsest_solver = Eigen::PartialPivLU<Eigen::MatrixXd> ();
+    if (direct_coarsest)
+    {
+        Eigen::SparseMatrix<double> coarsest;
+        level_matrix (n_levels () - 1).copy_to (coarsest);
+        coarsest_solver.compute (Eigen::MatrixXd (coarsest));
+    }
+
+    level_rhs.resize (n_levels ());
+    level_x.resize (n_levels ());
+    level_residual.resize (n_levels ());
+    level_work.resize (n_levels ());
+    for (unsigned int level = 0; level < n_levels (); level++)
+    {
+        level_rhs[level].resize (n_cells (level));
+        level_x[level].resize (n_cells (level));
+        level_residual[level].resize (n_cells (level));
+        level_work[level].resize (n_cells (level));
+    }
+}
+
+unsigned int GAMG::n_cells (const unsigned int level) const
+{
+    return level_matrix (level).n ();
+}
+
+const SparseMatrix &GAMG::level_matrix (const unsigned int level) const
+{
+    AssertIndexRange (level, n_levels ());
+    return level == 0 ? *fine_matrix : coarse_matrices[level - 1];
+}
+
+const std::vector<unsigned int> &
+GAMG::coarse_cells (const unsigned int level) const
+{
+    AssertIndexRange (level, agglomerations.size ());
+    return agglomerations[level].coarse_cell;
+}
+
+void GAMG::vmult (const VectorXd &src, VectorXd &dst) const
+{
+    apply_cycle (src, dst, false);
+}
+
+void GAMG::apply_cycle (const VectorXd &rhs, VectorXd &x,
+                        const bool scale_correction) const
+{
+    Assert (rhs.size () == static_cast<long> (n_cells (0)),
+            "Vector of wrong size");
+    level_rhs[0] = rhs;
+    cycle (0, true, scale_correction);
+    x = level_x[0];
+}
+
+void GAMG::smooth (const unsigned int level, const VectorXd &rhs,
+                   VectorXd &x, const bool forward) const
+{
+    const SparseMatrix &matrix = level_matrix (level);
+    VectorXd           &work   = level_work[level];
+
+    if (options.smoother == GAMGOptions::Smoother::dic)
+    {
+        VectorXd &residual = level_residual[level];
+        matrix.vmult (x, residual);
+        residual = rhs - residual;
+        dic_smoothers[level].vmult (residual, work);
+        x += work;
+        return;
+    }
+
+    const SparsityPattern &sp = matrix.get_sparsity_pattern ();
+    const std::vector<unsigned int> &order = sp.upper_triangular_order ();
+    const std::vector<unsigned int> &start = sp.upper_triangular_row_start ();
+    const std::vector<double>       &diagonal = matrix.diagonal_values ();
+    const std::vector<double>       &upper    = matrix.upper_values ();
+    const std::vector<double>       &lower    = matrix.lower_values ();
+    const unsigned int               n        = matrix.n ();
+
+    // work holds the right hand side less the contributions of the rows
+    // that are not yet updated
+    work = rhs;
+    if (forward)
+    {
+        // Row i takes the old values of the cells after it from its own
+        // upper triangle entries, and passes its new value to the rows after
+        // it through its lower triangle entries
+        for (unsigned int i = 0; i < n; i++)
+        {
+            double value = work (i);
+            for (unsigned int e = start[i]; e < start[i + 1]; e++)
+                value -= upper[order[e]]
+                         * x (sp.ij_from_arrow_index (order[e]).second);
+            value /= diagonal[i];
+            for (unsigned int e = start[i]; e < start[i + 1]; e++)
+                work (sp.ij_from_arrow_index (order[e]).second)
+                    -= lower[order[e]] * value;
+            x (i) = value;
+        }
+    }
+    else
+    {
+        // The lower triangle only couples to old values, so it is
+        // subtracted first
+        for (unsigned int i = 0; i < n; i++)
+            for (unsigned int e = start[i]; e < start[i + 1]; e++)
+                work (sp.ij_from_arrow_index (order[e]).second)
+                    -= lower[order[e]] * x (i);
+        for (unsigned int i = n; i-- > 0;)
+        {
+            double value = work (i);
+            for (unsigned int e = start[i]; e < start[i + 1]; e++)
+                value -= upper[order[e]]
+                         * x (sp.ij_from_arrow_index (order[e]).second);
+            x (i) = value / diagonal[i];
+        }
+    }
+}
+
+void GAMG::cycle (const unsigned int level, const bool zero_start,
+                  const bool scale_correction) const
+{
+    const VectorXd &rhs = level_rhs[level];
+    VectorXd       &x   = level_x[level];
+    if (level + 1 == n_levels () && direct_coarsest)
+    {
+        x = coarsest_solver.solve (rhs);
+        return;
+    }
+    if (zero_start)
+        x.setZero ();
+    if (level + 1 == n_levels ())
+    {
+        for (unsigned int sweep = 0; sweep < options.n_pre_sweeps; sweep++)
+            smooth (level, rhs, x, true);
+        for (unsigned int sweep = 0; sweep < options.n_post_sweeps; sweep++)
+            smooth (level, rhs, x, false);
+        return;
+    }
+
+    const SparseMatrix  &matrix        = level_matrix (level);
+    const Agglomeration &agglomeration = agglomerations[level];
+    VectorXd            &residual      = level_residual[level];
+
+    for (unsigned int sweep = 0; sweep < options.n_pre_sweeps; sweep++)
+        smooth (level, rhs, x, true);
+
+    // Restrict the residual by summing it over each agglomerate
+    matrix.vmult (x, residual);
+    residual = rhs - residual;
+    VectorXd &coarse_rhs = level_rhs[level + 1];
+    coarse_rhs.setZero ();
+    for (unsigned int i = 0; i < matrix.n (); i++)
+        coarse_rhs (agglomeration.coarse_cell[i]) += residual (i);
+
+    // A W-cycle improves the coarse level correction with a second cycle
+    // from the result of the first, unless the first was a direct solve
+    cycle (level + 1, true, scale_correction);
+    if (options.cycle == GAMGOptions::Cycle::w
+        && (level + 2 < n_levels () || !direct_coarsest))
+        cycle (level + 1, false, scale_correction);
+
+    // Prolongate the correction by injection
+    const VectorXd &coarse_x   = level_x[level + 1];
+    VectorXd       &correction = level_work[level];
+    for (unsigned int i = 0; i < matrix.n (); i++)
+        correction (i) = coarse_x (agglomeration.coarse_cell[i]);
+    double scaling = 1.;
+    if (scale_correction)
+    {
+        // The correction is best in the energy norm when scaled by
+        // (c, r) / (c, A c). The residual is not needed afterwards, so it
+        // holds A c.
+        const double numerator = correction.dot (residual);
+        matrix.vmult (correction, residual);
+        const double denominator = correction.dot (residual);
+        if (denominator > 0.)
+            scaling = numerator / denominator;
+    }
+    x += scaling * correction;
+
+    for (unsigned int sweep = 0; sweep < options.n_post_sweeps; sweep++)
+        smooth (level, rhs, x, false);
+}
+
+SolverGAMG::SolverGAMG (const SolverControl &control) : control (control) {}
+
+SolverResult SolverGAMG::solve (const SparseMatrix &matrix, VectorXd &x,
+                                const VectorXd &rhs, const GAMG &gamg) const
+{
+    Assert (rhs.size () == static_cast<long> (matrix.n ()),
+            "Right hand side of wrong size");
+    Assert (x.size () == static_cast<long> (matrix.n ()),
+            "Initial guess of wrong size");
+
+    matrix.vmult (x, residual);
+    residual = rhs - residual;
+
+    SolverResult result;
+    result.initial_residual = result.final_residual = residual.norm ();
+    const double target
+        = std::max (control.tolerance,
+                    control.relative_tolerance * result.initial_residual);
+    while (result.final_residual > target
+           && result.iterations < control.max_iterations)
+    {
+        result.iterations++;
+        gamg.apply_cycle (residual, correction,
+                          gamg.options.scale_correction);
+        x += correction;
+        matrix.vmult (x, residual);
+        residual = rhs - residual;
+        result.final_residual = residual.norm ();
+    }
+    result.converged = result.final_residual <= target;
+    return result;
+}
+
+} // namespace FVMCode
@@ -0,0 +1,121 @@
+#include <FVMCode/solvers/preconditioners.h>
+
+namespace FVMCode
+{
+
+PreconditionerJacobi::PreconditionerJacobi (const SparseMatrix &matrix)
+    : inverse_diagonal (matrix.n ())
+{
+    const std::vector<double> &diagonal = matrix.diagonal_values ();
+    for (unsigned int i = 0; i < matrix.n (); i++)
+    {
+        Assert (diagonal[i] != 0., "Zero on the diagonal");
+        inverse_diagonal (i) = 1. / diagonal[i];
+    }
+}
+
+void PreconditionerJacobi::vmult (const VectorXd &src, VectorXd &dst) const
+{
+    Assert (src.size () == inverse_diagonal.size (),
+            "Vector of wrong size");
+    dst = inverse_diagonal.cwiseProduct (src);
+}
+
+PreconditionerDIC::PreconditionerDIC (const SparseMatrix &matrix)
+    : matrix (matrix)
+    , reciprocal_diagonal (matrix.diagonal_values ())
+{
+    Assert (matrix.symmetric (), "DIC needs a symmetric matrix");
+    const SparsityPattern     &sp    = matrix.get_sparsity_pattern ();
+    const std::vector<double> &upper = matrix.upper_values ();
+
+    // Row i of D is final once the entries of all rows before it have been
+    // eliminated
+    for (const unsigned int index : sp.upper_triangular_order ())
+    {
+        const auto [i, j] = sp.ij_from_arrow_index (index);
+        reciprocal_diagonal[j] -= upper[index] * upper[index]
+                                  / reciprocal_diagonal[i];
+    }
+    for (double &d : reciprocal_diagonal)
+    {
+        Assert (d > 0., "DIC breakdown: matrix is not positive definite");
+        d = 1. / d;
+    }
+}
+
+void PreconditionerDIC::vmult (const VectorXd &src, VectorXd &dst) const
+{
+    Assert (src.size () == static_cast<long> (reciprocal_diagonal.size ()),
+            "Vector of wrong size");
+    const SparsityPattern           &sp    = matrix.get_sparsity_pattern ();
+    const std::vector<unsigned int> &order = sp.upper_triangular_order ();
+    const std::vector<double>       &upper = matrix.upper_values ();
+
+    dst.resize (src.size ());
+    for (unsigned int i = 0; i < reciprocal_diagonal.size (); i++)
+        dst (i) = reciprocal_diagonal[i] * src (i);
+
+    // Forward substitution with D^-1 (D + L), then backward substitution
+    // with D^-1 (D + U)
+    for (const unsigned int index : order)
+    {
+        const auto [i, j] = sp.ij_from_arrow_index (index);
+        dst (j) -= reciprocal_diagonal[j] * upper[index] * dst (i);
+    }
+    for (auto index = order.rbegin (); index != order.rend (); ++index)
+    {
+        const auto [i, j] = sp.ij_from_arrow_index (*index);
+        dst (i) -= reciprocal_diagonal[i] * upper[*index] * dst (j);
+    }
+}
+
+PreconditionerDILU::PreconditionerDILU (const SparseMatrix &matrix)
+    : matrix (matrix)
+    , reciprocal_diagonal (matrix.diagonal_values ())
+{
+    const SparsityPattern     &sp    = matrix.get_sparsity_pattern ();
+    const std::vector<double> &upper = matrix.upper_values ();
+    const std::vector<double> &lower = matrix.lower_values ();
+
+    for (const unsigned int index : sp.upper_triangular_order ())
+    {
+        const auto [i, j] = sp.ij_from_arrow_index (index);
+        reciprocal_diagonal[j] -= upper[index] * lower[index]
+                                  / reciprocal_diagonal[i];
+    }
+    for (double &d : reciprocal_diagonal)
+    {
+        Assert (d != 0., "DILU breakdown: zero pivot");
+        d = 1. / d;
+    }
+}
+
+void PreconditionerDILU::vmult (const VectorXd &src, VectorXd &dst) const
+{
+    Assert (src.size () == static_cast<long> (reciprocal_diagonal.size ()),
+            "Vector of wrong size");
+    const SparsityPattern           &sp    = matrix.get_sparsity_pattern ();
+    const std::vector<unsigned int> &order = sp.upper_triangular_order ();
+    const std::vector<double>       &upper = matrix.upper_values ();
+    const std::vector<double>       &lower = matrix.lower_values ();
+
+    dst.resize (src.size ());
+    for (unsigned int i = 0; i < reciprocal_diagonal.size (); i++)
+        dst (i) = reciprocal_diagonal[i] * src (i);
+
+    // As for DIC, but entry (j, i) of the lower triangle is lower[index]
+    // rather than upper[index]
+    for (const unsigned int index : order)
+    {
+        const auto [i, j] = sp.ij_from_arrow_index (index);
+        dst (j) -= reciprocal_diagonal[j] * lower[index] * dst (i);
+    }
+    for (auto index = order.rbegin (); index != order.rend (); ++index)
+    {
+        const auto [i, j] = sp.ij_from_arrow_index (*index);
+        dst (i) -= reciprocal_diagonal[i] * upper[*index] * dst (j);
+    }
+}
+
+} // namespace FVMCode
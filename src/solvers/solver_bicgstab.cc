@@ -0,0 +1,135 @@
+#include <FVMCode/solvers/solver_bicgstab.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace FVMCode
+{
+
+SolverBiCGStab::SolverBiCGStab (const SolverControl &control)
+    : control (control)
+{
+}
+
+SolverResult SolverBiCGStab::solve (const SparseMatrix &matrix, VectorXd &x,
+                                    const VectorXd &rhs) const
+{
+    return solve (matrix, x, rhs, PreconditionerIdentity ());
+}
+
+SolverResult
+SolverBiCGStab::solve (const SparseMatrix &matrix, VectorXd &x,
+                       const VectorXd       &rhs,
+                       const Preconditioner &preconditioner) const
+{
+    Assert (rhs.size () == static_cast<long> (matrix.n ()),
+            "Right hand side of wrong size");
+    Assert (x.size () == static_cast<long> (matrix.n ()),
+            "Initial guess of wrong size");
+    const long n = x.size ();
+
+    matrix.vmult (x, residual);
+    residual = rhs - residual;
+
+    SolverResult result;
+    result.initial_residual = result.final_residual = residual.norm ();
+    const double target
+        = std::max (control.tolerance,
+                    control.relative_tolerance * result.initial_residual);
+    if (result.final_residual <= target)
+    {
+        result.converged = true;
+        return result;
+    }
+
+    shadow_residual = residual;
+    direction.setZero (n);
+    v.setZero (n);
+    double rho   = 1.;
+    double alpha = 1.;
+    double omega = 1.;
+    // The inner product of the shadow residual and the residual
+    double rho_next = residual.squaredNorm ();
+
+    while (result.iterations < control.max_iterations)
+    {
+        result.iterations++;
+
+        // The shadow residual has become orthogonal to the residual, so
+        // restart with the residual as the shadow residual
+        if (std::fabs (rho_next)
+            < 1e-30 * result.final_residual * result.final_residual)
+        {
+            shadow_residual = residual;
+            rho_next        = residual.squaredNorm ();
+            direction.setZero ();
+            v.setZero ();
+            rho = alpha = omega = 1.;
+        }
+
+        const double beta = rho_next / rho * alpha / omega;
+        rho               = rho_next;
+        for (long i = 0; i < n; i++)
+            direction (i) = residual (i)
+                            + beta * (direction (i) - omega * v (i));
+
+        preconditioner.vmult (direction, preconditioned_direction);
+        matrix.vmult (preconditioned_direction, v);
+        alpha = rho / shadow_residual.dot (v);
+
+        // s = r - alpha v, and its norm
+        double s_norm_squared = 0.;
+        s.resize (n);
+        for (long i = 0; i < n; i++)
+        {
+            s (i) = residual (i) - alpha * v (i);
+            s_norm_squared += s (i) * s (i);
+        }
+        if (std::sqrt (s_norm_squared) <= target)
+        {
+            x += alpha * preconditioned_direction;
+            residual              = s;
+            result.final_residual = std::sqrt (s_norm_squared);
+            result.converged      = true;
+            break;
+        }
+
+        preconditioner.vmult (s, preconditioned_s);
+        matrix.vmult (preconditioned_s, t);
+
+        // omega = (t, s) / (t, t) from a single pass
+        double t_dot_s = 0., t_dot_t = 0.;
+        for (long i = 0; i < n; i++)
+        {
+            t_dot_s += t (i) * s (i);
+            t_dot_t += t (i) * t (i);
+        }
+        omega = t_dot_t > 0. ? t_dot_s / t_dot_t : 0.;
+
+        // Update the solution and the residual, and take the norm of the
+        // residual and its inner product with the shadow residual for the
+        // next iteration
+        double residual_norm_squared = 0.;
+        rho_next                     = 0.;
+        for (long i = 0; i < n; i++)
+        {
+            x (i) += alpha * preconditioned_direction (i)
+                     + omega * preconditioned_s (i);
+            residual (i) = s (i) - omega * t (i);
+            residual_norm_squared += residual (i) * residual (i);
+            rho_next += shadow_residual (i) * residual (i);
+        }
+        result.final_residual = std::sqrt (residual_norm_squared);
+        if (result.final_residual <= target)
+        {
+            result.converged = true;
+            break;
+        }
+        // Breakdown: (t, s) = 0 stops any further progress
+        if (omega == 0.)
+            break;
+    }
+    return result;
+}
+
+} // namespace FVMCode
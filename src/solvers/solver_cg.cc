@@ -0,0 +1,68 @@
+#include <FVMCode/solvers/solver_cg.h>
+
+#include <algorithm>
+
+namespace FVMCode
+{
+
+SolverCG::SolverCG (const SolverControl &control) : control (control) {}
+
+SolverResult SolverCG::solve (const SparseMatrix &matrix, VectorXd &x,
+                              const VectorXd &rhs) const
+{
+    return solve (matrix, x, rhs, PreconditionerIdentity ());
+}
+
+SolverResult SolverCG::solve (const SparseMatrix &matrix, VectorXd &x,
+                              const VectorXd       &rhs,
+                              const Preconditioner &preconditioner) const
+{
+    Assert (matrix.symmetric (), "CG needs a symmetric matrix");
+    Assert (rhs.size () == static_cast<long> (matrix.n ()),
+            "Right hand side of wrong size");
+    Assert (x.size () == static_cast<long> (matrix.n ()),
+            "Initial guess of wrong size");
+
+    matrix.vmult (x, product);
+    residual = rhs - product;
+
+    SolverResult result;
+    result.initial_residual = result.final_residual = residual.norm ();
+    const double target
+        = std::max (control.tolerance,
+                    control.relative_tolerance * result.initial_residual);
+    if (result.final_residual <= target)
+    {
+        result.converged = true;
+        return result;
+    }
+
+    preconditioner.vmult (residual, preconditioned);
+    direction           = preconditioned;
+    double residual_dot = residual.dot (preconditioned);
+
+    while (result.iterations < control.max_iterations)
+    {
+        result.iterations++;
+        matrix.vmult (direction, product);
+        const double alpha = residual_dot / direction.dot (product);
+        x += alpha * direction;
+        residual -= alpha * product;
+
+        result.final_residual = residual.norm ();
+        if (result.final_residual <= target)
+        {
+            result.converged = true;
+            break;
+        }
+
+        preconditioner.vmult (residual, preconditioned);
+        const double old_residual_dot = residual_dot;
+        residual_dot                  = residual.dot (preconditioned);
+        direction
+            = preconditioned + residual_dot / old_residual_dot * direction;
+    }
+    return result;
+}
+
+} // namespace FVMCode
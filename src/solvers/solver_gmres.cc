@@ -0,0 +1,152 @@
+#include <FVMCode/solvers/solver_gmres.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace FVMCode
+{
+
+SolverGMRES::SolverGMRES (const SolverControl &control,
+                          const unsigned int   restart)
+    : control (control)
+    , restart (restart)
+{
+    AssertThrow (restart > 0,
+                 std::invalid_argument ("GMRES needs a restart length"));
+}
+
+SolverResult SolverGMRES::solve (const SparseMatrix &matrix, VectorXd &x,
+                                 const VectorXd &rhs) const
+{
+    return solve (matrix, x, rhs, PreconditionerIdentity ());
+}
+
+SolverResult SolverGMRES::solve (const SparseMatrix &matrix, VectorXd &x,
+                                 const VectorXd       &rhs,
+                                 const Preconditioner &preconditioner) const
+{
+    Assert (rhs.size () == static_cast<long> (matrix.n ()),
+            "Right hand side of wrong size");
+    Assert (x.size () == static_cast<long> (matrix.n ()),
+            "Initial guess of wrong size");
+    const long         n = x.size ();
+    const unsigned int m = restart;
+
+    basis.resize (m + 1);
+    // The Hessenberg matrix, reduced to upper triangular by the Givens
+    // rotations (c, s) as its columns are computed, and the rotated right
+    // hand side of the least squares problem
+    Eigen::MatrixXd     hessenberg (m + 1, m);
+    std::vector<double> c (m), s (m), g (m + 1);
+
+    SolverResult result;
+    double       target = 0.;
+    while (true)
+    {
+        matrix.vmult (x, residual);
+        residual                   = rhs - residual;
+        const double residual_norm = residual.norm ();
+        result.final_residual      = residual_norm;
+        if (result.iterations == 0)
+        {
+            result.initial_residual = residual_norm;
+            target = std::max (control.tolerance,
+                               control.relative_tolerance * residual_norm);
+        }
+        if (residual_norm <= target)
+        {
+            result.converged = true;
+            break;
+        }
+        if (result.iterations >= control.max_iterations)
+            break;
+
+        basis[0] = residual / residual_norm;
+        std::fill (g.begin (), g.end (), 0.);
+        g[0] = residual_norm;
+
+        unsigned int k = 0;
+        while (k < m && result.iterations < control.max_iterations)
+        {
+            result.iterations++;
+            // The new basis vector is orthogonalised in place
+            VectorXd &w = basis[k + 1];
+            preconditioner.vmult (basis[k], preconditioned);
+            matrix.vmult (preconditioned, w);
+
+            // Modified Gram-Schmidt: each pass subtracts the projection on
+            // one basis vector and computes the inner product with the next,
+            // and the last pass the norm of what remains
+            double next_dot = w.dot (basis[0]);
+            for (unsigned int i = 0; i <= k; i++)
+            {
+                hessenberg (i, k) = next_dot;
+                const double    h = next_dot;
+                const VectorXd &v = basis[i];
+                next_dot          = 0.;
+                if (i < k)
+                {
+                    const VectorXd &next = basis[i + 1];
+                    for (long l = 0; l < n; l++)
+                    {
+                        w (l) -= h * v (l);
+                        next_dot += w (l) * next (l);
+                    }
+                }
+                else
+                    for (long l = 0; l < n; l++)
+                    {
+                        w (l) -= h * v (l);
+                        next_dot += w (l) * w (l);
+                    }
+            }
+            const double w_norm   = std::sqrt (next_dot);
+            hessenberg (k + 1, k) = w_norm;
+            if (w_norm > 0.)
+                w /= w_norm;
+
+            // Apply the previous rotations to the new column, and eliminate
+            // its subdiagonal entry with a new one
+            for (unsigned int i = 0; i < k; i++)
+            {
+                const double a        = hessenberg (i, k);
+                const double b        = hessenberg (i + 1, k);
+                hessenberg (i, k)     = c[i] * a + s[i] * b;
+                hessenberg (i + 1, k) = -s[i] * a + c[i] * b;
+            }
+            const double a = hessenberg (k, k);
+            const double b = hessenberg (k + 1, k);
+            const double r        = std::hypot (a, b);
+            c[k]                  = a / r;
+            s[k]                  = b / r;
+            hessenberg (k, k)     = r;
+            hessenberg (k + 1, k) = 0.;
+            g[k + 1]              = -s[k] * g[k];
+            g[k]                  = c[k] * g[k];
+            k++;
+
+            // A zero norm means the Krylov space holds the exact solution
+            if (std::fabs (g[k]) <= target || w_norm == 0.)
+                break;
+        }
+
+        // Solve the triangular least squares problem, and correct x by the
+        // preconditioned combination of the basis vectors
+        VectorXd y (k);
+        for (unsigned int i = k; i-- > 0;)
+        {
+            double sum = g[i];
+            for (unsigned int j = i + 1; j < k; j++)
+                sum -= hessenberg (i, j) * y (j);
+            y (i) = sum / hessenberg (i, i);
+        }
+        update = y (0) * basis[0];
+        for (unsigned int j = 1; j < k; j++)
+            update += y (j) * basis[j];
+        preconditioner.vmult (update, preconditioned);
+        x += preconditioned;
+    }
+    return result;
+}
+
+} // namespace FVMCode
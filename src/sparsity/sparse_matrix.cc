@@ -1,5 +1,7 @@
 #include <FVMCode/sparsity/sparse_matrix.h>
 
+#include <algorithm>
+
 inline bool fclose (double a, double b)
 {
     return std::fabs (a - b) <= (std::fabs (a) + std::fabs (b)) * 1e-12;
@@ -80,6 +82,65 @@ void SparseMatrix::vmult_add (const VectorXd &src, VectorXd &dst) const
     }
 }
 
+void SparseMatrix::vmult (const VectorXd &src, VectorXd &dst,
+                          const FaceColouring  &colouring,
+                          Parallel::ThreadPool &pool) const
+{
+    Assert (src.size () == n (),
+            "Vectors are of different size to sparse matrix");
+    dst.resize (src.size ());
+    pool.parallel_for (0, n (),
+                       [&] (const unsigned int begin, const unsigned int end) {
+                           dst.segment (begin, end - begin).setZero ();
+                       });
+    vmult_add (src, dst, colouring, pool);
+}
+
+void SparseMatrix::vmult_add (const VectorXd &src, VectorXd &dst,
+                              const FaceColouring  &colouring,
+                              Parallel::ThreadPool &pool) const
+{
+    Assert (src.size () == dst.size (), "Vectors are of inconsistent size");
+    Assert (src.size () == n (),
+            "Vectors are of different size to sparse matrix");
+    Assert (colouring.n_faces () == upper_triangular.size (),
+            "Face colouring does not match the sparsity pattern");
+
+    pool.parallel_for (0, n (),
+                       [&] (const unsigned int begin, const unsigned int end) {
+                           for (unsigned int row = begin; row < end; row++)
+                               dst (row) += diagonal[row] * src (row);
+                       });
+    colouring.for_each_face (pool, [&] (const unsigned int index) {
+        auto [i, j] = sp.ij_from_arrow_index (index);
+        dst (i) += upper_triangular[index] * src (j);
+        dst (j) += lower_triangular[index] * src (i);
+    });
+}
+
+void SparseMatrix::set_zero ()
+{
+    std::fill (diagonal.begin (), diagonal.end (), 0.);
+    std::fill (upper_triangular.begin (), upper_triangular.end (), 0.);
+    std::fill (lower_triangular.begin (), lower_triangular.end (), 0.);
+}
+
+void SparseMatrix::copy_to (Eigen::SparseMatrix<double> &matrix) const
+{
+    std::vector<Eigen::Triplet<double> > entries;
+    entries.reserve (n () + 2 * upper_triangular.size ());
+    for (unsigned int row = 0; row < n (); row++)
+        entries.emplace_back (row, row, diagonal[row]);
+    for (unsigned int index = 0; index < upper_triangular.size (); index++)
+    {
+        auto [i, j] = sp.ij_from_arrow_index (index);
+        entries.emplace_back (i, j, upper_triangular[index]);
+        entries.emplace_back (j, i, lower_triangular[index]);
+    }
+    matrix.resize (n (), n ());
+    matrix.setFromTriplets (entries.begin (), entries.end ());
+}
+
 const double &SparseMatrix::operator() (const unsigned int i,
                                         const unsigned int j) const
 {
@@ -1,37 +1,88 @@
 #include <FVMCode/sparsity/sparsity_pattern.h>
 #include <FVMCode/unstructured_mesh.h>
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
 namespace FVMCode
 {
 
-SparsityPattern::SparsityPattern (UnstructuredMesh &mesh)
+SparsityPattern::SparsityPattern (UnstructuredMesh &mesh,
+                                  const bool        build_debug_index)
     : n (mesh.n_cells ())
 {
     Assert (mesh.n_cells () > 0, "Empty mesh!");
+    const unsigned int n_internal_faces = mesh.get_patches ()[0].start_face;
+    ij_indices.reserve (n_internal_faces);
+    owner_higher.reserve (n_internal_faces);
+
     // Loop over internal cells to get off-diagonal entries
-    for (unsigned int f = 0; f < mesh.get_patches ()[0].start_face; f++)
+    for (unsigned int f = 0; f < n_internal_faces; f++)
     {
         const auto &face = mesh.get_face (f);
         Assert (!face->is_boundary (),
                 "Face should not be at boundary! Check face numbering.");
+        add_face (face->neighbour_indices ()[0],
+                  face->neighbour_indices ()[1]);
+    }
+    build_row_index (build_debug_index);
+}
 
-        const unsigned int i = face->neighbour_indices ()[0];
-        const unsigned int j = face->neighbour_indices ()[1];
-        if (i < j)
-        {
-            auto ij = std::make_pair(i,j);
-            ij_indices.push_back(ij);
-            reverse_lookup[ij] = f;
-        } else if (j < i)
-        {
-            auto ji = std::make_pair(j,i);
-            ij_indices.push_back(ji);
-            reverse_lookup[ji] = f;
-        }
-        else {
-            Assert(false, "Face has owner and neighbour indices the same!");
-        }
+SparsityPattern::SparsityPattern (
+    const unsigned int                                         n_eqns,
+    const std::vector<std::pair<unsigned int, unsigned int> > &faces,
+    const bool build_debug_index)
+    : n (n_eqns)
+{
+    Assert (n_eqns > 0, "Empty pattern!");
+    ij_indices.reserve (faces.size ());
+    owner_higher.reserve (faces.size ());
+    for (const auto &[owner, neighbour] : faces)
+    {
+        AssertIndexRange (owner, n);
+        AssertIndexRange (neighbour, n);
+        add_face (owner, neighbour);
     }
+    build_row_index (build_debug_index);
+}
+
+void SparsityPattern::add_face (const unsigned int owner,
+                                const unsigned int neighbour)
+{
+    Assert (owner != neighbour,
+            "Face has owner and neighbour indices the same!");
+    ij_indices.push_back (std::minmax (owner, neighbour));
+    owner_higher.push_back (owner > neighbour);
+}
+
+void SparsityPattern::build_row_index (const bool build_debug_index)
+{
+    // Counting sort of the faces by the row of their upper triangle entry
+    const unsigned int n_faces = ij_indices.size ();
+    row_start.assign (n + 1, 0);
+    for (const auto &ij : ij_indices)
+        row_start[ij.first + 1]++;
+    for (unsigned int i = 0; i < n; i++)
+        row_start[i + 1] += row_start[i];
+    row_entries.resize (n_faces);
+    std::vector<unsigned int> next_entry (row_start.begin (),
+                                          row_start.end () - 1);
+    for (unsigned int f = 0; f < n_faces; f++)
+        row_entries[next_entry[ij_indices[f].first]++] = f;
+    for (unsigned int i = 0; i < n; i++)
+        std::sort (row_entries.begin () + row_start[i],
+                   row_entries.begin () + row_start[i + 1],
+                   [&] (const unsigned int a, const unsigned int b) {
+                       return ij_indices[a].second < ij_indices[b].second;
+                   });
+    for (unsigned int e = 1; e < n_faces; e++)
+        Assert (ij_indices[row_entries[e - 1]] != ij_indices[row_entries[e]],
+                "Entry appears twice in the sparsity pattern");
+
+    if (build_debug_index)
+        for (unsigned int f = 0; f < n_faces; f++)
+            reverse_lookup[ij_indices[f]] = f;
 }
 
 unsigned int SparsityPattern::n_off_diagonal_entries () const
@@ -68,22 +119,22 @@ unsigned int SparsityPattern::arrow_index_from_ij (const unsigned int i,
                                                    const unsigned int j) const
 {
     Assert (i < j, "Queried indexes must be in upper triangle!");
-    try
-    {
-        return reverse_lookup.at (std::make_pair (i, j));
-    }
-    catch (std::out_of_range &e)
-    {
-        std::cerr << "Index (" << i << ", " << j
-                  << ") is not in the sparsity pattern!" << std::endl;
-        throw e;
-    }
-}
-
-std::pair<unsigned int, unsigned int>
-SparsityPattern::ij_from_arrow_index (const unsigned int arrow_index) const
-{
-    return ij_indices[arrow_index];
+    AssertIndexRange (j, n);
+    const auto row_begin = row_entries.begin () + row_start[i];
+    const auto row_end   = row_entries.begin () + row_start[i + 1];
+    const auto entry     = std::lower_bound (
+        row_begin, row_end, j,
+        [&] (const unsigned int index, const unsigned int column) {
+            return ij_indices[index].second < column;
+        });
+    AssertThrow (entry != row_end && ij_indices[*entry].second == j,
+                 std::out_of_range ("Index (" + std::to_string (i) + ", "
+                                    + std::to_string (j)
+                                    + ") is not in the sparsity pattern!"));
+    Assert (reverse_lookup.empty ()
+                || reverse_lookup.at (std::make_pair (i, j)) == *entry,
+            "Debug index disagrees with the row entries");
+    return *entry;
 }
 
 } // namespace FVMCode
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include <FVMCode/time_series.h>
+
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace FVMCode
+{
+
+namespace
+{
+constexpr char          magic[8]   = "FVMTSER";
+constexpr std::uint32_t version    = 1;
+constexpr std::uint32_t byte_order = 0x01020304;
+
+static_assert (sizeof (TimeSeries::Header) == 128);
+static_assert (sizeof (TimeSeries::FrameHeader) == 16);
+static_assert (sizeof (TimeSeries::IndexEntry) == 24);
+
+// Reads and checks the header at the start of data
+TimeSeries::Header read_header (const char *data, const std::size_t size,
+                                const std::string &filename)
+{
+    TimeSeries::Header header;
+    AssertThrow (size >= sizeof (header),
+                 std::runtime_error (filename + " is not a time series file"));
+    std::memcpy (&header, data, sizeof (header));
+    AssertThrow (std::memcmp (header.magic, magic, sizeof (magic)) == 0,
+                 std::runtime_error (filename + " is not a time series file"));
+    AssertThrow (header.version == version && header.byte_order == byte_order,
+                 std::runtime_error (filename
+                                     + " has an unsupported version or byte "
+                                       "order"));
+    header.field_name[sizeof (header.field_name) - 1] = '\0';
+    return header;
+}
+
+// Builds the index of the frames of a time series file that has not been
+// closed from the frame headers. A partly written last frame is ignored.
+std::vector<TimeSeries::IndexEntry>
+rebuild_index (const char *data, const std::size_t size,
+               const TimeSeries::Header &header)
+{
+    const std::size_t frame_bytes
+        = sizeof (TimeSeries::FrameHeader) + header.n_values * sizeof (double);
+    std::vector<TimeSeries::IndexEntry> index;
+    for (std::size_t offset = sizeof (header); offset + frame_bytes <= size;
+         offset += frame_bytes)
+    {
+        TimeSeries::FrameHeader frame;
+        std::memcpy (&frame, data + offset, sizeof (frame));
+        index.push_back ({ frame.time, frame.timestep_number,
+                           offset + sizeof (frame) });
+    }
+    return index;
+}
+} // namespace
+
+TimeSeriesWriter::TimeSeriesWriter (const std::string &filename,
+                                    const std::string &field_name,
+                                    const unsigned int n_values,
+                                    const bool         append)
+{
+    AssertThrow (field_name.size () < sizeof (header.field_name),
+                 std::runtime_error ("Field name " + field_name
+                                     + " is too long"));
+
+    const std::uint64_t frame_bytes = sizeof (TimeSeries::FrameHeader)
+                                      + std::uint64_t (n_values)
+                                            * sizeof (double);
+    if (append && std::filesystem::exists (filename))
+    {
+        {
+            const TimeSeriesReader reader (filename);
+            AssertThrow (reader.field_name () == field_name
+                             && reader.n_values () == n_values,
+                         std::runtime_error (filename
+                                             + " holds a different field"));
+            for (unsigned int f = 0; f < reader.n_frames (); f++)
+                index.push_back ({ reader.time (f),
+                                   reader.timestep_number (f),
+                                   sizeof (header) + f * frame_bytes
+                                       + sizeof (TimeSeries::FrameHeader) });
+        }
+        // Removes the index, and any partly written frame
+        end_of_frames = sizeof (header) + index.size () * frame_bytes;
+        std::filesystem::resize_file (filename, end_of_frames);
+        file.open (filename, std::ios::in | std::ios::out | std::ios::binary);
+    }
+    else
+    {
+        file.open (filename, std::ios::in | std::ios::out | std::ios::binary
+                                 | std::ios::trunc);
+        end_of_frames = sizeof (header);
+    }
+    AssertThrow (file, std::runtime_error ("Could not open " + filename));
+
+    std::memset (&header, 0, sizeof (header));
+    std::memcpy (header.magic, magic, sizeof (magic));
+    header.version    = version;
+    header.byte_order = byte_order;
+    header.n_values   = n_values;
+    std::memcpy (header.field_name, field_name.data (), field_name.size ());
+
+    // Until the file is closed, the header says it has not been, so that
+    // readers rebuild the index
+    file.seekp (0);
+    file.write (reinterpret_cast<const char *> (&header), sizeof (header));
+    file.seekp (end_of_frames);
+}
+
+TimeSeriesWriter::~TimeSeriesWriter ()
+{
+    if (!file.is_open ())
+        return;
+    try
+    {
+        close ();
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "WARNING: closing time series failed: " << e.what ()
+                  << std::endl;
+    }
+}
+
+void TimeSeriesWriter::append (const unsigned int     timestep_number,
+                               const double           time,
+                               const Eigen::VectorXd &values)
+{
+    AssertThrow (file.is_open (),
+                 std::runtime_error ("Time series has been closed"));
+    AssertThrow (values.size () == static_cast<long> (header.n_values),
+                 std::runtime_error ("Wrong number of values"));
+
+    const TimeSeries::FrameHeader frame { time, timestep_number };
+    std::vector<char>             buffer (sizeof (frame)
+                              + values.size () * sizeof (double));
+    std::memcpy (buffer.data (), &frame, sizeof (frame));
+    std::memcpy (buffer.data () + sizeof (frame), values.data (),
+                 values.size () * sizeof (double));
+    // The frame header and values are written with one call, and flushed so
+    // that the frame can be read even if the run ends without closing the
+    // file
+    file.write (buffer.data (), buffer.size ());
+    file.flush ();
+    AssertThrow (file, std::runtime_error ("Writing time series failed"));
+
+    index.push_back (
+        { time, timestep_number, end_of_frames + sizeof (frame) });
+    end_of_frames += buffer.size ();
+}
+
+void TimeSeriesWriter::close ()
+{
+    AssertThrow (file.is_open (),
+                 std::runtime_error ("Time series has been closed"));
+    file.write (reinterpret_cast<const char *> (index.data ()),
+                index.size () * sizeof (TimeSeries::IndexEntry));
+    header.n_frames     = index.size ();
+    header.index_offset = end_of_frames;
+    file.seekp (0);
+    file.write (reinterpret_cast<const char *> (&header), sizeof (header));
+    file.close ();
+    AssertThrow (file, std::runtime_error ("Writing time series failed"));
+}
+
+TimeSeriesReader::TimeSeriesReader (const std::string &filename)
+    : file (filename)
+{
+    const TimeSeries::Header header
+        = read_header (file.data (), file.size (), filename);
+    field_name_ = header.field_name;
+    n_values_   = header.n_values;
+
+    if (header.index_offset == 0)
+    {
+        index = rebuild_index (file.data (), file.size (), header);
+        return;
+    }
+
+    AssertThrow (header.index_offset
+                         + header.n_frames * sizeof (TimeSeries::IndexEntry)
+                     == file.size (),
+                 std::runtime_error (filename + " is damaged"));
+    index.resize (header.n_frames);
+    std::memcpy (index.data (), file.data () + header.index_offset,
+                 header.n_frames * sizeof (TimeSeries::IndexEntry));
+    for (const TimeSeries::IndexEntry &entry : index)
+        AssertThrow (entry.offset % sizeof (double) == 0
+                         && entry.offset + n_values_ * sizeof (double)
+                                <= header.index_offset,
+                     std::runtime_error (filename + " is damaged"));
+}
+
+void write_time_directories (
+    const TimeSeriesReader &time_series,
+    const BoundaryConditions &boundary_conditions,
+    const Outputter::Format format,
+    const std::vector<unsigned int> &original_cell_index)
+{
+    Eigen::VectorXd values;
+    for (unsigned int f = 0; f < time_series.n_frames (); f++)
+    {
+        const double dt
+            = f == 0 ? 0. : time_series.time (f) - time_series.time (f - 1);
+        Outputter outputter (time_series.timestep_number (f),
+                             time_series.time (f), dt, dt, 2, format);
+        outputter.write_time ();
+        values = time_series.values (f);
+        outputter.write_scalar_field (values, time_series.field_name (),
+                                      boundary_conditions,
+                                      original_cell_index);
+    }
+}
+
+} // namespace FVMCode
@@ -1,17 +1,241 @@
+#include <FVMCode/renumbering.h>
 #include <FVMCode/unstructured_mesh.h>
 
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
 namespace FVMCode
 {
 
+void UnstructuredMesh::build_search_tree ()
+{
+    search_tree = std::make_shared<const CellSearchTree> (cell_list);
+}
+
+unsigned int UnstructuredMesh::find_cell (const Point<3> &point) const
+{
+    if (search_tree)
+        return search_tree->find_cell (cell_list, point);
+
+    for (unsigned int cell_no = 0; cell_no < n_cells (); cell_no++)
+    {
+        if (cell_list[cell_no].point_inside (point))
+            return cell_no;
+    }
+    return CellSearchTree::invalid_cell;
+}
+
 unsigned int UnstructuredMesh::get_cell_containing_point(const Point<3>& point)
 {
-    for (unsigned int cell_no = 0; cell_no < n_cells(); cell_no++)
+    const unsigned int cell_no = find_cell (point);
+    AssertThrow (cell_no != CellSearchTree::invalid_cell,
+                 std::out_of_range ("Point lies outside the mesh"));
+    return cell_no;
+}
+
+unsigned int
+UnstructuredMesh::get_cell_containing_point (const Point<3>    &point,
+                                             const unsigned int hint_cell)
+{
+    AssertIndexRange (hint_cell, n_cells ());
+
+    // Cells are convex, so the walk cannot revisit a cell unless the point
+    // lies outside the mesh or the mesh is badly distorted. The step limit
+    // guards against cycling in the latter case.
+    unsigned int current = hint_cell;
+    for (unsigned int step = 0; step < n_cells (); step++)
+    {
+        const Cell<3> &cell = cell_list[current];
+
+        double          max_distance = 0;
+        const Face<3>  *exit_face    = nullptr;
+        for (const auto &face : cell.faces ())
+        {
+            // Orient the normal out of the current cell
+            const Point<3> normal = face->normal ();
+            const double   orientation
+                = (normal.dot (face->center () - cell.center ()) > 0) ? 1 : -1;
+            const double distance
+                = orientation * normal.dot (point - face->center ());
+            if (distance > max_distance)
+            {
+                max_distance = distance;
+                exit_face    = &*face;
+            }
+        }
+
+        if (exit_face == nullptr)
+            return current;
+        if (exit_face->is_boundary ())
+            break;
+
+        const auto &neighbours = exit_face->neighbour_indices ();
+        current = (neighbours[0] == current) ? neighbours[1] : neighbours[0];
+    }
+
+    return get_cell_containing_point (point);
+}
+
+std::vector<unsigned int> UnstructuredMesh::get_cells_containing_points (
+    const std::vector<Point<3> > &points, const unsigned int n_threads)
+{
+    std::vector<unsigned int> cells (points.size ());
+    Parallel::parallel_for (
+        0, points.size (), n_threads,
+        [&] (const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; i++)
+                cells[i] = find_cell (points[i]);
+        });
+    return cells;
+}
+
+unsigned int UnstructuredMesh::matrix_band () const
+{
+    unsigned int band = 0;
+    for (const Face<3> &face : face_list)
     {
-        const auto& cell = get_cell(cell_no);
-        if (cell->point_inside(point)) return cell_no;
+        if (face.is_boundary ())
+            continue;
+        const unsigned int a = face.neighbour_list[0];
+        const unsigned int b = face.neighbour_list[1];
+        band                 = std::max (band, a > b ? a - b : b - a);
     }
-    Assert(false, "Point lies outside the mesh!");
-    return -1;
+    return band;
+}
+
+UnstructuredMesh::RenumberingReport UnstructuredMesh::renumber_cells_rcm ()
+{
+    RenumberingReport report;
+    report.band_before = matrix_band ();
+
+    std::vector<std::pair<unsigned int, unsigned int> > edges;
+    for (const Face<3> &face : face_list)
+        if (!face.is_boundary ())
+            edges.emplace_back (face.neighbour_list[0], face.neighbour_list[1]);
+    renumber_cells (Renumbering::reverse_cuthill_mckee (n_cells (), edges));
+
+    report.band_after = matrix_band ();
+    return report;
+}
+
+UnstructuredMesh::RenumberingReport
+UnstructuredMesh::renumber_space_filling_curve (
+    const Renumbering::SpaceFillingCurve curve)
+{
+    RenumberingReport report;
+    report.band_before = matrix_band ();
+
+    renumber_points (Renumbering::space_filling_curve_order (point_list, curve));
+
+    std::vector<Point<3> > cell_centers (n_cells ());
+    for (unsigned int c = 0; c < n_cells (); c++)
+        cell_centers[c] = cell_list[c].center ();
+    renumber_cells (
+        Renumbering::space_filling_curve_order (cell_centers, curve));
+
+    report.band_after = matrix_band ();
+    return report;
+}
+
+void UnstructuredMesh::renumber_points (
+    const std::vector<unsigned int> &new_to_old)
+{
+    Assert (new_to_old.size () == n_points (), "Permutation has wrong size");
+    const std::vector<unsigned int> old_to_new
+        = Renumbering::invert_permutation (new_to_old);
+
+    PointList new_point_list (n_points ());
+    for (unsigned int p = 0; p < n_points (); p++)
+        new_point_list[p] = point_list[new_to_old[p]];
+
+    for (Face<3> &face : face_list)
+        for (PointIterator &vertex : face.vertex_list)
+            vertex = new_point_list.begin ()
+                     + old_to_new[vertex - point_list.begin ()];
+
+    point_list = std::move (new_point_list);
+}
+
+void UnstructuredMesh::renumber_cells (
+    const std::vector<unsigned int> &new_to_old)
+{
+    Assert (new_to_old.size () == n_cells (), "Permutation has wrong size");
+    const std::vector<unsigned int> old_to_new
+        = Renumbering::invert_permutation (new_to_old);
+
+    // Relabel the faces' cells, making the lower index the owner of each
+    // internal face. Swapping owner and neighbour flips the face, so the
+    // vertex order and area vector are reversed to keep the normal pointing
+    // from owner to neighbour.
+    unsigned int n_internal_faces = 0;
+    for (Face<3> &face : face_list)
+    {
+        for (unsigned int &cell : face.neighbour_list)
+            cell = old_to_new[cell];
+
+        if (face.is_boundary ())
+            continue;
+        Assert (&face == &face_list[n_internal_faces],
+                "Internal faces must be numbered before boundary faces");
+        n_internal_faces++;
+
+        if (face.neighbour_list[0] > face.neighbour_list[1])
+        {
+            std::swap (face.neighbour_list[0], face.neighbour_list[1]);
+            std::reverse (face.vertex_list.begin () + 1,
+                          face.vertex_list.end ());
+            face.area_vec *= -1;
+            face.interpolation_factor_ = 1. - face.interpolation_factor_;
+        }
+    }
+
+    // Sort the internal faces by owner, then neighbour
+    std::vector<unsigned int> new_to_old_faces (n_faces ());
+    std::iota (new_to_old_faces.begin (), new_to_old_faces.end (), 0);
+    std::sort (new_to_old_faces.begin (),
+               new_to_old_faces.begin () + n_internal_faces,
+               [&] (const unsigned int a, const unsigned int b) {
+                   return face_list[a].neighbour_list
+                          < face_list[b].neighbour_list;
+               });
+    const std::vector<unsigned int> old_to_new_faces
+        = Renumbering::invert_permutation (new_to_old_faces);
+
+    FaceList new_face_list;
+    new_face_list.reserve (n_faces ());
+    for (const unsigned int f : new_to_old_faces)
+        new_face_list.push_back (std::move (face_list[f]));
+
+    // Move the cells into their new positions and point them at the
+    // reordered faces. Cell geometry does not change.
+    CellList new_cell_list;
+    new_cell_list.reserve (n_cells ());
+    for (const unsigned int c : new_to_old)
+    {
+        new_cell_list.push_back (std::move (cell_list[c]));
+        Cell<3> &cell = new_cell_list.back ();
+        for (FaceIterator &face : cell.face_list)
+            face = new_face_list.begin ()
+                   + old_to_new_faces[face - face_list.begin ()];
+        for (unsigned int &neighbour : cell.neighbour_list)
+            neighbour = old_to_new[neighbour];
+    }
+
+    face_list = std::move (new_face_list);
+    cell_list = std::move (new_cell_list);
+
+    // Compose with any earlier renumbering
+    std::vector<unsigned int> original (n_cells ());
+    for (unsigned int c = 0; c < n_cells (); c++)
+        original[c] = original_cell_index.empty ()
+                          ? new_to_old[c]
+                          : original_cell_index[new_to_old[c]];
+    original_cell_index = std::move (original);
+
+    // The search tree stores cell indices, so it has to be rebuilt
+    if (search_tree)
+        build_search_tree ();
 }
 
-} // namespace FVMCode
\ No newline at end of file
+} // namespace FVMCode
@@ -0,0 +1,324 @@
+#include <FVMCode/vtu_output.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace FVMCode
+{
+
+namespace
+{
+// VTK cell types
+constexpr std::uint8_t vtk_hexahedron = 12;
+constexpr std::uint8_t vtk_polyhedron = 42;
+
+bool little_endian ()
+{
+    const std::uint16_t one = 1;
+    char                first_byte;
+    std::memcpy (&first_byte, &one, 1);
+    return first_byte == 1;
+}
+
+// Shortest representation of value that reads back exactly
+std::string exact_string (const double value)
+{
+    char buffer[32];
+    return std::string (buffer,
+                        std::to_chars (buffer, buffer + sizeof (buffer), value)
+                            .ptr);
+}
+
+// Appends an array to the raw appended data, preceded by its size in bytes,
+// and returns the offset of the array
+template <typename T>
+std::size_t append_array (std::vector<char> &data, const std::vector<T> &array)
+{
+    const std::size_t   offset = data.size ();
+    const std::uint64_t bytes  = array.size () * sizeof (T);
+    data.resize (offset + sizeof (bytes) + bytes);
+    std::memcpy (data.data () + offset, &bytes, sizeof (bytes));
+    std::memcpy (data.data () + offset + sizeof (bytes), array.data (), bytes);
+    return offset;
+}
+
+// If the cell with the outward oriented faces cell_faces is a hexahedron,
+// puts its vertices in the order of a VTK hexahedron into vertices, i.e. a
+// face whose normal points into the cell followed by the opposite vertex of
+// each of its vertices, and returns true
+bool hexahedron_vertices (
+    const std::vector<std::vector<std::int64_t> > &cell_faces,
+    std::array<std::int64_t, 8>                   &vertices)
+{
+    if (cell_faces.size () != 6)
+        return false;
+    for (const auto &face : cell_faces)
+        if (face.size () != 4)
+            return false;
+
+    const auto first = vertices.begin (), bottom_end = first + 4;
+    std::reverse_copy (cell_faces[0].begin (), cell_faces[0].end (), first);
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        // The opposite vertex shares an edge of a side face with vertex i
+        bool found = false;
+        for (unsigned int f = 1; f < 6 && !found; f++)
+        {
+            const auto &face = cell_faces[f];
+            const auto  position
+                = std::find (face.begin (), face.end (), vertices[i]);
+            if (position == face.end ())
+                continue;
+            const unsigned int p = position - face.begin ();
+            for (const std::int64_t candidate :
+                 { face[(p + 1) % 4], face[(p + 3) % 4] })
+                if (std::find (first, bottom_end, candidate) == bottom_end)
+                {
+                    vertices[4 + i] = candidate;
+                    found           = true;
+                }
+        }
+        if (!found)
+            return false;
+    }
+
+    std::array<std::int64_t, 8> sorted = vertices;
+    std::sort (sorted.begin (), sorted.end ());
+    return std::adjacent_find (sorted.begin (), sorted.end ())
+           == sorted.end ();
+}
+
+std::string data_array (const std::string &type, const std::string &name,
+                        const std::size_t offset,
+                        const unsigned int n_components = 1)
+{
+    std::string xml = "<DataArray type=\"" + type + "\" Name=\"" + name + "\"";
+    if (n_components > 1)
+        xml += " NumberOfComponents=\"" + std::to_string (n_components) + "\"";
+    return xml + " format=\"appended\" offset=\"" + std::to_string (offset)
+           + "\"/>\n";
+}
+} // namespace
+
+VTUWriter::VTUWriter (UnstructuredMesh &mesh, const std::string &directory,
+                      const std::string &base_name, const bool append)
+    : directory (directory)
+    , base_name (base_name)
+    , n_cells (mesh.n_cells ())
+{
+    std::filesystem::create_directories (directory);
+
+    // Points
+    std::vector<double> points;
+    points.reserve (3 * mesh.n_points ());
+    for (unsigned int p = 0; p < mesh.n_points (); p++)
+        for (unsigned int d = 0; d < 3; d++)
+            points.push_back ((*mesh.get_point (p)) (d));
+
+    // Cells. Hexahedra are written as VTK hexahedra, and all other cells as
+    // polyhedra, whose connectivity lists their distinct vertices and whose
+    // faces are given separately as the number of faces followed by the
+    // number of vertices and the vertices of each face.
+    std::vector<std::int64_t> connectivity, offsets, faces, face_offsets;
+    std::vector<std::uint8_t> types;
+    offsets.reserve (n_cells);
+    face_offsets.reserve (n_cells);
+    types.reserve (n_cells);
+    const UnstructuredMesh::PointIterator first_point
+        = mesh.n_points () > 0 ? mesh.get_point (0)
+                               : UnstructuredMesh::PointIterator ();
+    std::vector<std::vector<std::int64_t> > cell_faces;
+    std::array<std::int64_t, 8>             hexahedron;
+    bool                                    has_polyhedra = false;
+    for (unsigned int c = 0; c < n_cells; c++)
+    {
+        // The vertices of the faces, oriented out of the cell
+        cell_faces.clear ();
+        for (const auto &face : mesh.get_cell (c)->faces ())
+        {
+            cell_faces.emplace_back ();
+            for (const auto &vertex : face->vertices ())
+                cell_faces.back ().push_back (vertex - first_point);
+            if (face->neighbour_indices ()[0] != c)
+                std::reverse (cell_faces.back ().begin (),
+                              cell_faces.back ().end ());
+        }
+
+        if (hexahedron_vertices (cell_faces, hexahedron))
+        {
+            connectivity.insert (connectivity.end (), hexahedron.begin (),
+                                 hexahedron.end ());
+            types.push_back (vtk_hexahedron);
+            face_offsets.push_back (-1);
+        }
+        else
+        {
+            const std::size_t first_vertex = connectivity.size ();
+            faces.push_back (cell_faces.size ());
+            for (const auto &face : cell_faces)
+            {
+                faces.push_back (face.size ());
+                faces.insert (faces.end (), face.begin (), face.end ());
+                for (const std::int64_t v : face)
+                    if (std::find (connectivity.begin () + first_vertex,
+                                   connectivity.end (), v)
+                        == connectivity.end ())
+                        connectivity.push_back (v);
+            }
+            types.push_back (vtk_polyhedron);
+            face_offsets.push_back (faces.size ());
+            has_polyhedra = true;
+        }
+        offsets.push_back (connectivity.size ());
+    }
+
+    piece_xml = "    <Piece NumberOfPoints=\""
+                + std::to_string (mesh.n_points ()) + "\" NumberOfCells=\""
+                + std::to_string (n_cells) + "\">\n";
+
+    // Labels are written as 32 bit integers unless they do not fit
+    const bool narrow
+        = std::max ({ std::size_t (mesh.n_points ()), connectivity.size (),
+                      faces.size () })
+          < std::size_t (std::numeric_limits<std::int32_t>::max ());
+    const std::string label_type = narrow ? "Int32" : "Int64";
+    auto append_labels = [&] (const std::vector<std::int64_t> &labels) {
+        if (!narrow)
+            return append_array (geometry_data, labels);
+        return append_array (geometry_data,
+                             std::vector<std::int32_t> (labels.begin (),
+                                                        labels.end ()));
+    };
+
+    geometry_xml = "      <Points>\n        "
+                   + data_array ("Float64", "Points",
+                                 append_array (geometry_data, points), 3)
+                   + "      </Points>\n      <Cells>\n";
+    geometry_xml += "        "
+                    + data_array (label_type, "connectivity",
+                                  append_labels (connectivity));
+    geometry_xml += "        "
+                    + data_array (label_type, "offsets",
+                                  append_labels (offsets));
+    geometry_xml += "        "
+                    + data_array ("UInt8", "types",
+                                  append_array (geometry_data, types));
+    if (has_polyhedra)
+    {
+        geometry_xml += "        "
+                        + data_array (label_type, "faces",
+                                      append_labels (faces));
+        geometry_xml += "        "
+                        + data_array (label_type, "faceoffsets",
+                                      append_labels (face_offsets));
+    }
+    geometry_xml += "      </Cells>\n";
+
+    // Keeps the outputs of an existing collection, which has been written by
+    // write_collection()
+    std::ifstream collection (directory + "/" + base_name + ".pvd");
+    std::string   line;
+    while (append && std::getline (collection, line))
+    {
+        const std::size_t time_start = line.find ("timestep=\"");
+        const std::size_t file_start = line.find ("file=\"");
+        if (time_start == std::string::npos
+            || file_start == std::string::npos)
+            continue;
+        const std::size_t time_begin = time_start + 10;
+        const std::size_t file_begin = file_start + 6;
+        outputs.emplace_back (
+            std::stod (line.substr (time_begin,
+                                    line.find ('"', time_begin) - time_begin)),
+            line.substr (file_begin,
+                         line.find ('"', file_begin) - file_begin));
+    }
+}
+
+void VTUWriter::write_scalar_fields (const double time, const Fields &fields)
+{
+    // Outputs of an earlier run at or after this time are replaced
+    while (!outputs.empty () && outputs.back ().first >= time)
+        outputs.pop_back ();
+
+    std::string xml = "<?xml version=\"1.0\"?>\n"
+                      "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" "
+                      "byte_order=\"";
+    xml += little_endian () ? "LittleEndian" : "BigEndian";
+    xml += "\" header_type=\"UInt64\">\n  <UnstructuredGrid>\n" + piece_xml;
+    if (!fields.empty ())
+    {
+        xml += "      <CellData Scalars=\"" + fields[0].first + "\">\n";
+        std::size_t offset = geometry_data.size ();
+        for (const auto &[name, field] : fields)
+        {
+            AssertThrow (field->size () == static_cast<long> (n_cells),
+                         std::runtime_error ("Field " + name
+                                             + " has the wrong size"));
+            xml += "        " + data_array ("Float64", name, offset);
+            offset += sizeof (std::uint64_t) + n_cells * sizeof (double);
+        }
+        xml += "      </CellData>\n";
+    }
+    xml += geometry_xml
+           + "    </Piece>\n  </UnstructuredGrid>\n"
+             "  <AppendedData encoding=\"raw\">\n_";
+
+    const std::string file_name
+        = base_name + "_" + std::to_string (outputs.size ()) + ".vtu";
+    std::ofstream file (directory + "/" + file_name, std::ios::binary);
+    AssertThrow (file, std::runtime_error ("Could not open " + directory + "/"
+                                           + file_name));
+    file.write (xml.data (), xml.size ());
+    file.write (geometry_data.data (), geometry_data.size ());
+    for (const auto &field : fields)
+    {
+        const std::uint64_t bytes = n_cells * sizeof (double);
+        file.write (reinterpret_cast<const char *> (&bytes), sizeof (bytes));
+        file.write (reinterpret_cast<const char *> (field.second->data ()),
+                    bytes);
+    }
+    file << "\n  </AppendedData>\n</VTKFile>\n";
+    file.close ();
+    AssertThrow (file, std::runtime_error ("Could not write " + directory
+                                           + "/" + file_name));
+
+    outputs.emplace_back (time, file_name);
+    write_collection ();
+}
+
+void VTUWriter::write_scalar_field (const double           time,
+                                    const Eigen::VectorXd &scalar_field,
+                                    const std::string     &name)
+{
+    write_scalar_fields (time, { { name, &scalar_field } });
+}
+
+void VTUWriter::write_collection () const
+{
+    // Written to a temporary file first, so that a crash never leaves a
+    // truncated collection behind
+    const std::string file_name = directory + "/" + base_name + ".pvd";
+    {
+        std::ofstream file (file_name + ".tmp");
+        file << "<?xml version=\"1.0\"?>\n"
+                "<VTKFile type=\"Collection\" version=\"1.0\">\n"
+                "  <Collection>\n";
+        for (const auto &[time, output_file] : outputs)
+            file << "    <DataSet timestep=\"" << exact_string (time)
+                 << "\" file=\"" << output_file << "\"/>\n";
+        file << "  </Collection>\n</VTKFile>\n";
+        AssertThrow (file,
+                     std::runtime_error ("Could not write " + file_name));
+    }
+    std::filesystem::rename (file_name + ".tmp", file_name);
+}
+
+} // namespace FVMCode
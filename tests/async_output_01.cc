@@ -0,0 +1,194 @@
+#include <FVMCode/async_output.h>
+#include <FVMCode/field_reader.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/output.h>
+#include <FVMCode/time_series.h>
+#include <FVMCode/unstructured_mesh.h>
+#include <FVMCode/vtu_output.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+// Returns the internal field of field_name in the time directory of time
+Eigen::VectorXd read_field (const double time, const std::string &field_name,
+                            const unsigned int                n_cells,
+                            const std::vector<BoundaryPatch> &patches)
+{
+    Eigen::VectorXd    field;
+    BoundaryConditions boundary_conditions;
+    Input::read_scalar_field (Outputter::name_from_time (time, 2) + "/"
+                                  + field_name,
+                              n_cells, patches, field, boundary_conditions);
+    return field;
+}
+
+int async_output_01 (int, char **)
+{
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (mesh, "mesh_1d/points", "mesh_1d/faces",
+                                   "mesh_1d/owner", "mesh_1d/neighbour",
+                                   "mesh_1d/boundary");
+    const unsigned int               n_cells = mesh.n_cells ();
+    const std::vector<BoundaryPatch> patches = mesh.get_patches ();
+    BoundaryConditions               boundary_conditions;
+    for (const BoundaryPatch &patch : patches)
+        boundary_conditions.emplace_back (
+            patch, BoundaryFieldEntry (patch.type == empty ? "empty"
+                                                           : "zeroGradient",
+                                       0));
+
+    // The time directories are written to the working directory
+    const std::filesystem::path working_directory
+        = std::filesystem::current_path ();
+    std::filesystem::remove_all ("async_output_01");
+    std::filesystem::create_directory ("async_output_01");
+    std::filesystem::current_path ("async_output_01");
+
+    {
+        AsyncOutputter  outputter;
+        Eigen::VectorXd field (n_cells);
+        for (unsigned int n = 0; n < 6; n++)
+        {
+            field.setConstant (n);
+            outputter.write_scalar_field (n, 0.5 * n, 0.5, 0.5, field, "T",
+                                          boundary_conditions);
+            // The field was copied, so changing it does not change the
+            // output
+            field.setConstant (-1);
+        }
+        outputter.flush ();
+        AssertTest (outputter.n_written () == 6);
+        AssertTest (outputter.blocked_time () >= 0);
+        for (unsigned int n = 0; n < 6; n++)
+            AssertTest (read_field (0.5 * n, "T", n_cells, patches)
+                        == Eigen::VectorXd::Constant (n_cells, n));
+
+        // Errors are reported by the next call, after which the outputter
+        // can still be used
+        {
+            std::ofstream blocking_file ("9.00");
+        }
+        field.setConstant (9);
+        outputter.write_scalar_field (9, 9., 0.5, 0.5, field, "T",
+                                      boundary_conditions);
+        bool caught = false;
+        try
+        {
+            outputter.flush ();
+        }
+        catch (std::exception &)
+        {
+            caught = true;
+        }
+        AssertTest (caught);
+        outputter.write_scalar_field (10, 10., 0.5, 0.5, field, "T",
+                                      boundary_conditions);
+        outputter.flush ();
+        AssertTest (read_field (10., "T", n_cells, patches) == field);
+    }
+    std::cout << "Tested writing" << std::endl;
+
+    {
+        // Everything queued is written before the destructor returns
+        Eigen::VectorXd field (n_cells);
+        {
+            AsyncOutputter outputter (3);
+            for (unsigned int n = 0; n < 4; n++)
+            {
+                field.setConstant (n + 20);
+                outputter.write_scalar_field (n + 20, n + 20., 1., 1., field,
+                                              "U", boundary_conditions);
+            }
+        }
+        for (unsigned int n = 0; n < 4; n++)
+            AssertTest (read_field (n + 20., "U", n_cells, patches)
+                        == Eigen::VectorXd::Constant (n_cells, n + 20));
+    }
+    std::cout << "Tested flush on destruction" << std::endl;
+
+    {
+        // The outputter also writes the fields with a VTUWriter
+        VTUWriter       vtu_writer (mesh, "VTK", "async");
+        Eigen::VectorXd field (n_cells);
+        {
+            AsyncOutputter outputter (1, Outputter::Format::ascii,
+                                      &vtu_writer);
+            for (unsigned int n = 0; n < 3; n++)
+            {
+                field.setConstant (n + 30);
+                outputter.write_scalar_field (n + 30, n + 30., 1., 1., field,
+                                              "V", boundary_conditions);
+            }
+            outputter.flush ();
+            AssertTest (vtu_writer.n_outputs () == 3);
+        }
+        for (unsigned int n = 0; n < 3; n++)
+        {
+            AssertTest (read_field (n + 30., "V", n_cells, patches)
+                        == Eigen::VectorXd::Constant (n_cells, n + 30));
+            AssertTest (std::filesystem::exists (
+                "VTK/async_" + std::to_string (n) + ".vtu"));
+        }
+        AssertTest (std::filesystem::exists ("VTK/async.pvd"));
+    }
+    std::cout << "Tested VTU output" << std::endl;
+
+    {
+        // The time series backend writes one file per field, in the cell
+        // order on disk, and appends to it when asked to
+        std::vector<unsigned int> original_cell_index (n_cells);
+        for (unsigned int c = 0; c < n_cells; c++)
+            original_cell_index[c] = n_cells - 1 - c;
+        const Eigen::VectorXd field
+            = Eigen::VectorXd::LinSpaced (n_cells, 0., 1.);
+        for (const bool append : { false, true })
+        {
+            AsyncOutputter outputter (1, Outputter::Format::ascii, nullptr,
+                                      AsyncOutputter::Backend::time_series,
+                                      append);
+            for (unsigned int n = 0; n < 3; n++)
+                outputter.write_scalar_field (
+                    n + 3 * append, n + 3. * append, 1., 1., (n + 1) * field,
+                    "W", boundary_conditions, original_cell_index);
+        }
+        const TimeSeriesReader time_series ("W.series");
+        AssertTest (time_series.field_name () == "W");
+        AssertTest (time_series.n_frames () == 6);
+        for (unsigned int f = 0; f < 6; f++)
+        {
+            AssertTest (time_series.timestep_number (f) == f);
+            AssertTest (time_series.time (f) == f);
+            for (unsigned int c = 0; c < n_cells; c++)
+                AssertTest (time_series.values (f) (original_cell_index[c])
+                            == (f % 3 + 1) * field (c));
+        }
+        AssertTest (!std::filesystem::exists (
+            Outputter::name_from_time (0., 2) + "/W"));
+    }
+    std::cout << "Tested time series output" << std::endl;
+
+    {
+        bool caught = false;
+        try
+        {
+            AsyncOutputter outputter (0);
+        }
+        catch (std::invalid_argument &)
+        {
+            caught = true;
+        }
+        AssertTest (caught);
+    }
+    std::cout << "Tested queue size" << std::endl;
+
+    std::filesystem::current_path (working_directory);
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,53 @@
+#include <FVMCode/cell_search_tree.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include "test_helpers.h"
+
+int cell_search_tree_01 (int, char **)
+{
+    // Checks that lookups through the search tree agree with the linear scan
+    // on the 1D mesh of 20 blocks, each with extent (0.005 0.1, 0.01),
+    // stacked in the x direction
+    using namespace FVMCode;
+
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (mesh, "mesh_1d/points", "mesh_1d/faces",
+                                   "mesh_1d/owner", "mesh_1d/neighbour",
+                                   "mesh_1d/boundary");
+
+    std::vector<Point<3> > points;
+    for (unsigned int i = 0; i <= 50; i++)
+        for (unsigned int j = 0; j <= 4; j++)
+            points.push_back (Point<3> (0.1 * i / 50., 0.1 * j / 4., 0.005));
+
+    std::vector<unsigned int> linear_cells;
+    for (const auto &point : points)
+        linear_cells.push_back (mesh.get_cell_containing_point (point));
+
+    AssertTest (!mesh.has_search_tree ());
+    mesh.build_search_tree ();
+    AssertTest (mesh.has_search_tree ());
+
+    for (unsigned int i = 0; i < points.size (); i++)
+    {
+        const unsigned int cell = mesh.get_cell_containing_point (points[i]);
+        AssertTest (cell == linear_cells[i]);
+        AssertTest (mesh.get_cell (cell)->point_inside (points[i]));
+    }
+
+    for (unsigned int n_threads = 1; n_threads <= 3; n_threads++)
+        AssertTest (mesh.get_cells_containing_points (points, n_threads)
+                    == linear_cells);
+
+    // Points outside the mesh
+    const std::vector<unsigned int> outside
+        = mesh.get_cells_containing_points (
+            { Point<3> (-0.05, 0.05, 0.005), Point<3> (0.05, 0.05, 0.02) });
+    AssertTest (outside[0] == CellSearchTree::invalid_cell);
+    AssertTest (outside[1] == CellSearchTree::invalid_cell);
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+#include <FVMCode/compact_mesh.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include "test_helpers.h"
+
+int compact_mesh_01 (int, char **)
+{
+    // This test case is for a 1D mesh of 20 blocks, each with extent (0.005
+    // 0.1, 0.01), and stacked in the x direction
+    using namespace FVMCode;
+
+    UnstructuredMesh       mesh;
+    CompactMesh            compact_mesh;
+    UnstructuredMeshParser parser (mesh, "mesh_1d/points", "mesh_1d/faces",
+                                   "mesh_1d/owner", "mesh_1d/neighbour",
+                                   "mesh_1d/boundary");
+    parser.build_compact_mesh (compact_mesh);
+
+    AssertTest (compact_mesh.n_points () == mesh.n_points ());
+    AssertTest (compact_mesh.n_faces () == mesh.n_faces ());
+    AssertTest (compact_mesh.n_cells () == mesh.n_cells ());
+    AssertTest (compact_mesh.n_internal_faces () == 19);
+    AssertTest (compact_mesh.get_patches ().size () == 3);
+
+    for (unsigned int f = 0; f < mesh.n_faces (); f++)
+    {
+        const auto &face = mesh.get_face (f);
+        AssertTest (compact_mesh.owner ()[f]
+                    == (int)face->neighbour_indices ()[0]);
+        if (f < compact_mesh.n_internal_faces ())
+            AssertTest (compact_mesh.neighbour ()[f]
+                        == (int)face->neighbour_indices ()[1]);
+
+        const int begin = compact_mesh.face_vertex_offsets ()[f];
+        const int end   = compact_mesh.face_vertex_offsets ()[f + 1];
+        AssertTest (end - begin == (int)face->n_vertices ());
+        for (int v = begin; v < end; v++)
+        {
+            const unsigned int point_index = compact_mesh.face_vertices ()[v];
+            AssertTest (mesh.get_point (point_index)
+                        == face->vertices ()[v - begin]);
+            for (unsigned int d = 0; d < 3; d++)
+                AssertTest (compact_mesh.points ()[d][point_index]
+                            == (*face->vertices ()[v - begin]) (d));
+        }
+
+        for (unsigned int d = 0; d < 3; d++)
+        {
+            AssertTest (compact_mesh.face_area_vectors ()[d][f]
+                        == face->area_vector () (d));
+            AssertTest (compact_mesh.face_centers ()[d][f]
+                        == face->center () (d));
+        }
+        AssertTest (compact_mesh.face_areas ()[f] == face->area ());
+        AssertTest (compact_mesh.face_deltas ()[f] == face->delta ());
+        AssertTest (compact_mesh.face_interpolation_factors ()[f]
+                    == face->interpolation_factor ());
+    }
+
+    for (unsigned int c = 0; c < mesh.n_cells (); c++)
+    {
+        const auto &cell  = mesh.get_cell (c);
+        const int   begin = compact_mesh.cell_face_offsets ()[c];
+        const int   end   = compact_mesh.cell_face_offsets ()[c + 1];
+        AssertTest (end - begin == 6);
+        for (int f = begin; f < end; f++)
+            AssertTest (mesh.get_face (compact_mesh.cell_faces ()[f])
+                        == cell->faces ()[f - begin]);
+        AssertTest (close (compact_mesh.cell_volumes ()[c], cell->volume ()));
+        for (unsigned int d = 0; d < 3; d++)
+            AssertTest (compact_mesh.cell_centers ()[d][c]
+                        == cell->center () (d));
+    }
+
+    AssertTest (compact_mesh.memory_consumption () > 0);
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+#include <FVMCode/face_colouring.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+// Checks that every internal face has exactly one colour, that the colour
+// ranges agree with colour_of_face, and that no two faces of a colour share
+// a cell
+void check_colouring (UnstructuredMesh &mesh, const FaceColouring &colouring)
+{
+    const unsigned int n_internal_faces = mesh.get_patches ()[0].start_face;
+    AssertTest (colouring.n_faces () == n_internal_faces);
+
+    std::vector<unsigned int> face_count (n_internal_faces, 0);
+    for (unsigned int c = 0; c < colouring.n_colours (); c++)
+    {
+        AssertTest (colouring.colour (c).size () > 0);
+        std::vector<bool> cell_used (mesh.n_cells (), false);
+        for (const unsigned int f : colouring.colour (c))
+        {
+            AssertTest (colouring.colour_of_face (f) == c);
+            face_count[f]++;
+            for (const unsigned int cell :
+                 mesh.get_face (f)->neighbour_indices ())
+            {
+                AssertTest (!cell_used[cell]);
+                cell_used[cell] = true;
+            }
+        }
+    }
+    for (const unsigned int count : face_count)
+        AssertTest (count == 1);
+}
+
+int face_colouring_01 (int, char **)
+{
+    {
+        // 1D mesh of 20 blocks, each with extent (0.005 0.1, 0.01), and
+        // stacked in the x direction
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (mesh, "mesh_1d/points", "mesh_1d/faces",
+                                       "mesh_1d/owner", "mesh_1d/neighbour",
+                                       "mesh_1d/boundary");
+
+        FaceColouring colouring (mesh);
+        check_colouring (mesh, colouring);
+        // A chain alternates between two colours
+        AssertTest (colouring.n_colours () == 2);
+        AssertTest (colouring.colour (0).size () == 10);
+        AssertTest (colouring.colour (1).size () == 9);
+
+        // Compare multithreaded and serial matrix vector products
+        SparsityPattern sp (mesh);
+        SparseMatrix    matrix (sp);
+        for (unsigned int f = 0; f < colouring.n_faces (); f++)
+        {
+            const auto &cells = mesh.get_face (f)->neighbour_indices ();
+            matrix (cells[0], cells[1]) = -1. - f;
+            matrix (cells[1], cells[0]) = -2. + 0.5 * f;
+        }
+        for (unsigned int i = 0; i < mesh.n_cells (); i++)
+            matrix (i, i) = 40. + i;
+
+        VectorXd x (mesh.n_cells ());
+        for (unsigned int i = 0; i < mesh.n_cells (); i++) x (i) = 1. + i * i;
+
+        VectorXd serial, parallel;
+        matrix.vmult (x, serial);
+        for (const unsigned int n_threads : { 1, 2, 3, 8 })
+        {
+            Parallel::ThreadPool pool (n_threads);
+            matrix.vmult (x, parallel, colouring, pool);
+            for (unsigned int i = 0; i < mesh.n_cells (); i++)
+                AssertTest (close (serial (i), parallel (i)));
+
+            parallel = x;
+            matrix.vmult_add (x, parallel, colouring, pool);
+            for (unsigned int i = 0; i < mesh.n_cells (); i++)
+                AssertTest (close (serial (i) + x (i), parallel (i)));
+        }
+    }
+
+    {
+        // 2D mesh of 4 blocks, 2x2x1 and overall 1m x 1m x 1m
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, "unstructured_mesh_04/points", "unstructured_mesh_04/faces",
+            "unstructured_mesh_04/owner", "unstructured_mesh_04/neighbour",
+            "unstructured_mesh_04/boundary");
+
+        FaceColouring colouring (mesh);
+        check_colouring (mesh, colouring);
+        AssertTest (colouring.n_colours () == 2);
+
+        // Scatter face contributions to both cells in parallel
+        Parallel::ThreadPool pool (2);
+        std::vector<unsigned int> n_faces_of_cell (mesh.n_cells (), 0);
+        colouring.for_each_face (pool, [&] (const unsigned int f) {
+            for (const unsigned int cell :
+                 mesh.get_face (f)->neighbour_indices ())
+                n_faces_of_cell[cell]++;
+        });
+        for (const unsigned int count : n_faces_of_cell)
+            AssertTest (count == 2);
+    }
+
+    {
+        // Explicit graph: a triangle needs three colours
+        FaceColouring colouring (3, { 0, 1, 0 }, { 1, 2, 2 });
+        AssertTest (colouring.n_colours () == 3);
+        for (unsigned int f = 0; f < 3; f++)
+            AssertTest (colouring.colour_of_face (f) == f);
+    }
+
+    {
+        // Explicit graph: a star needs one colour per leaf, beyond the 64
+        // bits of one word of colours
+        for (const unsigned int n_leaves : { 64, 65, 200 })
+        {
+            std::vector<unsigned int> owner (n_leaves, 0), neighbour;
+            for (unsigned int leaf = 1; leaf <= n_leaves; leaf++)
+                neighbour.push_back (leaf);
+            // A second face between the centre and the first leaf, and a
+            // face between two leaves that can reuse colour 0
+            owner.push_back (1);
+            neighbour.push_back (0);
+            owner.push_back (3);
+            neighbour.push_back (4);
+            FaceColouring colouring (n_leaves + 1, owner, neighbour);
+            AssertTest (colouring.n_colours () == n_leaves + 1);
+            for (unsigned int f = 0; f < n_leaves; f++)
+                AssertTest (colouring.colour_of_face (f) == f);
+            AssertTest (colouring.colour_of_face (n_leaves) == n_leaves);
+            AssertTest (colouring.colour_of_face (n_leaves + 1) == 0);
+        }
+    }
+
+    {
+        // Tasks submitted to a pool return their results through futures
+        Parallel::ThreadPool           pool (3);
+        std::vector<std::future<int> > results;
+        for (int i = 0; i < 10; i++)
+            results.push_back (pool.submit ([i] { return i * i; }));
+        for (int i = 0; i < 10; i++) AssertTest (results[i].get () == i * i);
+    }
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,189 @@
+#include <FVMCode/field_reader.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/output.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <filesystem>
+#include <stdexcept>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+// Returns whether reading the volScalarField in contents throws
+bool field_throws (const std::string                &contents,
+                   const unsigned int                n_cells,
+                   const std::vector<BoundaryPatch> &patches)
+{
+    Eigen::VectorXd    field;
+    BoundaryConditions boundary_conditions;
+    try
+    {
+        Input::read_scalar_field (contents, "T", n_cells, patches, field,
+                                  boundary_conditions);
+    }
+    catch (std::runtime_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+int field_reader_01 (int, char **)
+{
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (mesh, "mesh_1d/points", "mesh_1d/faces",
+                                   "mesh_1d/owner", "mesh_1d/neighbour",
+                                   "mesh_1d/boundary");
+    const unsigned int               n_cells = mesh.n_cells ();
+    const std::vector<BoundaryPatch> patches = mesh.get_patches ();
+
+    BoundaryConditions boundary_conditions;
+    boundary_conditions.emplace_back (patches[0],
+                                      BoundaryFieldEntry ("fixedValue", 1.5));
+    boundary_conditions.emplace_back (
+        patches[1], BoundaryFieldEntry ("zeroGradient", 0));
+    boundary_conditions.emplace_back (patches[2],
+                                      BoundaryFieldEntry ("empty", 0));
+    // Values that are written exactly with the default precision
+    Eigen::VectorXd field (n_cells);
+    for (unsigned int c = 0; c < n_cells; c++) field (c) = 0.25 * c - 1;
+    std::vector<unsigned int> permutation (n_cells);
+    for (unsigned int c = 0; c < n_cells; c++)
+        permutation[c] = (7 * c) % n_cells;
+
+    // Outputter writes to the working directory
+    const std::filesystem::path working_directory
+        = std::filesystem::current_path ();
+    std::filesystem::remove_all ("field_reader_01");
+    std::filesystem::create_directory ("field_reader_01");
+    std::filesystem::current_path ("field_reader_01");
+    AssertTest (!Input::find_latest_time (".", "T"));
+    for (const auto &[index, time] :
+         { std::make_pair (1u, 0.1), std::make_pair (12u, 1.2),
+           std::make_pair (7u, 0.7) })
+    {
+        Outputter outputter (index, time, 0.1, 0.1);
+        outputter.write_time ();
+        outputter.write_scalar_field (field, "T", boundary_conditions);
+        outputter.write_scalar_field (field, "T_renumbered",
+                                      boundary_conditions, permutation);
+    }
+    std::filesystem::create_directory ("2.5");
+    std::filesystem::create_directory ("constant");
+    std::filesystem::current_path (working_directory);
+
+    {
+        // The latest time with the field, not the empty 2.5 directory
+        const std::optional<Input::TimeDirectory> latest
+            = Input::find_latest_time ("field_reader_01", "T");
+        AssertTest (latest);
+        AssertTest (latest->time == 1.2);
+        AssertTest (latest->index == 12);
+        AssertTest (std::filesystem::path (latest->path).filename ()
+                    == "1.20");
+        AssertTest (!Input::find_latest_time ("field_reader_01", "U"));
+
+        for (const std::string name : { "T", "T_renumbered" })
+        {
+            Eigen::VectorXd    read_field;
+            BoundaryConditions read_conditions;
+            Input::read_scalar_field (
+                latest->path + "/" + name, n_cells, patches, read_field,
+                read_conditions,
+                name == "T" ? std::vector<unsigned int> () : permutation);
+            AssertTest (read_field == field);
+            AssertTest (read_conditions.size () == patches.size ());
+            for (unsigned int p = 0; p < patches.size (); p++)
+            {
+                AssertTest (read_conditions[p].first.name == patches[p].name);
+                AssertTest (read_conditions[p].second.type
+                            == boundary_conditions[p].second.type);
+                AssertTest (read_conditions[p].second.value
+                            == boundary_conditions[p].second.value);
+            }
+        }
+    }
+    std::cout << "Tested reading written fields" << std::endl;
+
+    {
+        // Other ways of writing fields, in the order of patches of the
+        // boundary dictionary not mattering
+        const std::string boundary_field
+            = "boundaryField\n{\n"
+              "    sides { type empty; }\n"
+              "    outlet\n    {\n        type zeroGradient;\n"
+              "        value nonuniform List<scalar> 1(3.5);\n    }\n"
+              "    inlet { type fixedValue; value uniform 2; }\n"
+              "}\n";
+        const std::string header
+            = "FoamFile\n{\n    format ascii;\n    class volScalarField;\n"
+              "    object T;\n}\n";
+        Eigen::VectorXd    read_field;
+        BoundaryConditions read_conditions;
+
+        Input::read_scalar_field (
+            header + "dimensions [0 0 0 1 0 0 0];\ninternalField uniform 4;\n"
+                + boundary_field,
+            "T", n_cells, patches, read_field, read_conditions);
+        AssertTest (read_field == Eigen::VectorXd::Constant (n_cells, 4));
+        AssertTest (read_conditions[0].second.type == "fixedValue");
+        AssertTest (read_conditions[0].second.value == 2);
+        AssertTest (read_conditions[1].second.type == "zeroGradient");
+        AssertTest (read_conditions[2].second.type == "empty");
+
+        Input::read_scalar_field (
+            header + "internalField nonuniform List<scalar> "
+                + std::to_string (n_cells) + "{-1.5};\n" + boundary_field,
+            "T", n_cells, patches, read_field, read_conditions);
+        AssertTest (read_field == Eigen::VectorXd::Constant (n_cells, -1.5));
+
+        std::string binary
+            = "FoamFile\n{\n    format binary;\n"
+              "    arch \"LSB;label=32;scalar=64\";\n"
+              "    class volScalarField;\n}\n"
+              "internalField nonuniform List<scalar> "
+              + std::to_string (n_cells) + "\n(";
+        binary.append (reinterpret_cast<const char *> (field.data ()),
+                       n_cells * sizeof (double));
+        // Lists in the boundary field would be binary too
+        binary += ");\nboundaryField\n{\n"
+                  "    inlet { type fixedValue; value uniform 2; }\n"
+                  "    outlet { type zeroGradient; }\n"
+                  "    sides { type empty; }\n}\n";
+        Input::read_scalar_field (binary, "T", n_cells, patches, read_field,
+                                  read_conditions);
+        AssertTest (read_field == field);
+
+        // Errors
+        AssertTest (field_throws (header + "internalField uniform 4;\n",
+                                  n_cells, patches));
+        AssertTest (
+            field_throws (header + "internalField nonuniform List<scalar> "
+                              + "2(1 2);\n" + boundary_field,
+                          n_cells, patches));
+        AssertTest (field_throws (
+            "FoamFile { class volVectorField; }\ninternalField uniform 4;\n"
+                + boundary_field,
+            n_cells, patches));
+        AssertTest (field_throws (
+            header
+                + "internalField uniform 4;\nboundaryField\n{\n"
+                  "    inlet { type fixedValue; value uniform 2; }\n"
+                  "    outlet { type zeroGradient; }\n}\n",
+            n_cells, patches));
+        std::vector<BoundaryPatch> two_faced_patches;
+        two_faced_patches.push_back (BoundaryPatch ("inlet", wall, 2, 19));
+        AssertTest (field_throws (
+            header
+                + "internalField uniform 4;\nboundaryField\n{\n"
+                  "    inlet\n    {\n        type fixedValue;\n"
+                  "        value nonuniform List<scalar> 2(1 2);\n    }\n}\n",
+            n_cells, two_faced_patches));
+    }
+    std::cout << "Tested field formats" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/foam_tokenizer.h>
+#include <FVMCode/mapped_file.h>
+#include <FVMCode/polymesh_reader.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <stdexcept>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+// Checks that two meshes read from the same files are identical
+void check_same_mesh (UnstructuredMesh &a, UnstructuredMesh &b)
+{
+    AssertTest (a.n_points () == b.n_points ());
+    AssertTest (a.n_faces () == b.n_faces ());
+    AssertTest (a.n_cells () == b.n_cells ());
+    AssertTest (a.n_boundary_patches () == b.n_boundary_patches ());
+
+    for (unsigned int p = 0; p < a.n_points (); p++)
+        AssertTest (a.get_point (p)->distance (*b.get_point (p)) == 0.);
+
+    for (unsigned int f = 0; f < a.n_faces (); f++)
+    {
+        const auto &face_a = a.get_face (f);
+        const auto &face_b = b.get_face (f);
+        AssertTest (face_a->n_vertices () == face_b->n_vertices ());
+        for (unsigned int v = 0; v < face_a->n_vertices (); v++)
+            AssertTest (face_a->vertices ()[v] - a.get_point (0)
+                        == face_b->vertices ()[v] - b.get_point (0));
+        AssertTest (face_a->neighbour_indices ()
+                    == face_b->neighbour_indices ());
+        AssertTest (face_a->area_vector ().distance (face_b->area_vector ())
+                    == 0.);
+        AssertTest (face_a->center ().distance (face_b->center ()) == 0.);
+        AssertTest (face_a->delta () == face_b->delta ());
+        AssertTest (face_a->interpolation_factor ()
+                    == face_b->interpolation_factor ());
+    }
+
+    for (unsigned int c = 0; c < a.n_cells (); c++)
+    {
+        const auto &cell_a = a.get_cell (c);
+        const auto &cell_b = b.get_cell (c);
+        AssertTest (cell_a->faces ().size () == cell_b->faces ().size ());
+        for (unsigned int f = 0; f < cell_a->faces ().size (); f++)
+            AssertTest (cell_a->faces ()[f] - a.get_face (0)
+                        == cell_b->faces ()[f] - b.get_face (0));
+        AssertTest (cell_a->volume () == cell_b->volume ());
+        AssertTest (cell_a->center ().distance (cell_b->center ()) == 0.);
+    }
+
+    for (unsigned int p = 0; p < a.n_boundary_patches (); p++)
+    {
+        const BoundaryPatch &patch_a = a.get_patches ()[p];
+        const BoundaryPatch &patch_b = b.get_patches ()[p];
+        AssertTest (patch_a.name == patch_b.name);
+        AssertTest (patch_a.type == patch_b.type);
+        AssertTest (patch_a.n_faces == patch_b.n_faces);
+        AssertTest (patch_a.start_face == patch_b.start_face);
+    }
+}
+
+void check_backends (const std::string &directory)
+{
+    ParserOptions stream_options;
+    stream_options.backend = ParserOptions::Backend::stream;
+    ParserOptions mapped_options;
+    mapped_options.backend = ParserOptions::Backend::memory_mapped;
+
+    UnstructuredMesh stream_mesh, mapped_mesh;
+    UnstructuredMeshParser stream_parser (
+        stream_mesh, directory + "/points", directory + "/faces",
+        directory + "/owner", directory + "/neighbour",
+        directory + "/boundary", stream_options);
+    UnstructuredMeshParser mapped_parser (
+        mapped_mesh, directory + "/points", directory + "/faces",
+        directory + "/owner", directory + "/neighbour",
+        directory + "/boundary", mapped_options);
+    check_same_mesh (stream_mesh, mapped_mesh);
+
+    for (const unsigned int n_threads : { 1, 2, 5 })
+    {
+        ParserOptions concurrent_options;
+        concurrent_options.concurrent = true;
+        concurrent_options.n_threads  = n_threads;
+        UnstructuredMesh       concurrent_mesh;
+        UnstructuredMeshParser concurrent_parser (
+            concurrent_mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary", concurrent_options);
+        check_same_mesh (stream_mesh, concurrent_mesh);
+    }
+
+    ParserOptions chunked_options;
+    chunked_options.chunked    = true;
+    chunked_options.concurrent = true;
+    chunked_options.n_threads  = 3;
+    UnstructuredMesh       chunked_mesh;
+    UnstructuredMeshParser chunked_parser (
+        chunked_mesh, directory + "/points", directory + "/faces",
+        directory + "/owner", directory + "/neighbour",
+        directory + "/boundary", chunked_options);
+    check_same_mesh (stream_mesh, chunked_mesh);
+}
+
+// Reads the files of directory in chunks of at least one byte, so that the
+// small test meshes are actually split, and compares with serial reading
+void check_chunked (const std::string &directory)
+{
+    Input::PolyMeshData serial;
+    const std::string   points_file = directory + "/points";
+    const std::string   faces_file  = directory + "/faces";
+    const std::string   owner_file  = directory + "/owner";
+    Input::read_points (Input::MappedFile (points_file).view (), points_file,
+                        serial.points);
+    Input::read_faces (Input::MappedFile (faces_file).view (), faces_file,
+                       serial.face_offsets, serial.face_vertices);
+    Input::read_labels (Input::MappedFile (owner_file).view (), owner_file,
+                        serial.owner);
+
+    for (const unsigned int n_threads : { 2, 3, 7 })
+    {
+        Parallel::ThreadPool pool (n_threads);
+        Input::PolyMeshData  chunked;
+        Input::read_points (Input::MappedFile (points_file).view (),
+                            points_file, chunked.points, pool, 1);
+        Input::read_faces (Input::MappedFile (faces_file).view (), faces_file,
+                           chunked.face_offsets, chunked.face_vertices, pool,
+                           1);
+        Input::read_labels (Input::MappedFile (owner_file).view (), owner_file,
+                            chunked.owner, pool, 1);
+
+        AssertTest (chunked.points.size () == serial.points.size ());
+        for (unsigned int p = 0; p < serial.points.size (); p++)
+            AssertTest (chunked.points[p].distance (serial.points[p]) == 0.);
+        AssertTest (chunked.face_offsets == serial.face_offsets);
+        AssertTest (chunked.face_vertices == serial.face_vertices);
+        AssertTest (chunked.owner == serial.owner);
+    }
+}
+
+bool throws (const std::string &input)
+{
+    try
+    {
+        Input::FoamTokenizer tokens (input, "input");
+        tokens.skip_foam_header ();
+        while (!tokens.at_end ()) tokens.read_unsigned ();
+    }
+    catch (std::runtime_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+int file_parser_01 (int, char **)
+{
+    // The memory mapped backend reads the same mesh as the stream backend
+    check_backends ("mesh_1d");
+    check_backends ("unstructured_mesh_04");
+    std::cout << "Tested backends" << std::endl;
+
+    check_chunked ("mesh_1d");
+    check_chunked ("unstructured_mesh_04");
+    {
+        // A chunk that cannot be read makes the whole file be read serially,
+        // which reports the error
+        Parallel::ThreadPool      pool (2);
+        std::vector<unsigned int> labels;
+        Input::read_labels ("3\n(\n1\n2\n3\n)\n", "input", labels, pool, 1);
+        AssertTest ((labels == std::vector<unsigned int> { 1, 2, 3 }));
+        bool caught = false;
+        try
+        {
+            Input::read_labels ("3\n(\n1\nx\n3\n)\n", "input", labels, pool,
+                                1);
+        }
+        catch (std::runtime_error &)
+        {
+            caught = true;
+        }
+        AssertTest (caught);
+    }
+    std::cout << "Tested chunked reading" << std::endl;
+
+    {
+        // Comments, strings and numbers
+        const std::string input
+            = "/* banner\n * with / and * */\n"
+              "FoamFile\n{\n    location \"constant/polyMesh\";\n"
+              "    arch \"LSB;label=32;scalar=64\"; // } not a brace\n}\n"
+              "// a comment\n3 /* inline */ (1e-05 -2.5 7) word;\n"
+              "key 1(wall) \"quoted;\"; next";
+        Input::FoamTokenizer tokens (input, "input");
+        tokens.skip_foam_header ();
+        AssertTest (tokens.read_unsigned () == 3);
+        AssertTest (tokens.peek () == '(');
+        tokens.expect ('(');
+        AssertTest (tokens.read_double () == 1e-05);
+        AssertTest (tokens.read_double () == -2.5);
+        AssertTest (tokens.read_double () == 7.);
+        tokens.expect (')');
+        AssertTest (tokens.read_word () == "word");
+        tokens.expect (';');
+        AssertTest (tokens.read_word () == "key");
+        tokens.skip_entry ();
+        AssertTest (tokens.read_word () == "next");
+        AssertTest (tokens.at_end ());
+        AssertTest (tokens.peek () == '\0');
+    }
+
+    {
+        // A file without a header is read from the start
+        Input::FoamTokenizer tokens ("12 13", "input");
+        tokens.skip_foam_header ();
+        AssertTest (tokens.read_unsigned () == 12);
+        AssertTest (tokens.read_unsigned () == 13);
+        AssertTest (tokens.at_end ());
+    }
+
+    // Malformed input throws rather than reading past the buffer
+    AssertTest (!throws ("1 2 3"));
+    AssertTest (throws ("FoamFile { version 2.0;"));
+    AssertTest (throws ("1 /* unfinished"));
+    AssertTest (throws ("1 / 2"));
+    AssertTest (throws ("1 x"));
+    AssertTest (throws ("-1"));
+    std::cout << "Tested tokenizer" << std::endl;
+
+    {
+        // Errors on a reading thread reach the caller
+        ParserOptions options;
+        options.concurrent = true;
+        bool caught        = false;
+        try
+        {
+            UnstructuredMesh       mesh;
+            UnstructuredMeshParser parser (
+                mesh, "mesh_1d/points", "mesh_1d/faces", "mesh_1d/owner",
+                "mesh_1d/does_not_exist", "mesh_1d/boundary", options);
+        }
+        catch (std::runtime_error &)
+        {
+            caught = true;
+        }
+        AssertTest (caught);
+    }
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,233 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/foam_tokenizer.h>
+#include <FVMCode/mapped_file.h>
+#include <FVMCode/polymesh_reader.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+// Writes binary polyMesh files in the layout of OpenFOAM's foamFormatConvert
+
+void write_header (std::ofstream &out, const std::string &format,
+                   const std::string &class_name, const std::string &object,
+                   const unsigned int label_bits)
+{
+    out << "FoamFile\n{\n    version     2.0;\n    format      " << format
+        << ";\n    arch        \"LSB;label=" << label_bits
+        << ";scalar=64\";\n    class       " << class_name
+        << ";\n    location    \"constant/polyMesh\";\n    object      "
+        << object << ";\n}\n\n";
+}
+
+void write_labels (std::ofstream &out, const std::vector<unsigned int> &labels,
+                   const bool binary, const unsigned int label_bits)
+{
+    out << labels.size () << "\n(";
+    for (const unsigned int label : labels)
+    {
+        if (!binary)
+            out << label << "\n";
+        else if (label_bits == 32)
+        {
+            const std::int32_t value = label;
+            out.write (reinterpret_cast<const char *> (&value), sizeof value);
+        }
+        else
+        {
+            const std::int64_t value = label;
+            out.write (reinterpret_cast<const char *> (&value), sizeof value);
+        }
+    }
+    out << ")\n";
+}
+
+void write_mesh (const Input::PolyMeshData &data, const std::string &directory,
+                 const std::string &boundary_file, const bool binary,
+                 const unsigned int label_bits)
+{
+    std::filesystem::create_directories (directory);
+    const std::string format = binary ? "binary" : "ascii";
+
+    std::ofstream points (directory + "/points", std::ios::binary);
+    write_header (points, format, "vectorField", "points", label_bits);
+    points << data.points.size () << "\n(" << std::setprecision (17);
+    for (const Point<3> &point : data.points)
+        for (unsigned int d = 0; d < 3; d++)
+        {
+            const double coordinate = point (d);
+            if (binary)
+                points.write (reinterpret_cast<const char *> (&coordinate),
+                              sizeof coordinate);
+            else
+                points << (d == 0 ? "(" : " ") << coordinate
+                       << (d == 2 ? ")\n" : "");
+        }
+    points << ")\n";
+
+    std::ofstream faces (directory + "/faces", std::ios::binary);
+    write_header (faces, format, "faceCompactList", "faces", label_bits);
+    write_labels (faces, data.face_offsets, binary, label_bits);
+    faces << "\n\n";
+    write_labels (faces, data.face_vertices, binary, label_bits);
+
+    std::ofstream owner (directory + "/owner", std::ios::binary);
+    write_header (owner, format, "labelList", "owner", label_bits);
+    write_labels (owner, data.owner, binary, label_bits);
+
+    std::ofstream neighbour (directory + "/neighbour", std::ios::binary);
+    write_header (neighbour, format, "labelList", "neighbour", label_bits);
+    write_labels (neighbour, data.neighbour, binary, label_bits);
+
+    std::filesystem::copy_file (
+        boundary_file, directory + "/boundary",
+        std::filesystem::copy_options::overwrite_existing);
+}
+
+Input::PolyMeshData read_data (const std::string &directory)
+{
+    Input::PolyMeshData data;
+    const std::string   points    = directory + "/points";
+    const std::string   faces     = directory + "/faces";
+    const std::string   owner     = directory + "/owner";
+    const std::string   neighbour = directory + "/neighbour";
+    Input::read_points (Input::MappedFile (points).view (), points,
+                        data.points);
+    Input::read_faces (Input::MappedFile (faces).view (), faces,
+                       data.face_offsets, data.face_vertices);
+    Input::read_labels (Input::MappedFile (owner).view (), owner, data.owner);
+    Input::read_labels (Input::MappedFile (neighbour).view (), neighbour,
+                        data.neighbour);
+    return data;
+}
+
+void check_same_data (const Input::PolyMeshData &a,
+                      const Input::PolyMeshData &b)
+{
+    AssertTest (a.points.size () == b.points.size ());
+    for (unsigned int p = 0; p < a.points.size (); p++)
+        AssertTest (a.points[p].distance (b.points[p]) == 0.);
+    AssertTest (a.face_offsets == b.face_offsets);
+    AssertTest (a.face_vertices == b.face_vertices);
+    AssertTest (a.owner == b.owner);
+    AssertTest (a.neighbour == b.neighbour);
+}
+
+void check_converted (const std::string &directory)
+{
+    const Input::PolyMeshData ascii = read_data (directory);
+
+    UnstructuredMesh       ascii_mesh;
+    UnstructuredMeshParser ascii_parser (
+        ascii_mesh, directory + "/points", directory + "/faces",
+        directory + "/owner", directory + "/neighbour",
+        directory + "/boundary");
+
+    for (const bool binary : { false, true })
+        for (const unsigned int label_bits : { 32, 64 })
+        {
+            const std::string converted
+                = "file_parser_02/" + directory + (binary ? "/binary" : "/ascii")
+                  + std::to_string (label_bits);
+            write_mesh (ascii, converted, directory + "/boundary", binary,
+                        label_bits);
+            check_same_data (ascii, read_data (converted));
+
+            UnstructuredMesh       mesh;
+            UnstructuredMeshParser parser (
+                mesh, converted + "/points", converted + "/faces",
+                converted + "/owner", converted + "/neighbour",
+                converted + "/boundary");
+            AssertTest (mesh.n_cells () == ascii_mesh.n_cells ());
+            AssertTest (mesh.n_faces () == ascii_mesh.n_faces ());
+            for (unsigned int c = 0; c < mesh.n_cells (); c++)
+                AssertTest (mesh.get_cell (c)->volume ()
+                            == ascii_mesh.get_cell (c)->volume ());
+        }
+}
+
+bool header_throws (const std::string &input)
+{
+    try
+    {
+        Input::FoamTokenizer tokens (input, "input");
+        tokens.read_foam_header ();
+    }
+    catch (std::runtime_error &)
+    {
+        return true;
+    }
+    return false;
+}
+
+int file_parser_02 (int, char **)
+{
+    check_converted ("mesh_1d");
+    check_converted ("unstructured_mesh_04");
+    std::cout << "Tested binary and compact meshes" << std::endl;
+
+    {
+        Input::FoamTokenizer tokens (
+            "FoamFile { version 2.0; format binary; class faceCompactList;\n"
+            "arch \"LSB;label=64;scalar=64\"; note \"a {note}\";\n"
+            "sub { a 1; } }\n1",
+            "input");
+        const Input::FoamHeader header = tokens.read_foam_header ();
+        AssertTest (header.present);
+        AssertTest (header.binary);
+        AssertTest (header.class_name == "faceCompactList");
+        AssertTest (header.label_bits == 64);
+        AssertTest (header.scalar_bits == 64);
+        AssertTest (tokens.read_unsigned () == 1);
+    }
+    {
+        Input::FoamTokenizer    tokens ("1", "input");
+        const Input::FoamHeader header = tokens.read_foam_header ();
+        AssertTest (!header.present);
+        AssertTest (!header.binary);
+        AssertTest (header.label_bits == 32);
+    }
+    AssertTest (!header_throws ("FoamFile { arch \"LSB;label=32\"; }"));
+    AssertTest (header_throws ("FoamFile { arch \"MSB;label=32\"; }"));
+    AssertTest (header_throws ("FoamFile { arch \"LSB;label=16\"; }"));
+    AssertTest (header_throws ("FoamFile { arch \"LSB;scalar=32\"; }"));
+    AssertTest (header_throws ("FoamFile { format text; }"));
+    std::cout << "Tested headers" << std::endl;
+
+    for (const unsigned int label_bits : { 32, 64 })
+    {
+        // Negative 32 bit binary labels are rejected rather than wrapped
+        // around, and 64 bit labels beyond the range of 32 bit ones
+        const std::string file = "file_parser_02/negative_labels";
+        {
+            std::ofstream out (file, std::ios::binary);
+            write_header (out, "binary", "labelList", "owner", label_bits);
+            write_labels (out, { 0, static_cast<unsigned int> (-1) }, true,
+                          label_bits);
+        }
+        bool caught = false;
+        try
+        {
+            std::vector<unsigned int> labels;
+            Input::read_labels (Input::MappedFile (file).view (), file,
+                                labels);
+        }
+        catch (std::runtime_error &)
+        {
+            caught = true;
+        }
+        AssertTest (caught);
+    }
+    std::cout << "Tested negative labels" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
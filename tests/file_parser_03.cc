@@ -0,0 +1,142 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/input_file.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <zlib.h>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+std::string read_file (const std::string &filename)
+{
+    std::ifstream     in (filename, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf ();
+    return contents.str ();
+}
+
+// Compresses contents into a gzip file, split into n_members concatenated
+// gzip members
+void write_gzip (const std::string &filename, const std::string &contents,
+                 const unsigned int n_members = 1)
+{
+    std::filesystem::remove (filename);
+    for (unsigned int m = 0; m < n_members; m++)
+    {
+        const std::size_t begin = m * contents.size () / n_members;
+        const std::size_t end   = (m + 1) * contents.size () / n_members;
+        gzFile            out   = gzopen (filename.c_str (), "ab");
+        gzwrite (out, contents.data () + begin, end - begin);
+        gzclose (out);
+    }
+}
+
+int file_parser_03 (int, char **)
+{
+    // mesh_1d with all files except boundary compressed
+    const std::string directory = "file_parser_03/mesh_1d";
+    std::filesystem::create_directories (directory);
+    for (const std::string file : { "points", "faces", "owner", "neighbour" })
+    {
+        std::filesystem::remove (directory + "/" + file);
+        write_gzip (directory + "/" + file + ".gz",
+                    read_file ("mesh_1d/" + file), file == "faces" ? 3 : 1);
+    }
+    std::filesystem::copy_file (
+        "mesh_1d/boundary", directory + "/boundary",
+        std::filesystem::copy_options::overwrite_existing);
+
+    UnstructuredMesh       plain_mesh;
+    UnstructuredMeshParser plain_parser (
+        plain_mesh, "mesh_1d/points", "mesh_1d/faces", "mesh_1d/owner",
+        "mesh_1d/neighbour", "mesh_1d/boundary");
+
+    for (const bool concurrent : { false, true })
+    {
+        ParserOptions options;
+        options.concurrent = concurrent;
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary", options);
+        AssertTest (mesh.n_points () == plain_mesh.n_points ());
+        AssertTest (mesh.n_faces () == plain_mesh.n_faces ());
+        AssertTest (mesh.n_cells () == plain_mesh.n_cells ());
+        for (unsigned int f = 0; f < mesh.n_faces (); f++)
+            AssertTest (mesh.get_face (f)->neighbour_indices ()
+                        == plain_mesh.get_face (f)->neighbour_indices ());
+        for (unsigned int c = 0; c < mesh.n_cells (); c++)
+            AssertTest (mesh.get_cell (c)->volume ()
+                        == plain_mesh.get_cell (c)->volume ());
+    }
+    std::cout << "Tested compressed mesh" << std::endl;
+
+    {
+        // Plain files take precedence over compressed ones
+        write_gzip (directory + "/boundary.gz", "not a boundary file");
+        const Input::InputFile boundary (directory + "/boundary");
+        AssertTest (!boundary.compressed ());
+        AssertTest (boundary.view () == read_file ("mesh_1d/boundary"));
+
+        const Input::InputFile faces (directory + "/faces", false);
+        AssertTest (faces.compressed ());
+        AssertTest (faces.path () == directory + "/faces.gz");
+        AssertTest (faces.view () == read_file ("mesh_1d/faces"));
+    }
+
+    {
+        // Damaged data throws, also when decompressed in the background
+        const std::string compressed = read_file (directory + "/points.gz");
+        bool              caught     = false;
+        try
+        {
+            Input::gunzip (compressed.substr (0, compressed.size () / 2),
+                           "points");
+        }
+        catch (std::runtime_error &)
+        {
+            caught = true;
+        }
+        AssertTest (caught);
+
+        std::string corrupt = compressed;
+        for (std::size_t i = 20; i < corrupt.size () - 8; i++) corrupt[i] = 0;
+        {
+            std::ofstream out (directory + "/corrupt.gz", std::ios::binary);
+            out << corrupt;
+        }
+        caught = false;
+        try
+        {
+            const Input::InputFile file (directory + "/corrupt");
+            file.view ();
+        }
+        catch (std::runtime_error &)
+        {
+            caught = true;
+        }
+        AssertTest (caught);
+
+        caught = false;
+        try
+        {
+            const Input::InputFile file (directory + "/does_not_exist");
+        }
+        catch (std::runtime_error &)
+        {
+            caught = true;
+        }
+        AssertTest (caught);
+    }
+    std::cout << "Tested errors" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
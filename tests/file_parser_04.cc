@@ -0,0 +1,179 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/polymesh_reader.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+namespace
+{
+// The number of calls of the global operator new by threads that have set
+// counting_allocations. Other tests in the driver, and other threads of this
+// one, are not counted.
+std::atomic<unsigned long> n_allocations { 0 };
+thread_local bool          counting_allocations = false;
+
+// Counts the allocations of the calling thread while it exists
+class AllocationCounter
+{
+  public:
+    AllocationCounter ()
+        : start (n_allocations)
+    {
+        counting_allocations = true;
+    }
+
+    ~AllocationCounter () { counting_allocations = false; }
+
+    unsigned long count () const { return n_allocations - start; }
+
+  private:
+    const unsigned long start;
+};
+
+// Owner and neighbour lists of a row of n_cells cells
+void row_of_cells (const unsigned int         n_cells,
+                   std::vector<unsigned int> &owner,
+                   std::vector<unsigned int> &neighbour)
+{
+    owner.clear ();
+    neighbour.clear ();
+    for (unsigned int c = 0; c + 1 < n_cells; c++)
+    {
+        owner.push_back (c);
+        neighbour.push_back (c + 1);
+    }
+    // The two boundary faces
+    owner.push_back (0);
+    owner.push_back (n_cells - 1);
+}
+} // namespace
+
+// Replaced for the whole test driver, not only this test, but it only
+// counts while an AllocationCounter exists on the calling thread
+void *operator new (std::size_t size)
+{
+    if (counting_allocations)
+        n_allocations++;
+    if (void *pointer = std::malloc (size ? size : 1))
+        return pointer;
+    throw std::bad_alloc ();
+}
+
+void operator delete (void *pointer) noexcept
+{
+    std::free (pointer);
+}
+
+void operator delete (void *pointer, std::size_t) noexcept
+{
+    std::free (pointer);
+}
+
+int file_parser_04 (int, char **)
+{
+    {
+        const std::vector<unsigned int> owner     = { 0, 0, 1, 2 };
+        const std::vector<unsigned int> neighbour = { 1, 2 };
+        std::vector<unsigned int>       cell_offsets, cell_faces;
+        Input::build_cell_faces (owner, neighbour, cell_offsets, cell_faces);
+        AssertTest (cell_offsets
+                    == std::vector<unsigned int> ({ 0, 2, 4, 6 }));
+        AssertTest (cell_faces
+                    == std::vector<unsigned int> ({ 0, 1, 2, 0, 3, 1 }));
+
+        // A label that cannot be a cell throws instead of overflowing
+        for (const unsigned int label : { 6u, 0xFFFFFFFEu, 0xFFFFFFFFu })
+        {
+            const std::vector<unsigned int> bad_owner = { 0, label, 1, 2 };
+            bool                            caught    = false;
+            try
+            {
+                Input::build_cell_faces (bad_owner, neighbour, cell_offsets,
+                                         cell_faces);
+            }
+            catch (std::runtime_error &)
+            {
+                caught = true;
+            }
+            AssertTest (caught);
+        }
+    }
+
+    {
+        // The number of allocations does not depend on the size of the mesh
+        std::vector<unsigned int> owner, neighbour;
+        for (const unsigned int n_cells : { 10, 100000 })
+        {
+            row_of_cells (n_cells, owner, neighbour);
+            std::vector<unsigned int> cell_offsets, cell_faces;
+            {
+                const AllocationCounter allocations;
+                Input::build_cell_faces (owner, neighbour, cell_offsets,
+                                         cell_faces);
+                AssertTest (allocations.count () == 2);
+            }
+            AssertTest (cell_offsets.size () == n_cells + 1);
+            AssertTest (cell_faces.size () == 2 * n_cells);
+            for (unsigned int c = 0; c < n_cells; c++)
+                AssertTest (cell_offsets[c + 1] - cell_offsets[c] == 2);
+
+            // None if the outputs are large enough already
+            const AllocationCounter allocations;
+            Input::build_cell_faces (owner, neighbour, cell_offsets,
+                                     cell_faces);
+            AssertTest (allocations.count () == 0);
+        }
+    }
+    std::cout << "Tested counting sort" << std::endl;
+
+    for (const auto backend : { ParserOptions::Backend::stream,
+                                ParserOptions::Backend::memory_mapped })
+    {
+        ParserOptions options;
+        options.backend = backend;
+        UnstructuredMesh mesh;
+        {
+            // Only those of this thread, not of the reading threads
+            const AllocationCounter allocations;
+            UnstructuredMeshParser  parser (
+                mesh, "mesh_1d/points", "mesh_1d/faces", "mesh_1d/owner",
+                "mesh_1d/neighbour", "mesh_1d/boundary", options);
+            std::cout << "Allocations per face while reading mesh_1d: "
+                      << double (allocations.count ()) / mesh.n_faces ()
+                      << std::endl;
+        }
+
+        // Each cell has the faces it owns, then the faces it neighbours
+        for (unsigned int c = 0; c < mesh.n_cells (); c++)
+        {
+            std::vector<unsigned int> owned, neighboured;
+            for (unsigned int f = 0; f < mesh.n_faces (); f++)
+            {
+                const auto &neighbours
+                    = mesh.get_face (f)->neighbour_indices ();
+                if (neighbours[0] == c)
+                    owned.push_back (f);
+                else if (neighbours.size () == 2 && neighbours[1] == c)
+                    neighboured.push_back (f);
+            }
+            owned.insert (owned.end (), neighboured.begin (),
+                          neighboured.end ());
+            const auto &faces = mesh.get_cell (c)->faces ();
+            AssertTest (faces.size () == owned.size ());
+            for (unsigned int f = 0; f < faces.size (); f++)
+                AssertTest (faces[f] - mesh.get_face (0) == owned[f]);
+        }
+    }
+    std::cout << "Tested cell construction" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
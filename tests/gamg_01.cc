@@ -0,0 +1,206 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/operators.h>
+#include <FVMCode/solvers/gamg.h>
+#include <FVMCode/solvers/solver_cg.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <Eigen/Dense>
+#include <Eigen/SparseLU>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+namespace
+{
+Eigen::MatrixXd dense (const SparseMatrix &matrix)
+{
+    Eigen::SparseMatrix<double> eigen_matrix;
+    matrix.copy_to (eigen_matrix);
+    return Eigen::MatrixXd (eigen_matrix);
+}
+
+VectorXd solve (const SparseMatrix &matrix, const VectorXd &rhs)
+{
+    Eigen::SparseMatrix<double> eigen_matrix;
+    matrix.copy_to (eigen_matrix);
+    Eigen::SparseLU<Eigen::SparseMatrix<double> > solver (eigen_matrix);
+    return solver.solve (rhs);
+}
+
+double relative_error (const VectorXd &a, const VectorXd &b)
+{
+    return (a - b).lpNorm<Eigen::Infinity> () / b.lpNorm<Eigen::Infinity> ();
+}
+
+// A timestep of the heat equation
+void assemble (SparseMatrix &matrix, VectorXd &rhs, UnstructuredMesh &mesh,
+               const double dt)
+{
+    BoundaryConditions bcs;
+    for (const BoundaryPatch &patch : mesh.get_patches ())
+        bcs.emplace_back (
+            patch, BoundaryFieldEntry (patch.type == empty ? "empty"
+                                                           : "fixedValue",
+                                       patch.name == "inlet" ? 1. : 0.));
+    matrix.set_zero ();
+    rhs.setZero (mesh.n_cells ());
+    Operators::ddt (matrix, rhs, mesh,
+                    VectorXd::LinSpaced (mesh.n_cells (), 0., 1.), dt);
+    Operators::laplacian (matrix, rhs, mesh, bcs, 0.01);
+}
+
+// Solves the heat equation on @p mesh with a hierarchy built with
+// @p options, and checks the hierarchy
+void check_hierarchy (UnstructuredMesh &mesh, const GAMGOptions &options)
+{
+    const unsigned int    n_cells = mesh.n_cells ();
+    const SparsityPattern sp (mesh);
+    SparseMatrix          matrix (sp);
+    VectorXd              rhs;
+    assemble (matrix, rhs, mesh, 0.05);
+    GAMG gamg (matrix, options);
+
+    // Each coarse cell holds some cells of the level above, and the matrix
+    // of each level is the Galerkin product P^T A P
+    AssertTest (gamg.n_cells (0) == n_cells);
+    AssertTest (gamg.n_cells (gamg.n_levels () - 1)
+                    <= options.max_coarsest_cells
+                || gamg.n_levels () == options.max_levels);
+    AssertTest ((gamg.n_levels () == 1)
+                == (n_cells <= options.max_coarsest_cells
+                    || options.max_levels == 1));
+    for (unsigned int level = 0; level + 1 < gamg.n_levels (); level++)
+    {
+        const std::vector<unsigned int> &coarse_cells
+            = gamg.coarse_cells (level);
+        Eigen::MatrixXd prolongation = Eigen::MatrixXd::Zero (
+            gamg.n_cells (level), gamg.n_cells (level + 1));
+        for (unsigned int i = 0; i < coarse_cells.size (); i++)
+            prolongation (i, coarse_cells[i]) = 1.;
+        AssertTest (prolongation.colwise ().sum ().minCoeff () >= 1.);
+        const Eigen::MatrixXd galerkin = prolongation.transpose ()
+                                         * dense (gamg.level_matrix (level))
+                                         * prolongation;
+        AssertTest ((galerkin - dense (gamg.level_matrix (level + 1)))
+                        .lpNorm<Eigen::Infinity> ()
+                    < 1e-12 * galerkin.lpNorm<Eigen::Infinity> ());
+    }
+
+    // A cycle is symmetric, so GAMG can precondition CG
+    const VectorXd u = VectorXd::LinSpaced (n_cells, -1., 2.);
+    const VectorXd v
+        = VectorXd::LinSpaced (n_cells, 3., 0.).array ().square ();
+    VectorXd gamg_u, gamg_v;
+    gamg.vmult (u, gamg_u);
+    gamg.vmult (v, gamg_v);
+    AssertTest (std::fabs (v.dot (gamg_u) - u.dot (gamg_v))
+                < 1e-12 * std::fabs (v.dot (gamg_u)));
+
+    SolverControl control;
+    control.tolerance    = 1e-12 * rhs.norm ();
+    const VectorXd exact = solve (matrix, rhs);
+
+    VectorXd     x      = VectorXd::Zero (n_cells);
+    SolverResult result = SolverGAMG (control).solve (matrix, x, rhs, gamg);
+    AssertTest (result.converged);
+    AssertTest (relative_error (x, exact) < 1e-10);
+
+    x.setZero ();
+    result = SolverCG (control).solve (matrix, x, rhs, gamg);
+    AssertTest (result.converged);
+    AssertTest (relative_error (x, exact) < 1e-10);
+
+    // A later timestep reuses the agglomeration
+    const std::vector<unsigned int> coarse_cells
+        = gamg.n_levels () > 1 ? gamg.coarse_cells (0)
+                               : std::vector<unsigned int> ();
+    assemble (matrix, rhs, mesh, 0.5);
+    gamg.update (matrix);
+    if (gamg.n_levels () > 1)
+        AssertTest (gamg.coarse_cells (0) == coarse_cells);
+    result = SolverCG (control).solve (matrix, x, rhs, gamg);
+    AssertTest (result.converged);
+    AssertTest (relative_error (x, solve (matrix, rhs)) < 1e-10);
+}
+} // namespace
+
+int gamg_01 (int, char **)
+{
+    // mesh_1d, the same mesh with shuffled cells, a 2 x 2 mesh, and two
+    // cells, which are solved for directly
+    for (const std::string directory :
+         { "mesh_1d", "renumbering_01", "unstructured_mesh_04",
+           "vtu_output_01" })
+    {
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        const unsigned int n_cells = mesh.n_cells ();
+
+        // The pattern built from the (owner, neighbour) pairs of the
+        // internal faces is the pattern of the mesh
+        const SparsityPattern sp (mesh);
+        std::vector<std::pair<unsigned int, unsigned int> > pairs;
+        for (unsigned int f = 0; f < mesh.get_patches ()[0].start_face; f++)
+            pairs.emplace_back (mesh.get_face (f)->neighbour_indices ()[0],
+                                mesh.get_face (f)->neighbour_indices ()[1]);
+        const SparsityPattern from_pairs (n_cells, pairs);
+        AssertTest (from_pairs.n_eqns () == n_cells);
+        AssertTest (from_pairs.upper_triangular_order ()
+                    == sp.upper_triangular_order ());
+        AssertTest (from_pairs.upper_triangular_row_start ()
+                    == sp.upper_triangular_row_start ());
+        for (unsigned int f = 0; f < pairs.size (); f++)
+        {
+            AssertTest (from_pairs.ij_from_arrow_index (f)
+                        == sp.ij_from_arrow_index (f));
+            AssertTest (from_pairs.owner_is_higher (f)
+                        == sp.owner_is_higher (f));
+        }
+
+        for (const auto smoother : { GAMGOptions::Smoother::gauss_seidel,
+                                     GAMGOptions::Smoother::dic })
+            for (const auto cycle :
+                 { GAMGOptions::Cycle::v, GAMGOptions::Cycle::w })
+                for (const unsigned int merge_levels : { 1, 2 })
+                {
+                    GAMGOptions options;
+                    options.smoother           = smoother;
+                    options.cycle              = cycle;
+                    options.merge_levels       = merge_levels;
+                    options.max_coarsest_cells = 2;
+                    check_hierarchy (mesh, options);
+
+                    // A coarsest level that is too large for a direct
+                    // solve is smoothed
+                    options.max_levels = merge_levels;
+                    check_hierarchy (mesh, options);
+                }
+
+        {
+            // Without faces pairing cannot coarsen, and the single level is
+            // smoothed, which is exact for a diagonal matrix
+            SparseMatrix   matrix (SparsityPattern (n_cells, {}));
+            VectorXd       rhs = VectorXd::Zero (n_cells);
+            const VectorXd old = VectorXd::LinSpaced (n_cells, 0., 1.);
+            Operators::ddt (matrix, rhs, mesh, old, 0.1);
+            GAMGOptions options;
+            options.max_coarsest_cells = 2;
+            const GAMG gamg (matrix, options);
+            AssertTest (gamg.n_levels () == 1);
+            VectorXd x;
+            gamg.vmult (rhs, x);
+            AssertTest (relative_error (x, old) < 1e-12);
+        }
+    }
+    std::cout << "Tested GAMG" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
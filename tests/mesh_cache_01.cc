@@ -0,0 +1,175 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+// Checks that a mesh read from a cache is identical to the parsed mesh
+void check_cached_mesh (UnstructuredMesh &a, UnstructuredMesh &b)
+{
+    AssertTest (a.n_points () == b.n_points ());
+    AssertTest (a.n_faces () == b.n_faces ());
+    AssertTest (a.n_cells () == b.n_cells ());
+    AssertTest (a.n_boundary_patches () == b.n_boundary_patches ());
+
+    for (unsigned int p = 0; p < a.n_points (); p++)
+        AssertTest (a.get_point (p)->distance (*b.get_point (p)) == 0.);
+
+    for (unsigned int f = 0; f < a.n_faces (); f++)
+    {
+        const auto &face_a = a.get_face (f);
+        const auto &face_b = b.get_face (f);
+        AssertTest (face_a->n_vertices () == face_b->n_vertices ());
+        for (unsigned int v = 0; v < face_a->n_vertices (); v++)
+            AssertTest (face_a->vertices ()[v] - a.get_point (0)
+                        == face_b->vertices ()[v] - b.get_point (0));
+        AssertTest (face_a->neighbour_indices ()
+                    == face_b->neighbour_indices ());
+        AssertTest (face_a->area_vector ().distance (face_b->area_vector ())
+                    == 0.);
+        AssertTest (face_a->area () == face_b->area ());
+        AssertTest (face_a->center ().distance (face_b->center ()) == 0.);
+        AssertTest (face_a->delta () == face_b->delta ());
+        AssertTest (face_a->interpolation_factor ()
+                    == face_b->interpolation_factor ());
+    }
+
+    for (unsigned int c = 0; c < a.n_cells (); c++)
+    {
+        const auto &cell_a = a.get_cell (c);
+        const auto &cell_b = b.get_cell (c);
+        AssertTest (cell_a->faces ().size () == cell_b->faces ().size ());
+        for (unsigned int f = 0; f < cell_a->faces ().size (); f++)
+            AssertTest (cell_a->faces ()[f] - a.get_face (0)
+                        == cell_b->faces ()[f] - b.get_face (0));
+        AssertTest (cell_a->volume () == cell_b->volume ());
+        AssertTest (cell_a->center ().distance (cell_b->center ()) == 0.);
+    }
+
+    for (unsigned int p = 0; p < a.n_boundary_patches (); p++)
+    {
+        const BoundaryPatch &patch_a = a.get_patches ()[p];
+        const BoundaryPatch &patch_b = b.get_patches ()[p];
+        AssertTest (patch_a.name == patch_b.name);
+        AssertTest (patch_a.type == patch_b.type);
+        AssertTest (patch_a.n_faces == patch_b.n_faces);
+        AssertTest (patch_a.start_face == patch_b.start_face);
+    }
+}
+
+// Reads the mesh in directory using cache_file, and returns whether it was
+// read from the cache
+bool read_mesh (const std::string &directory, const std::string &cache_file,
+                UnstructuredMesh &mesh)
+{
+    ParserOptions options;
+    options.cache_file = cache_file;
+    UnstructuredMeshParser parser (
+        mesh, directory + "/points", directory + "/faces",
+        directory + "/owner", directory + "/neighbour",
+        directory + "/boundary", options);
+    return parser.loaded_from_cache ();
+}
+
+int mesh_cache_01 (int, char **)
+{
+    const std::string directory = "mesh_cache_01/mesh_1d";
+    std::filesystem::remove_all ("mesh_cache_01");
+    std::filesystem::create_directories ("mesh_cache_01");
+    std::filesystem::copy ("mesh_1d", directory);
+    const std::string cache_file = "mesh_cache_01/mesh.cache";
+
+    UnstructuredMesh parsed_mesh;
+    AssertTest (!read_mesh (directory, "", parsed_mesh));
+    AssertTest (!std::filesystem::exists (cache_file));
+
+    {
+        // The first read writes the cache, the second one reads it
+        UnstructuredMesh first_mesh, second_mesh;
+        AssertTest (!read_mesh (directory, cache_file, first_mesh));
+        AssertTest (std::filesystem::exists (cache_file));
+        AssertTest (read_mesh (directory, cache_file, second_mesh));
+        check_cached_mesh (parsed_mesh, first_mesh);
+        check_cached_mesh (parsed_mesh, second_mesh);
+    }
+    std::cout << "Tested cache reading" << std::endl;
+
+    {
+        // Modifying a polyMesh file invalidates the cache, which is then
+        // rewritten
+        const std::string owner_file = directory + "/owner";
+        std::filesystem::last_write_time (
+            owner_file, std::filesystem::last_write_time (owner_file)
+                            + std::chrono::seconds (10));
+        UnstructuredMesh stale_mesh, fresh_mesh;
+        AssertTest (!read_mesh (directory, cache_file, stale_mesh));
+        AssertTest (read_mesh (directory, cache_file, fresh_mesh));
+        check_cached_mesh (parsed_mesh, stale_mesh);
+        check_cached_mesh (parsed_mesh, fresh_mesh);
+    }
+    std::cout << "Tested stale cache" << std::endl;
+
+    {
+        // Truncated and unrelated files are not used as cache
+        const auto size = std::filesystem::file_size (cache_file);
+        std::filesystem::resize_file (cache_file, size - 8);
+        UnstructuredMesh truncated_mesh;
+        AssertTest (!read_mesh (directory, cache_file, truncated_mesh));
+        check_cached_mesh (parsed_mesh, truncated_mesh);
+        AssertTest (std::filesystem::file_size (cache_file) == size);
+
+        {
+            std::ofstream out (cache_file, std::ios::binary);
+            out << "not a mesh cache";
+        }
+        UnstructuredMesh unrelated_mesh, cached_mesh;
+        AssertTest (!read_mesh (directory, cache_file, unrelated_mesh));
+        AssertTest (read_mesh (directory, cache_file, cached_mesh));
+        check_cached_mesh (parsed_mesh, unrelated_mesh);
+        check_cached_mesh (parsed_mesh, cached_mesh);
+    }
+    std::cout << "Tested invalid cache" << std::endl;
+
+    {
+        // A cache of the right size with an out of range owner throws
+        std::fstream file (cache_file,
+                           std::ios::in | std::ios::out | std::ios::binary);
+        std::uint64_t sizes[4];
+        file.seekg (16);
+        file.read (reinterpret_cast<char *> (sizes), sizeof (sizes));
+        const auto padded = [] (const std::uint64_t n) {
+            return (n + 7) / 8 * 8;
+        };
+        // The header, then the points, face offsets and face vertices
+        const std::uint64_t owner_offset = 152 + padded (24 * sizes[0])
+                                           + padded (4 * (sizes[1] + 1))
+                                           + padded (4 * sizes[2]);
+        const std::uint32_t n_cells = sizes[3];
+        file.seekp (owner_offset);
+        file.write (reinterpret_cast<const char *> (&n_cells),
+                    sizeof (n_cells));
+        file.close ();
+
+        bool caught = false;
+        try
+        {
+            UnstructuredMesh damaged_mesh;
+            read_mesh (directory, cache_file, damaged_mesh);
+        }
+        catch (std::runtime_error &)
+        {
+            caught = true;
+        }
+        AssertTest (caught);
+    }
+    std::cout << "Tested damaged cache" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/operators.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <Eigen/SparseLU>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+namespace
+{
+VectorXd solve (const SparseMatrix &matrix, const VectorXd &rhs)
+{
+    Eigen::SparseMatrix<double> eigen_matrix;
+    matrix.copy_to (eigen_matrix);
+    Eigen::SparseLU<Eigen::SparseMatrix<double> > solver (eigen_matrix);
+    return solver.solve (rhs);
+}
+
+BoundaryConditions boundary_conditions (UnstructuredMesh  &mesh,
+                                        const std::string &type,
+                                        const double       inlet_value)
+{
+    BoundaryConditions conditions;
+    for (const BoundaryPatch &patch : mesh.get_patches ())
+        conditions.emplace_back (
+            patch, BoundaryFieldEntry (patch.type == empty ? "empty" : type,
+                                       patch.name == "inlet" ? inlet_value
+                                                             : 0.));
+    return conditions;
+}
+} // namespace
+
+int operators_01 (int, char **)
+{
+    // mesh_1d, and the same mesh with shuffled cells, whose faces are often
+    // owned by the cell with the higher index
+    for (const std::string directory : { "mesh_1d", "renumbering_01" })
+    {
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        const unsigned int    n_cells = mesh.n_cells ();
+        const SparsityPattern sp (mesh);
+        SparseMatrix          matrix (sp);
+        VectorXd              rhs = VectorXd::Zero (n_cells);
+
+        // Steady diffusion between fixed values is linear in x, which the
+        // discretisation reproduces exactly
+        const BoundaryConditions fixed
+            = boundary_conditions (mesh, "fixedValue", 1.);
+        Operators::laplacian (matrix, rhs, mesh, fixed, 0.01);
+        AssertTest (matrix.symmetric ());
+        const VectorXd solution = solve (matrix, rhs);
+        const double   x_inlet
+            = mesh.get_face (mesh.get_patches ()[0].start_face)->center () (0);
+        const double x_outlet
+            = mesh.get_face (mesh.get_patches ()[1].start_face)->center () (0);
+        for (unsigned int c = 0; c < n_cells; c++)
+        {
+            const double x = mesh.get_cell (c)->center () (0);
+            AssertTest (std::fabs (solution (c)
+                                   - (x - x_outlet) / (x_inlet - x_outlet))
+                        < 1e-12);
+        }
+
+        // The implicit Euler time derivative
+        matrix.set_zero ();
+        rhs.setZero ();
+        const VectorXd old_field = VectorXd::LinSpaced (n_cells, 0., 1.);
+        Operators::ddt (matrix, rhs, mesh, old_field, 0.1);
+        Operators::source (rhs, mesh, 3, 2.);
+        for (unsigned int c = 0; c < n_cells; c++)
+        {
+            const double volume = mesh.get_cell (c)->volume ();
+            AssertTest (close (matrix (c, c), volume / 0.1));
+            AssertTest (close (rhs (c), volume / 0.1 * old_field (c)
+                                            + (c == 3 ? 2. * volume : 0.)));
+        }
+
+        // Convection of a uniform field with zero gradient boundaries, with
+        // the velocity either way along the mesh. The divergence of a
+        // uniform velocity is zero, so every row sums to zero.
+        const BoundaryConditions zero_gradient
+            = boundary_conditions (mesh, "zeroGradient", 0.);
+        for (const Point<3> &velocity :
+             { Point<3> (1., 0., 0.), Point<3> (-1., 0., 0.) })
+            for (const auto scheme : { Operators::ConvectionScheme::upwind,
+                                       Operators::ConvectionScheme::centred })
+            {
+                matrix.set_zero ();
+                rhs.setZero ();
+                Operators::div (matrix, rhs, mesh, zero_gradient, velocity,
+                                scheme);
+                VectorXd row_sums (n_cells);
+                matrix.vmult (VectorXd::Ones (n_cells), row_sums);
+                AssertTest (row_sums.lpNorm<Eigen::Infinity> () < 1e-15);
+
+                // Upwinding takes the face value from the cell the flow
+                // comes from
+                if (scheme != Operators::ConvectionScheme::upwind)
+                    continue;
+                for (unsigned int f = 0; f < mesh.get_patches ()[0].start_face;
+                     f++)
+                {
+                    const auto        &face  = mesh.get_face (f);
+                    const unsigned int owner = face->neighbour_indices ()[0];
+                    const unsigned int neighbour
+                        = face->neighbour_indices ()[1];
+                    const double flux = velocity.dot (face->area_vector ());
+                    AssertTest (matrix (owner, neighbour)
+                                == (flux > 0 ? 0. : flux));
+                    AssertTest (matrix (neighbour, owner)
+                                == (flux > 0 ? -flux : 0.));
+                }
+            }
+
+        // Steady convection and diffusion with a fixed inlet value and a
+        // zero gradient outlet is solved by the inlet value everywhere
+        matrix.set_zero ();
+        rhs.setZero ();
+        BoundaryConditions inflow;
+        for (const BoundaryPatch &patch : mesh.get_patches ())
+            inflow.emplace_back (
+                patch, BoundaryFieldEntry (patch.type == empty ? "empty"
+                                           : patch.name == "inlet"
+                                               ? "fixedValue"
+                                               : "zeroGradient",
+                                           1.));
+        Operators::laplacian (matrix, rhs, mesh, inflow, 1e-4);
+        Operators::div (matrix, rhs, mesh, inflow, Point<3> (1., 0., 0.),
+                        Operators::ConvectionScheme::upwind);
+        const VectorXd convected = solve (matrix, rhs);
+        AssertTest ((convected - VectorXd::Ones (n_cells))
+                        .lpNorm<Eigen::Infinity> ()
+                    < 1e-12);
+    }
+    std::cout << "Tested operators" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
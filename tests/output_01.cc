@@ -0,0 +1,102 @@
+#include <FVMCode/field_reader.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/output.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+int output_01 (int, char **)
+{
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (mesh, "mesh_1d/points", "mesh_1d/faces",
+                                   "mesh_1d/owner", "mesh_1d/neighbour",
+                                   "mesh_1d/boundary");
+    const unsigned int               n_cells = mesh.n_cells ();
+    const std::vector<BoundaryPatch> patches = mesh.get_patches ();
+    BoundaryConditions               boundary_conditions;
+    boundary_conditions.emplace_back (patches[0],
+                                      BoundaryFieldEntry ("fixedValue", 0.1));
+    boundary_conditions.emplace_back (
+        patches[1], BoundaryFieldEntry ("zeroGradient", 0));
+    boundary_conditions.emplace_back (patches[2],
+                                      BoundaryFieldEntry ("empty", 0));
+
+    // Values that need all digits, and extreme ones
+    std::mt19937                           generator (3);
+    std::uniform_real_distribution<double> distribution (-1e3, 1e3);
+    Eigen::VectorXd                        field (n_cells);
+    for (unsigned int c = 0; c < n_cells; c++)
+        field (c) = distribution (generator);
+    field (0) = std::numeric_limits<double>::max ();
+    field (1) = -std::numeric_limits<double>::min ();
+    field (2) = std::numeric_limits<double>::denorm_min ();
+    field (3) = 0;
+    field (4) = 1e22;
+
+    const std::filesystem::path working_directory
+        = std::filesystem::current_path ();
+    std::filesystem::remove_all ("output_01");
+    std::filesystem::create_directory ("output_01");
+    std::filesystem::current_path ("output_01");
+
+    // Both formats read back exactly, with the time of the time directory
+    for (const Outputter::Format format :
+         { Outputter::Format::ascii, Outputter::Format::binary })
+    {
+        const double time = format == Outputter::Format::ascii ? 0.1 : 0.3;
+        Outputter    outputter (3, time, 0.1, 0.1, 2, format);
+        outputter.write_time ();
+        outputter.write_scalar_field (field, "T", boundary_conditions);
+
+        Eigen::VectorXd    read_field;
+        BoundaryConditions read_conditions;
+        Input::read_scalar_field (Outputter::name_from_time (time, 2) + "/T",
+                                  n_cells, patches, read_field,
+                                  read_conditions);
+        AssertTest (read_field == field);
+        AssertTest (read_conditions[0].second.value == 0.1);
+
+        const std::optional<Input::TimeDirectory> latest
+            = Input::find_latest_time (".", "T");
+        AssertTest (latest->time == time);
+    }
+    std::cout << "Tested formats" << std::endl;
+
+    {
+        // A permutation that does not match the field throws
+        Outputter outputter (4, 0.4, 0.1, 0.1, 2);
+        outputter.write_time ();
+        std::vector<unsigned int> short_permutation (n_cells - 1);
+        std::vector<unsigned int> bad_permutation (n_cells, 0);
+        bad_permutation.back () = n_cells;
+        for (const auto *permutation :
+             { &short_permutation, &bad_permutation })
+        {
+            bool caught = false;
+            try
+            {
+                outputter.write_scalar_field (field, "T", boundary_conditions,
+                                              *permutation);
+            }
+            catch (std::runtime_error &)
+            {
+                caught = true;
+            }
+            AssertTest (caught);
+        }
+    }
+    std::cout << "Tested permutations" << std::endl;
+
+    std::filesystem::current_path (working_directory);
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/partitioning.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+// Checks that every cell and face is accounted for exactly once
+void check_consistency (UnstructuredMesh &mesh, const MeshPartitioning &mp)
+{
+    std::vector<unsigned int> cell_count (mesh.n_cells (), 0);
+    std::vector<unsigned int> face_count (mesh.n_faces (), 0);
+    unsigned int              n_interface_entries = 0;
+    for (unsigned int p = 0; p < mp.n_partitions (); p++)
+    {
+        const Partition &partition = mp.partition (p);
+        for (const unsigned int c : partition.cells)
+        {
+            AssertTest (mp.partition_of_cell (c) == p);
+            cell_count[c]++;
+        }
+        for (const unsigned int f : partition.internal_faces)
+        {
+            const auto &cells = mesh.get_face (f)->neighbour_indices ();
+            AssertTest (mp.partition_of_cell (cells[0]) == p);
+            AssertTest (mp.partition_of_cell (cells[1]) == p);
+            face_count[f] += 2;
+        }
+        for (const unsigned int f : partition.interface_faces)
+        {
+            const auto &cells = mesh.get_face (f)->neighbour_indices ();
+            AssertTest (mp.partition_of_cell (cells[0])
+                        != mp.partition_of_cell (cells[1]));
+            face_count[f]++;
+            n_interface_entries++;
+        }
+        for (const unsigned int f : partition.boundary_faces)
+        {
+            AssertTest (mesh.get_face (f)->is_boundary ());
+            face_count[f] += 2;
+        }
+        for (const unsigned int c : partition.halo_cells)
+            AssertTest (mp.partition_of_cell (c) != p);
+    }
+    for (const unsigned int count : cell_count)
+        AssertTest (count == 1);
+    for (const unsigned int count : face_count)
+        AssertTest (count == 2);
+    AssertTest (n_interface_entries == 2 * mp.edge_cut ());
+}
+
+int partitioning_01 (int, char **)
+{
+    {
+        // 1D mesh of 20 blocks, each with extent (0.005 0.1, 0.01), and
+        // stacked in the x direction
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (mesh, "mesh_1d/points", "mesh_1d/faces",
+                                       "mesh_1d/owner", "mesh_1d/neighbour",
+                                       "mesh_1d/boundary");
+
+        for (unsigned int n_partitions = 1; n_partitions <= 7; n_partitions++)
+        {
+            MeshPartitioning mp (mesh, n_partitions);
+            check_consistency (mesh, mp);
+            // A chain split into contiguous pieces
+            AssertTest (mp.edge_cut () == n_partitions - 1);
+            AssertTest (mp.load_imbalance () < 1.3);
+        }
+
+        MeshPartitioning mp (mesh, 4);
+        AssertTest (close (mp.load_imbalance (), 1));
+        for (unsigned int p = 0; p < 4; p++)
+        {
+            AssertTest (mp.partition (p).cells.size () == 5);
+            AssertTest (mp.partition (p).internal_faces.size () == 4);
+            AssertTest (mp.partition (p).halo_cells.size ()
+                        == ((p == 0 || p == 3) ? 1 : 2));
+        }
+    }
+
+    {
+        // 2D mesh of 4 blocks, 2x2x1 and overall 1m x 1m x 1m
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, "unstructured_mesh_04/points", "unstructured_mesh_04/faces",
+            "unstructured_mesh_04/owner", "unstructured_mesh_04/neighbour",
+            "unstructured_mesh_04/boundary");
+
+        MeshPartitioning mp (mesh, 2);
+        check_consistency (mesh, mp);
+        AssertTest (mp.edge_cut () == 2);
+        AssertTest (close (mp.load_imbalance (), 1));
+    }
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -17,6 +17,14 @@ int point_02 (int, char**)
     Point<3, int> p3 = p1ref - p2ref;
     AssertTest(p3(0) == 3 && p3(1) == 3 && p3(2) == 3);
 
+    // Default constructed points are zero and stored inline with alignment
+    // suitable for vector loads
+    const Point<3> p4;
+    AssertTest(p4(0) == 0. && p4(1) == 0. && p4(2) == 0.);
+    static_assert(alignof(Point<3>) == 32, "Point<3> should be 32 byte aligned");
+    static_assert(sizeof(Point<2>) == 2 * sizeof(double),
+                  "Point<2> should not be padded");
+
     MAIN_OUTPUT;
 
     return EXIT_SUCCESS;
@@ -0,0 +1,101 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/output.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <fstream>
+
+#include "test_helpers.h"
+
+int renumbering_01 (int, char **)
+{
+    // The 1D mesh of 20 blocks from mesh_1d, with the cell labels in the
+    // owner and neighbour files shuffled. Reverse Cuthill-McKee should
+    // recover a band of one.
+    using namespace FVMCode;
+
+    UnstructuredMesh mesh, reference;
+    for (UnstructuredMesh *m : { &mesh, &reference })
+        UnstructuredMeshParser parser (
+            *m, "renumbering_01/points", "renumbering_01/faces",
+            "renumbering_01/owner", "renumbering_01/neighbour",
+            "renumbering_01/boundary");
+
+    AssertTest (mesh.original_cell_indices ().empty ());
+
+    const auto report = mesh.renumber_cells_rcm ();
+    std::cout << "Band before: " << report.band_before
+              << ", band after: " << report.band_after << std::endl;
+    AssertTest (report.band_before == reference.matrix_band ());
+    AssertTest (report.band_before > 1);
+    AssertTest (report.band_after == 1);
+    AssertTest (mesh.matrix_band () == 1);
+
+    const auto &original = mesh.original_cell_indices ();
+    AssertTest (original.size () == mesh.n_cells ());
+
+    for (unsigned int c = 0; c < mesh.n_cells (); c++)
+    {
+        const auto &cell = mesh.get_cell (c);
+        const auto &ref  = reference.get_cell (original[c]);
+        AssertTest (close (cell->volume (), ref->volume ()));
+        AssertTest (close (cell->center ().distance (ref->center ()), 0));
+        for (const auto &face : cell->faces ())
+        {
+            const auto &neighbours = face->neighbour_indices ();
+            AssertTest (neighbours[0] == c
+                        || (neighbours.size () == 2 && neighbours[1] == c));
+        }
+    }
+
+    unsigned int n_internal_faces = 0;
+    for (unsigned int f = 0; f < mesh.n_faces (); f++)
+    {
+        const auto &face = mesh.get_face (f);
+        AssertTest (close (face->area (), reference.get_face (f)->area ()));
+        if (face->is_boundary ())
+        {
+            // Boundary faces keep their position
+            AssertTest (original[face->neighbour_indices ()[0]]
+                        == reference.get_face (f)->neighbour_indices ()[0]);
+            continue;
+        }
+        n_internal_faces++;
+
+        const unsigned int owner     = face->neighbour_indices ()[0];
+        const unsigned int neighbour = face->neighbour_indices ()[1];
+        AssertTest (owner < neighbour);
+        AssertTest (face->area_vector ().dot (
+                        mesh.get_cell (neighbour)->center ()
+                        - mesh.get_cell (owner)->center ())
+                    > 0);
+        AssertTest (0 < face->interpolation_factor ()
+                    && face->interpolation_factor () < 1);
+        if (f > 0)
+            AssertTest (mesh.get_face (f - 1)->neighbour_indices ()
+                        < face->neighbour_indices ());
+    }
+    AssertTest (n_internal_faces == 19);
+
+    // Fields are written back in the original cell order
+    VectorXd field (mesh.n_cells ());
+    for (unsigned int c = 0; c < mesh.n_cells (); c++)
+        field (c) = original[c];
+    {
+        Outputter outputter (0, 0.25, 0.1, 0.1);
+        outputter.write_scalar_field (field, "T", {}, original);
+    }
+    std::ifstream file ("0.25/T");
+    std::string   line;
+    while (std::getline (file, line) && line != "(")
+        ;
+    for (unsigned int c = 0; c < mesh.n_cells (); c++)
+    {
+        double value;
+        file >> value;
+        AssertTest (value == c);
+    }
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
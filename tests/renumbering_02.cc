@@ -0,0 +1,95 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/renumbering.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+
+#include "test_helpers.h"
+
+int renumbering_02 (int, char **)
+{
+    // Tests space filling curve keys and renumbering of a mesh along them
+    using namespace FVMCode;
+    using namespace FVMCode::Renumbering;
+
+    AssertTest (morton_key (0, 0, 0) == 0);
+    AssertTest (morton_key (0, 0, 1) == 1);
+    AssertTest (morton_key (0, 1, 0) == 2);
+    AssertTest (morton_key (1, 0, 0) == 4);
+    AssertTest (morton_key (2, 0, 0) == 32);
+    AssertTest (morton_key ((1u << 21) - 1, (1u << 21) - 1, (1u << 21) - 1)
+                == (std::uint64_t (1) << 63) - 1);
+
+    {
+        // Consecutive points along the Hilbert curve through a grid are
+        // always neighbours
+        const unsigned int        n = 8;
+        std::vector<Point<3> >    grid;
+        for (unsigned int i = 0; i < n; i++)
+            for (unsigned int j = 0; j < n; j++)
+                for (unsigned int k = 0; k < n; k++)
+                    grid.push_back (Point<3> (i, j, k));
+        const std::vector<unsigned int> order
+            = space_filling_curve_order (grid, SpaceFillingCurve::hilbert);
+
+        std::vector<unsigned int> sorted (order);
+        std::sort (sorted.begin (), sorted.end ());
+        std::vector<unsigned int> identity (grid.size ());
+        std::iota (identity.begin (), identity.end (), 0);
+        AssertTest (sorted == identity);
+
+        for (unsigned int i = 1; i < order.size (); i++)
+        {
+            const Point<3> step = grid[order[i]] - grid[order[i - 1]];
+            AssertTest (close (std::fabs (step (0)) + std::fabs (step (1))
+                                   + std::fabs (step (2)),
+                               1));
+        }
+    }
+
+    for (const auto curve :
+         { SpaceFillingCurve::morton, SpaceFillingCurve::hilbert })
+    {
+        UnstructuredMesh mesh, reference;
+        for (UnstructuredMesh *m : { &mesh, &reference })
+            UnstructuredMeshParser parser (
+                *m, "renumbering_01/points", "renumbering_01/faces",
+                "renumbering_01/owner", "renumbering_01/neighbour",
+                "renumbering_01/boundary");
+
+        const auto report = mesh.renumber_space_filling_curve (curve);
+        std::cout << "Band before: " << report.band_before
+                  << ", band after: " << report.band_after << std::endl;
+        AssertTest (report.band_after < report.band_before);
+
+        const auto &original = mesh.original_cell_indices ();
+        for (unsigned int c = 0; c < mesh.n_cells (); c++)
+        {
+            const auto &cell = mesh.get_cell (c);
+            const auto &ref  = reference.get_cell (original[c]);
+            AssertTest (close (cell->volume (), ref->volume ()));
+            AssertTest (close (cell->center ().distance (ref->center ()), 0));
+        }
+
+        for (const Face<3> &face : mesh.faces ())
+        {
+            // The vertex iterators must point at the renumbered points
+            const Face<3> recomputed (face.vertices ());
+            AssertTest (close (recomputed.center ().distance (face.center ()),
+                               0));
+            AssertTest (
+                close (recomputed.area_vector ().distance (face.area_vector ()),
+                       0));
+            for (const auto &vertex : face.vertices ())
+                AssertTest (vertex - mesh.get_point (0) >= 0
+                            && vertex - mesh.get_point (0)
+                                   < (long)mesh.n_points ());
+        }
+    }
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/operators.h>
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_cg.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <Eigen/Dense>
+#include <Eigen/SparseLU>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+namespace
+{
+double relative_error (const VectorXd &a, const VectorXd &b)
+{
+    return (a - b).lpNorm<Eigen::Infinity> () / b.lpNorm<Eigen::Infinity> ();
+}
+} // namespace
+
+int solver_cg_01 (int, char **)
+{
+    // mesh_1d, the same mesh with shuffled cells, and a 2 x 2 mesh, whose
+    // faces form a cycle
+    for (const std::string directory :
+         { "mesh_1d", "renumbering_01", "unstructured_mesh_04" })
+    {
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        const unsigned int n_cells     = mesh.n_cells ();
+        const bool         tridiagonal = directory == "mesh_1d";
+
+        // A timestep of the heat equation, which is symmetric positive
+        // definite
+        BoundaryConditions bcs;
+        for (const BoundaryPatch &patch : mesh.get_patches ())
+            bcs.emplace_back (
+                patch,
+                BoundaryFieldEntry (patch.type == empty ? "empty"
+                                                        : "fixedValue",
+                                    patch.name == "inlet" ? 1. : 0.));
+        const SparsityPattern sp (mesh);
+        SparseMatrix          matrix (sp);
+        VectorXd              rhs = VectorXd::Zero (n_cells);
+        Operators::ddt (matrix, rhs, mesh,
+                        VectorXd::LinSpaced (n_cells, 0., 1.), 0.05);
+        Operators::laplacian (matrix, rhs, mesh, bcs, 0.01);
+        Operators::source (rhs, mesh, 1.);
+        AssertTest (matrix.symmetric ());
+
+        Eigen::SparseMatrix<double> eigen_matrix;
+        matrix.copy_to (eigen_matrix);
+        const Eigen::MatrixXd dense (eigen_matrix);
+        Eigen::SparseLU<Eigen::SparseMatrix<double> > lu (eigen_matrix);
+        const VectorXd exact = lu.solve (rhs);
+
+        // DIC keeps the diagonal and the off-diagonal entries of the
+        // matrix, and only adds entries outside its pattern
+        const PreconditionerDIC dic (matrix);
+        Eigen::MatrixXd         dic_inverse (n_cells, n_cells);
+        for (unsigned int c = 0; c < n_cells; c++)
+        {
+            VectorXd column;
+            dic.vmult (VectorXd::Unit (n_cells, c), column);
+            dic_inverse.col (c) = column;
+        }
+        const Eigen::MatrixXd dic_matrix = dic_inverse.inverse ();
+        for (unsigned int i = 0; i < n_cells; i++)
+            for (unsigned int j = 0; j < n_cells; j++)
+                if (dense (i, j) != 0. || tridiagonal)
+                    AssertTest (std::fabs (dic_matrix (i, j) - dense (i, j))
+                                < 1e-10 * dense (i, i));
+
+        const PreconditionerJacobi jacobi (matrix);
+        SolverControl              control;
+        control.tolerance = 1e-12 * rhs.norm ();
+        const SolverCG solver (control);
+
+        VectorXd     x      = VectorXd::Zero (n_cells);
+        SolverResult result = solver.solve (matrix, x, rhs);
+        AssertTest (result.converged);
+        AssertTest (result.final_residual <= control.tolerance);
+        AssertTest (close (result.initial_residual, rhs.norm ()));
+        AssertTest (relative_error (x, exact) < 1e-10);
+        const unsigned int identity_iterations = result.iterations;
+
+        x.setZero ();
+        result = solver.solve (matrix, x, rhs, jacobi);
+        AssertTest (result.converged);
+        AssertTest (relative_error (x, exact) < 1e-10);
+        AssertTest (result.iterations <= identity_iterations);
+        const unsigned int jacobi_iterations = result.iterations;
+
+        // The matrix of mesh_1d is tridiagonal, so DIC is its exact Cholesky
+        // factorisation. Shuffling the cells loses that, but DIC still
+        // helps.
+        x.setZero ();
+        result = solver.solve (matrix, x, rhs, dic);
+        AssertTest (result.converged);
+        AssertTest (relative_error (x, exact) < 1e-10);
+        if (directory == "renumbering_01")
+            AssertTest (result.iterations < jacobi_iterations);
+        if (tridiagonal)
+            AssertTest (result.iterations == 1);
+
+        // A warm start at the solution needs no iterations
+        result = solver.solve (matrix, x, rhs, dic);
+        AssertTest (result.converged);
+        AssertTest (result.iterations == 0);
+
+        // Relative tolerance, and running out of iterations
+        SolverControl relative;
+        relative.tolerance          = 0.;
+        relative.relative_tolerance = 1e-3;
+        x.setZero ();
+        result = SolverCG (relative).solve (matrix, x, rhs, jacobi);
+        AssertTest (result.converged);
+        AssertTest (result.final_residual <= 1e-3 * result.initial_residual);
+
+        SolverControl limited;
+        limited.max_iterations = 1;
+        x.setZero ();
+        result = SolverCG (limited).solve (matrix, x, rhs);
+        AssertTest (!result.converged);
+        AssertTest (result.iterations == 1);
+        AssertTest (result.final_residual < result.initial_residual);
+    }
+    std::cout << "Tested CG" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
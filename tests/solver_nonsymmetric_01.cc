@@ -0,0 +1,160 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/operators.h>
+#include <FVMCode/solvers/preconditioners.h>
+#include <FVMCode/solvers/solver_bicgstab.h>
+#include <FVMCode/solvers/solver_gmres.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <Eigen/Dense>
+#include <Eigen/SparseLU>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+namespace
+{
+double relative_error (const VectorXd &a, const VectorXd &b)
+{
+    return (a - b).lpNorm<Eigen::Infinity> () / b.lpNorm<Eigen::Infinity> ();
+}
+
+// Checks that a solver converges to @p exact from zero and from a warm start
+// at @p exact, and returns the number of iterations from zero
+template <typename Solver>
+unsigned int check_solver (const Solver &solver, const SparseMatrix &matrix,
+                           const VectorXd &rhs, const VectorXd &exact,
+                           const Preconditioner &preconditioner)
+{
+    VectorXd           x      = VectorXd::Zero (rhs.size ());
+    const SolverResult result = solver.solve (matrix, x, rhs, preconditioner);
+    AssertTest (result.converged);
+    AssertTest (result.final_residual <= solver.control.tolerance);
+    AssertTest (close (result.initial_residual, rhs.norm ()));
+    // BiCGStab updates its residual rather than computing it, so the two may
+    // drift apart
+    VectorXd product;
+    matrix.vmult (x, product);
+    AssertTest ((rhs - product).norm () <= 10. * solver.control.tolerance);
+    AssertTest (relative_error (x, exact) < 1e-10);
+
+    const SolverResult warm = solver.solve (matrix, x, rhs, preconditioner);
+    AssertTest (warm.converged);
+    AssertTest (warm.iterations == 0);
+    return result.iterations;
+}
+} // namespace
+
+int solver_nonsymmetric_01 (int, char **)
+{
+    // mesh_1d, the same mesh with shuffled cells, and a 2 x 2 mesh, whose
+    // faces form a cycle
+    for (const std::string directory :
+         { "mesh_1d", "renumbering_01", "unstructured_mesh_04" })
+    {
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, directory + "/points", directory + "/faces",
+            directory + "/owner", directory + "/neighbour",
+            directory + "/boundary");
+        const unsigned int n_cells     = mesh.n_cells ();
+        const bool         tridiagonal = directory == "mesh_1d";
+
+        // A timestep of convection and diffusion, with upwinding, which
+        // makes the matrix non-symmetric
+        BoundaryConditions bcs;
+        for (const BoundaryPatch &patch : mesh.get_patches ())
+            bcs.emplace_back (
+                patch,
+                BoundaryFieldEntry (patch.type == empty ? "empty"
+                                                        : "fixedValue",
+                                    patch.name == "inlet" ? 1. : 0.));
+        const SparsityPattern sp (mesh);
+        SparseMatrix          matrix (sp);
+        VectorXd              rhs = VectorXd::Zero (n_cells);
+        Operators::ddt (matrix, rhs, mesh,
+                        VectorXd::LinSpaced (n_cells, 0., 1.), 0.05);
+        Operators::laplacian (matrix, rhs, mesh, bcs, 0.01);
+        Operators::div (matrix, rhs, mesh, bcs, Point<3> (1., 0.5, 0.),
+                        Operators::ConvectionScheme::upwind);
+        AssertTest (!matrix.symmetric ());
+
+        Eigen::SparseMatrix<double> eigen_matrix;
+        matrix.copy_to (eigen_matrix);
+        const Eigen::MatrixXd dense (eigen_matrix);
+        Eigen::SparseLU<Eigen::SparseMatrix<double> > lu (eigen_matrix);
+        const VectorXd exact = lu.solve (rhs);
+
+        // DILU keeps the diagonal and the off-diagonal entries of the
+        // matrix, and only adds entries outside its pattern. The matrix of
+        // mesh_1d is tridiagonal, so DILU is its exact LU factorisation.
+        const PreconditionerDILU dilu (matrix);
+        Eigen::MatrixXd          dilu_inverse (n_cells, n_cells);
+        for (unsigned int c = 0; c < n_cells; c++)
+        {
+            VectorXd column;
+            dilu.vmult (VectorXd::Unit (n_cells, c), column);
+            dilu_inverse.col (c) = column;
+        }
+        const Eigen::MatrixXd dilu_matrix = dilu_inverse.inverse ();
+        for (unsigned int i = 0; i < n_cells; i++)
+            for (unsigned int j = 0; j < n_cells; j++)
+                if (dense (i, j) != 0. || tridiagonal)
+                    AssertTest (std::fabs (dilu_matrix (i, j) - dense (i, j))
+                                < 1e-10 * dense (i, i));
+
+        SolverControl control;
+        control.tolerance = 1e-12 * rhs.norm ();
+        const PreconditionerIdentity identity;
+        const PreconditionerJacobi   jacobi (matrix);
+
+        const SolverBiCGStab bicgstab (control);
+        check_solver (bicgstab, matrix, rhs, exact, identity);
+        const unsigned int bicgstab_jacobi
+            = check_solver (bicgstab, matrix, rhs, exact, jacobi);
+        const unsigned int bicgstab_dilu
+            = check_solver (bicgstab, matrix, rhs, exact, dilu);
+        if (tridiagonal)
+            AssertTest (bicgstab_dilu == 1);
+        if (directory == "renumbering_01")
+            AssertTest (bicgstab_dilu < bicgstab_jacobi);
+
+        // Without restarts, GMRES converges in at most n iterations; with
+        // restarts after 3 iterations, it must still converge
+        const SolverGMRES gmres (control);
+        AssertTest (check_solver (gmres, matrix, rhs, exact, identity)
+                    <= n_cells);
+        const unsigned int gmres_jacobi
+            = check_solver (gmres, matrix, rhs, exact, jacobi);
+        const unsigned int gmres_dilu
+            = check_solver (gmres, matrix, rhs, exact, dilu);
+        if (tridiagonal)
+            AssertTest (gmres_dilu == 1);
+        if (directory == "renumbering_01")
+            AssertTest (gmres_dilu < gmres_jacobi);
+        check_solver (SolverGMRES (control, 3), matrix, rhs, exact, jacobi);
+
+        // Running out of iterations
+        SolverControl limited  = control;
+        limited.max_iterations = 2;
+        VectorXd x             = VectorXd::Zero (n_cells);
+        SolverResult result = SolverBiCGStab (limited).solve (matrix, x, rhs);
+        AssertTest (result.converged == (result.iterations < 2));
+        if (n_cells > 4)
+        {
+            AssertTest (!result.converged);
+            x.setZero ();
+            result = SolverGMRES (limited).solve (matrix, x, rhs);
+            AssertTest (!result.converged);
+            AssertTest (result.iterations == 2);
+            AssertTest (result.final_residual < result.initial_residual);
+        }
+    }
+    std::cout << "Tested BiCGStab and GMRES" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
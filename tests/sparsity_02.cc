@@ -0,0 +1,104 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/sparsity/sparse_matrix.h>
+#include <FVMCode/sparsity/sparsity_pattern.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "test_helpers.h"
+
+int sparsity_02 (int, char **)
+{
+    // Face-indexed assembly on a mesh in which many faces are owned by the
+    // cell with the higher index
+    using namespace FVMCode;
+
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (
+        mesh, "renumbering_01/points", "renumbering_01/faces",
+        "renumbering_01/owner", "renumbering_01/neighbour",
+        "renumbering_01/boundary");
+    const unsigned int n_cells          = mesh.n_cells ();
+    const unsigned int n_internal_faces = mesh.get_patches ()[0].start_face;
+
+    // With the debug index, every lookup is checked against the map
+    SparsityPattern sp (mesh, true);
+    AssertTest (sp.n_off_diagonal_entries () == 2 * n_internal_faces);
+
+    unsigned int n_owner_higher = 0;
+    for (unsigned int f = 0; f < n_internal_faces; f++)
+    {
+        const auto        &face      = mesh.get_face (f);
+        const unsigned int owner     = face->neighbour_indices ()[0];
+        const unsigned int neighbour = face->neighbour_indices ()[1];
+        AssertTest (sp.owner_is_higher (f) == (owner > neighbour));
+        AssertTest (sp.arrow_index_from_ij (std::min (owner, neighbour),
+                                            std::max (owner, neighbour))
+                    == f);
+        n_owner_higher += sp.owner_is_higher (f);
+    }
+    AssertTest (n_owner_higher > 0);
+    std::cout << "Tested SparsityPattern" << std::endl;
+
+    // Cells 0 and n - 1 are not neighbours
+    bool thrown = false;
+    try
+    {
+        sp.arrow_index_from_ij (0, n_cells - 1);
+    }
+    catch (const std::out_of_range &)
+    {
+        thrown = true;
+    }
+    AssertTest (thrown);
+    std::cout << "Tested missing entry" << std::endl;
+
+    // A non-symmetric matrix assembled by face and by (i, j) is the same, and
+    // multiplies as the coefficients say
+    std::mt19937                           generator (0);
+    std::uniform_real_distribution<double> distribution (-1., 1.);
+    SparseMatrix                           by_face (sp), by_ij (sp);
+    VectorXd                               x (n_cells), expected (n_cells);
+    for (unsigned int c = 0; c < n_cells; c++)
+    {
+        x (c)              = distribution (generator);
+        const double value = distribution (generator);
+        by_face.add_diag (c, value);
+        by_ij (c, c) += value;
+        expected (c) = value * x (c);
+    }
+    for (unsigned int f = 0; f < n_internal_faces; f++)
+    {
+        const auto        &face      = mesh.get_face (f);
+        const unsigned int owner     = face->neighbour_indices ()[0];
+        const unsigned int neighbour = face->neighbour_indices ()[1];
+        const double       upper     = distribution (generator);
+        const double       lower     = distribution (generator);
+        by_face.add_face (f, upper, lower);
+        by_ij (owner, neighbour) += upper;
+        by_ij (neighbour, owner) += lower;
+        expected (owner) += upper * x (neighbour);
+        expected (neighbour) += lower * x (owner);
+    }
+    for (unsigned int c = 0; c < n_cells; c++)
+        AssertTest (by_face (c, c) == by_ij (c, c));
+    for (unsigned int f = 0; f < n_internal_faces; f++)
+    {
+        const auto        &face      = mesh.get_face (f);
+        const unsigned int owner     = face->neighbour_indices ()[0];
+        const unsigned int neighbour = face->neighbour_indices ()[1];
+        AssertTest (by_face (owner, neighbour) == by_ij (owner, neighbour));
+        AssertTest (by_face (neighbour, owner) == by_ij (neighbour, owner));
+    }
+
+    VectorXd result (n_cells);
+    by_face.vmult (x, result);
+    for (unsigned int c = 0; c < n_cells; c++)
+        AssertTest (close (result (c), expected (c)));
+    std::cout << "Tested assembly" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+#include <FVMCode/field_reader.h>
+#include <FVMCode/file_parser.h>
+#include <FVMCode/time_series.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <filesystem>
+#include <stdexcept>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+// The field written at timestep t
+Eigen::VectorXd series_field (const unsigned int n_values,
+                              const unsigned int t)
+{
+    Eigen::VectorXd field (n_values);
+    for (unsigned int i = 0; i < n_values; i++) field (i) = 0.1 * t + i;
+    return field;
+}
+
+// Checks that time_series holds the frames of the timesteps 0 to
+// n_frames - 1 of field T
+void check_series (const TimeSeriesReader &time_series,
+                   const unsigned int      n_values,
+                   const unsigned int      n_frames)
+{
+    AssertTest (time_series.field_name () == "T");
+    AssertTest (time_series.n_values () == n_values);
+    AssertTest (time_series.n_frames () == n_frames);
+    for (unsigned int f = 0; f < n_frames; f++)
+    {
+        AssertTest (time_series.timestep_number (f) == f);
+        AssertTest (time_series.time (f) == 0.25 * f);
+        AssertTest (time_series.values (f) == series_field (n_values, f));
+    }
+}
+
+int time_series_01 (int, char **)
+{
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (mesh, "mesh_1d/points", "mesh_1d/faces",
+                                   "mesh_1d/owner", "mesh_1d/neighbour",
+                                   "mesh_1d/boundary");
+    const unsigned int               n_cells = mesh.n_cells ();
+    const std::vector<BoundaryPatch> patches = mesh.get_patches ();
+
+    std::filesystem::remove_all ("time_series_01");
+    std::filesystem::create_directory ("time_series_01");
+    const std::string filename = "time_series_01/T.series";
+
+    {
+        TimeSeriesWriter writer (filename, "T", n_cells);
+        for (unsigned int t = 0; t < 5; t++)
+            writer.append (t, 0.25 * t, series_field (n_cells, t));
+        AssertTest (writer.n_frames () == 5);
+    }
+    check_series (TimeSeriesReader (filename), n_cells, 5);
+    std::cout << "Tested writing and reading" << std::endl;
+
+    {
+        // Appending, e.g. after resuming a run
+        {
+            TimeSeriesWriter writer (filename, "T", n_cells, true);
+            for (unsigned int t = 5; t < 8; t++)
+                writer.append (t, 0.25 * t, series_field (n_cells, t));
+            writer.close ();
+        }
+        check_series (TimeSeriesReader (filename), n_cells, 8);
+
+        // A file that was not closed, with a partly written last frame
+        {
+            TimeSeriesWriter writer (filename, "T", n_cells, true);
+            writer.append (8, 2., series_field (n_cells, 8));
+            writer.append (9, 2.25, series_field (n_cells, 9));
+            // Reading while the writer is still open
+            check_series (TimeSeriesReader (filename), n_cells, 10);
+            writer.close ();
+        }
+        std::filesystem::copy_file (filename, filename + ".crashed");
+        TimeSeries::Header header;
+        {
+            std::fstream file (filename + ".crashed",
+                               std::ios::in | std::ios::out
+                                   | std::ios::binary);
+            file.read (reinterpret_cast<char *> (&header), sizeof (header));
+            header.index_offset = 0;
+            file.seekp (0);
+            file.write (reinterpret_cast<const char *> (&header),
+                        sizeof (header));
+        }
+        std::filesystem::resize_file (
+            filename + ".crashed",
+            std::filesystem::file_size (filename + ".crashed")
+                - 10 * sizeof (TimeSeries::IndexEntry) - 8);
+        check_series (TimeSeriesReader (filename + ".crashed"), n_cells, 9);
+
+        bool caught = false;
+        try
+        {
+            TimeSeriesWriter writer (filename, "U", n_cells, true);
+        }
+        catch (std::runtime_error &)
+        {
+            caught = true;
+        }
+        AssertTest (caught);
+    }
+    std::cout << "Tested appending" << std::endl;
+
+    {
+        // Expanding into time directories
+        const std::filesystem::path working_directory
+            = std::filesystem::current_path ();
+        const TimeSeriesReader time_series (filename);
+        std::filesystem::current_path ("time_series_01");
+        BoundaryConditions boundary_conditions;
+        for (const BoundaryPatch &patch : patches)
+            boundary_conditions.emplace_back (
+                patch, BoundaryFieldEntry (patch.type == empty
+                                               ? "empty"
+                                               : "zeroGradient",
+                                           0));
+        write_time_directories (time_series, boundary_conditions);
+        std::filesystem::current_path (working_directory);
+
+        const std::optional<Input::TimeDirectory> latest
+            = Input::find_latest_time ("time_series_01", "T");
+        AssertTest (latest->time == 0.25 * 9);
+        AssertTest (latest->index == 9);
+        for (unsigned int f = 0; f < 10; f++)
+        {
+            Eigen::VectorXd    field;
+            BoundaryConditions read_conditions;
+            Input::read_scalar_field (
+                "time_series_01/" + Outputter::name_from_time (0.25 * f, 2)
+                    + "/T",
+                n_cells, patches, field, read_conditions);
+            AssertTest (field == series_field (n_cells, f));
+        }
+    }
+    std::cout << "Tested time directories" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
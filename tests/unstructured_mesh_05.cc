@@ -0,0 +1,77 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/unstructured_mesh.h>
+
+#include <stdexcept>
+
+#include "test_helpers.h"
+
+int unstructured_mesh_05 (int, char **)
+{
+    // Tests the walking point locator against the linear scan
+    using namespace FVMCode;
+
+    {
+        // 1D mesh of 20 blocks, each with extent (0.005 0.1, 0.01), and
+        // stacked in the x direction. Walk along the line in both directions.
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (mesh, "mesh_1d/points", "mesh_1d/faces",
+                                       "mesh_1d/owner", "mesh_1d/neighbour",
+                                       "mesh_1d/boundary");
+
+        unsigned int hint = 0;
+        for (unsigned int i = 0; i < 200; i++)
+        {
+            const Point<3>     point (0.1 * (i + 0.3) / 200, 0.04, 0.003);
+            const unsigned int cell = mesh.get_cell_containing_point (point);
+            hint = mesh.get_cell_containing_point (point, hint);
+            AssertTest (hint == cell);
+        }
+        AssertTest (hint == 19);
+
+        // Long jump back to the start
+        hint = mesh.get_cell_containing_point (Point<3> (0.001, 0.01, 0.001),
+                                               hint);
+        AssertTest (hint == 0);
+
+        // Points outside the mesh throw, with and without a hint
+        for (const bool use_hint : { false, true })
+        {
+            bool caught = false;
+            try
+            {
+                const Point<3> outside (0.2, 0.04, 0.003);
+                if (use_hint)
+                    mesh.get_cell_containing_point (outside, hint);
+                else
+                    mesh.get_cell_containing_point (outside);
+            }
+            catch (std::out_of_range &)
+            {
+                caught = true;
+            }
+            AssertTest (caught);
+        }
+    }
+
+    {
+        // 2D mesh of 4 blocks, 2x2x1 and overall 1m x 1m x 1m
+        UnstructuredMesh       mesh;
+        UnstructuredMeshParser parser (
+            mesh, "unstructured_mesh_04/points", "unstructured_mesh_04/faces",
+            "unstructured_mesh_04/owner", "unstructured_mesh_04/neighbour",
+            "unstructured_mesh_04/boundary");
+
+        for (unsigned int hint = 0; hint < mesh.n_cells (); hint++)
+            for (unsigned int i = 0; i < 10; i++)
+                for (unsigned int j = 0; j < 10; j++)
+                {
+                    const Point<3> point (0.1 * i + 0.03, 0.1 * j + 0.07, 0.3);
+                    AssertTest (mesh.get_cell_containing_point (point, hint)
+                                == mesh.get_cell_containing_point (point));
+                }
+    }
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}
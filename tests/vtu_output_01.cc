@@ -0,0 +1,228 @@
+#include <FVMCode/file_parser.h>
+#include <FVMCode/unstructured_mesh.h>
+#include <FVMCode/vtu_output.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "test_helpers.h"
+
+using namespace FVMCode;
+
+namespace
+{
+std::string read_file (const std::string &file_name)
+{
+    std::ifstream     file (file_name, std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf ();
+    return contents.str ();
+}
+
+// Reads the appended array called name from the contents of a .vtu file
+template <typename T>
+std::vector<T> read_array (const std::string &vtu, const std::string &name)
+{
+    const std::size_t attribute = vtu.find ("Name=\"" + name + "\"");
+    AssertTest (attribute != std::string::npos);
+    const std::size_t offset_start = vtu.find ("offset=\"", attribute) + 8;
+    const std::size_t offset       = std::stoul (vtu.substr (
+        offset_start, vtu.find ('"', offset_start) - offset_start));
+    const std::size_t data
+        = vtu.find ("<AppendedData encoding=\"raw\">\n_") + 31 + offset;
+
+    std::uint64_t bytes;
+    std::memcpy (&bytes, vtu.data () + data, sizeof (bytes));
+    AssertTest (bytes % sizeof (T) == 0);
+    std::vector<T> array (bytes / sizeof (T));
+    std::memcpy (array.data (), vtu.data () + data + sizeof (bytes), bytes);
+    return array;
+}
+// Reads the array of labels called name, stored as 32 or 64 bit integers
+std::vector<std::int64_t> read_labels (const std::string &vtu,
+                                       const std::string &name)
+{
+    const std::size_t attribute = vtu.find ("Name=\"" + name + "\"");
+    const std::size_t element   = vtu.rfind ("<DataArray", attribute);
+    if (vtu.substr (element, attribute - element).find ("Int32")
+        != std::string::npos)
+    {
+        const std::vector<std::int32_t> labels
+            = read_array<std::int32_t> (vtu, name);
+        return std::vector<std::int64_t> (labels.begin (), labels.end ());
+    }
+    return read_array<std::int64_t> (vtu, name);
+}
+
+// Checks that the cells of the .vtu file have the volumes of the cells of
+// mesh, which requires their faces to enclose them with outward normals.
+// By the divergence theorem, the volume is the sum over the faces of the
+// centroid dotted with the area vector, over three.
+void check_cells (UnstructuredMesh &mesh, const std::string &vtu)
+{
+    const std::vector<double> points = read_array<double> (vtu, "Points");
+    AssertTest (points.size () == 3 * mesh.n_points ());
+    auto point = [&] (const std::int64_t p) {
+        return Point<3> (points[3 * p], points[3 * p + 1], points[3 * p + 2]);
+    };
+
+    const std::vector<std::int64_t> connectivity
+        = read_labels (vtu, "connectivity");
+    const std::vector<std::int64_t> offsets = read_labels (vtu, "offsets");
+    const std::vector<std::uint8_t> types
+        = read_array<std::uint8_t> (vtu, "types");
+    std::vector<std::int64_t> faces, face_offsets;
+    if (vtu.find ("Name=\"faces\"") != std::string::npos)
+    {
+        faces        = read_labels (vtu, "faces");
+        face_offsets = read_labels (vtu, "faceoffsets");
+    }
+    AssertTest (types.size () == mesh.n_cells ());
+
+    // Faces of a VTK hexahedron, with outward normals
+    const unsigned int hexahedron_faces[6][4]
+        = { { 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 },
+            { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 } };
+    std::size_t position = 0;
+    for (unsigned int c = 0; c < mesh.n_cells (); c++)
+    {
+        std::vector<std::vector<std::int64_t> > cell_faces;
+        if (types[c] == 12)
+        {
+            const std::int64_t first = c > 0 ? offsets[c - 1] : 0;
+            AssertTest (offsets[c] == first + 8);
+            for (const auto &face : hexahedron_faces)
+            {
+                cell_faces.emplace_back ();
+                for (const unsigned int v : face)
+                    cell_faces.back ().push_back (connectivity[first + v]);
+            }
+        }
+        else
+        {
+            AssertTest (types[c] == 42);
+            const std::int64_t n_faces = faces[position++];
+            for (std::int64_t f = 0; f < n_faces; f++)
+            {
+                const std::int64_t n_vertices = faces[position++];
+                cell_faces.emplace_back (faces.begin () + position,
+                                         faces.begin () + position
+                                             + n_vertices);
+                position += n_vertices;
+            }
+            AssertTest (position
+                        == static_cast<std::size_t> (face_offsets[c]));
+        }
+        AssertTest (cell_faces.size () == mesh.get_cell (c)->faces ().size ());
+
+        double volume = 0;
+        for (const auto &face : cell_faces)
+        {
+            const unsigned int n_vertices = face.size ();
+            Point<3>           centre (0, 0, 0), area_vector (0, 0, 0);
+            for (const std::int64_t v : face)
+                centre += point (v);
+            centre /= static_cast<double> (n_vertices);
+            for (unsigned int v = 0; v < n_vertices; v++)
+                area_vector += 0.5
+                               * cross_p (point (face[v]) - centre,
+                                          point (face[(v + 1) % n_vertices])
+                                              - centre);
+            volume += centre.dot (area_vector) / 3.;
+        }
+        AssertTest (close (volume, mesh.get_cell (c)->volume ()));
+    }
+}
+} // namespace
+
+int vtu_output_01 (int, char **)
+{
+    UnstructuredMesh       mesh;
+    UnstructuredMeshParser parser (mesh, "mesh_1d/points", "mesh_1d/faces",
+                                   "mesh_1d/owner", "mesh_1d/neighbour",
+                                   "mesh_1d/boundary");
+    const unsigned int n_cells = mesh.n_cells ();
+
+    Eigen::VectorXd temperature (n_cells), pressure (n_cells);
+    for (unsigned int c = 0; c < n_cells; c++)
+    {
+        temperature (c) = 0.1 * c + 1. / 3.;
+        pressure (c)    = -1e5 * c;
+    }
+
+    std::filesystem::remove_all ("vtu_output_01_output");
+    {
+        VTUWriter writer (mesh, "vtu_output_01_output", "case");
+        writer.write_scalar_fields (0., { { "T", &temperature },
+                                          { "p", &pressure } });
+        writer.write_scalar_field (0.1, temperature, "T");
+        AssertTest (writer.n_outputs () == 2);
+    }
+
+    // The fields and the geometry read back exactly
+    {
+        const std::string vtu = read_file ("vtu_output_01_output/case_0.vtu");
+        AssertTest (vtu.find ("NumberOfCells=\"20\"") != std::string::npos);
+        AssertTest (read_array<double> (vtu, "T")
+                    == std::vector<double> (temperature.begin (),
+                                            temperature.end ()));
+        AssertTest (read_array<double> (vtu, "p")
+                    == std::vector<double> (pressure.begin (),
+                                            pressure.end ()));
+
+        const std::vector<double> points = read_array<double> (vtu, "Points");
+        for (unsigned int p = 0; p < mesh.n_points (); p++)
+            for (unsigned int d = 0; d < 3; d++)
+                AssertTest (points[3 * p + d] == (*mesh.get_point (p)) (d));
+        // The mesh is all hexahedra
+        AssertTest (read_array<std::uint8_t> (vtu, "types")
+                    == std::vector<std::uint8_t> (n_cells, 12));
+        check_cells (mesh, vtu);
+    }
+    // Two prisms, written as polyhedra, sharing a face
+    {
+        UnstructuredMesh       prisms;
+        UnstructuredMeshParser prisms_parser (
+            prisms, "vtu_output_01/points", "vtu_output_01/faces",
+            "vtu_output_01/owner", "vtu_output_01/neighbour",
+            "vtu_output_01/boundary");
+        const Eigen::VectorXd field = Eigen::VectorXd::Ones (2);
+        VTUWriter writer (prisms, "vtu_output_01_output", "prisms");
+        writer.write_scalar_field (0., field, "T");
+        const std::string vtu
+            = read_file ("vtu_output_01_output/prisms_0.vtu");
+        AssertTest (read_array<std::uint8_t> (vtu, "types")
+                    == std::vector<std::uint8_t> (2, 42));
+        check_cells (prisms, vtu);
+    }
+    std::cout << "Tested files" << std::endl;
+
+    // Appending keeps the earlier outputs and replaces those at or after
+    // the first new time
+    {
+        VTUWriter writer (mesh, "vtu_output_01_output", "case", true);
+        AssertTest (writer.n_outputs () == 2);
+        writer.write_scalar_field (0.1, pressure, "T");
+        writer.write_scalar_field (0.2, pressure, "T");
+        AssertTest (writer.n_outputs () == 3);
+    }
+    const std::string pvd = read_file ("vtu_output_01_output/case.pvd");
+    AssertTest (pvd.find ("timestep=\"0\" file=\"case_0.vtu\"")
+                != std::string::npos);
+    AssertTest (pvd.find ("timestep=\"0.1\" file=\"case_1.vtu\"")
+                != std::string::npos);
+    AssertTest (pvd.find ("timestep=\"0.2\" file=\"case_2.vtu\"")
+                != std::string::npos);
+    const std::string replaced
+        = read_file ("vtu_output_01_output/case_1.vtu");
+    AssertTest (read_array<double> (replaced, "T")
+                == std::vector<double> (pressure.begin (), pressure.end ()));
+    std::cout << "Tested appending" << std::endl;
+
+    MAIN_OUTPUT;
+
+    return EXIT_SUCCESS;
+}